@@ -0,0 +1,12 @@
+#pragma once
+
+#include <chrono>
+
+// Returns the time taken by a call to f, in seconds
+template <typename F>
+double MeasureSeconds(F f)
+{
+	auto t0 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -0,0 +1,45 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "AudioRing.h"
+
+TEST_SUITE("Audio ring");
+
+TEST_CASE("Audio ring throughput") {
+	const unsigned int TOTAL = 1 << 26;
+	const unsigned int BLOCK = 1000;
+	CAudioRing Ring;
+	REQUIRE(Ring.Allocate(4096));
+
+	unsigned int Starved = 0;
+	double Seconds = MeasureSeconds([&] {
+		std::thread Consumer {[&] {
+			std::vector<char> Buf(BLOCK);
+			unsigned int Pos = 0;
+			while (Pos < TOTAL) {
+				unsigned int Read = Ring.Read(Buf.data(), std::min(BLOCK, TOTAL - Pos));
+				if (!Read) {
+					++Starved;
+					std::this_thread::yield();
+				}
+				Pos += Read;
+			}
+		}};
+
+		std::vector<char> Buf(BLOCK);
+		unsigned int Pos = 0;
+		while (Pos < TOTAL) {
+			unsigned int Count = Ring.Write(Buf.data(), std::min(BLOCK, TOTAL - Pos));
+			if (!Count)
+				std::this_thread::yield();
+			Pos += Count;
+		}
+		Consumer.join();
+	});
+
+	std::printf("Audio ring: %u bytes in %.3f ms, %u empty reads\n", TOTAL, Seconds * 1e3, Starved);
+}
@@ -0,0 +1,13 @@
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+
+// Benchmarks print their timings, run them from a release build
+
+int main(int argc, char **argv)
+{
+	doctest::Context context;
+	context.applyCommandLine(argc, argv);
+	context.setOption("sort", "name");
+
+	return context.run();
+}
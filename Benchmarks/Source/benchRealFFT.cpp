@@ -0,0 +1,25 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "FFT/RealFFT.h"
+
+TEST_SUITE("Real FFT");
+
+TEST_CASE("Real FFT") {
+	const unsigned int N = 256;
+	const int COUNT = 100000;
+	CRealFFT<N> FFT;
+
+	std::vector<short> In(N);
+	for (unsigned int i = 0; i < N; ++i)
+		In[i] = (short)(8000 * sin(2 * 3.14159265358979323846 * 20.5 * i / N));
+
+	double Seconds = MeasureSeconds([&] {
+		for (int i = 0; i < COUNT; ++i)
+			FFT.Transform(In.data());
+	});
+	std::printf("Real FFT: %d transforms of %u points in %.3f ms\n", COUNT, N, Seconds * 1e3);
+}
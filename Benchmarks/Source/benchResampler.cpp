@@ -0,0 +1,44 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "ResamplerReference.h"
+
+TEST_SUITE("Resampler");
+
+namespace {
+
+template <typename T>
+double ResampleSeconds(T &Resampler, size_t Count)
+{
+	std::vector<float> Output(Count);
+	return MeasureSeconds([&] {
+		for (auto &x : Output)
+			x = Resampler.Get();
+	});
+}
+
+} // namespace
+
+TEST_CASE("FIR kernel") {
+	const jarh::sinc Sinc {4096, 256};
+	const float RATIO = 44100.f / 192000.f;
+	const float CUTOFF = .9f;
+	const size_t INPUT = 192000 * 2;
+	const size_t OUTPUT = (size_t)(INPUT * RATIO);
+
+	std::mt19937 rng {1};
+	std::uniform_real_distribution<float> Dist {-10000.f, 10000.f};
+	std::vector<float> Input(INPUT);
+	for (auto &x : Input)
+		x = Dist(rng);
+
+	CReferenceResampler Reference {Sinc, RATIO, CUTOFF, Input};
+	CVectorResampler Polyphase {Sinc, RATIO, CUTOFF, Input};
+	double RefTime = ResampleSeconds(Reference, OUTPUT);
+	double PolyTime = ResampleSeconds(Polyphase, OUTPUT);
+	std::printf("FIR kernel: reference %.2f Msamples/s, polyphase %.2f Msamples/s (%.1fx)\n",
+		OUTPUT / RefTime / 1e6, OUTPUT / PolyTime / 1e6, RefTime / PolyTime);
+}
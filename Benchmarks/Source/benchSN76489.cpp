@@ -0,0 +1,23 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include "Benchmark.h"
+#include "SN76489Reference.h"
+
+TEST_SUITE("SN76489");
+
+TEST_CASE("Square wave synthesis") {
+	const int FRAMES = 3000;
+	double Reference = MeasureSeconds([&] { RenderSquares<CReferenceSquare>(FRAMES); });
+	double Batched = MeasureSeconds([&] { RenderSquares<CSNSquare>(FRAMES); });
+	std::printf("Square synthesis: %d frames, per half period %.3f ms, batched %.3f ms (%.2fx)\n",
+		FRAMES, Reference * 1e3, Batched * 1e3, Reference / Batched);
+}
+
+TEST_CASE("Noise synthesis") {
+	const int FRAMES = 3000;
+	double Reference = MeasureSeconds([&] { RenderNoise<CReferenceNoise>(FRAMES); });
+	double Batched = MeasureSeconds([&] { RenderNoise<CSNNoise>(FRAMES); });
+	std::printf("Noise synthesis: %d frames, per step %.3f ms, batched %.3f ms (%.2fx)\n",
+		FRAMES, Reference * 1e3, Batched * 1e3, Reference / Batched);
+}
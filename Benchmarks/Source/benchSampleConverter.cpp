@@ -0,0 +1,35 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "APU/SampleConverter.h"
+
+TEST_SUITE("Sample converter");
+
+TEST_CASE("Sample conversion") {
+	const uint32 COUNT = 1 << 20;
+	const int RUNS = 20;
+
+	std::mt19937 rng {1};
+	std::uniform_real_distribution<float> Dist {-1.f, 1.f};
+	std::vector<float> In(COUNT);
+	for (auto &x : In)
+		x = Dist(rng);
+	std::vector<int16> Out(COUNT);
+	CSampleConverter Converter;
+
+	for (int Dither = 0; Dither < 2; ++Dither) {
+		double Scalar = MeasureSeconds([&] {
+			for (int i = 0; i < RUNS; ++i)
+				Converter.ToInt16Scalar(In.data(), Out.data(), COUNT, Dither != 0);
+		});
+		double SSE2 = MeasureSeconds([&] {
+			for (int i = 0; i < RUNS; ++i)
+				Converter.ToInt16SSE2(In.data(), Out.data(), COUNT, Dither != 0);
+		});
+		std::printf("Sample conversion%s: scalar %.3f ns/sample, SSE2 %.3f ns/sample\n", Dither ? " with dither" : "",
+			Scalar * 1e9 / (COUNT * RUNS), SSE2 * 1e9 / (COUNT * RUNS));
+	}
+}
@@ -0,0 +1,26 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "ScopeRenderer.h"
+
+TEST_SUITE("Scope renderer");
+
+TEST_CASE("Scope renderer") {
+	const int W = 150, H = 40;
+	const int FRAMES = 20000;
+	CScopeRenderer Scope;
+	Scope.Create(W, H);
+
+	std::vector<short> Samples(W);
+	double Seconds = MeasureSeconds([&] {
+		for (int i = 0; i < FRAMES; ++i) {
+			for (int x = 0; x < W; ++x)
+				Samples[x] = (short)(20000 * sin((x + i) * 0.1));
+			Scope.Render(Samples.data(), true);
+		}
+	});
+	std::printf("Scope renderer: %d frames of %d x %d in %.3f ms\n", FRAMES, W, H, Seconds * 1e3);
+}
@@ -0,0 +1,45 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "APU/StereoReader.h"
+
+TEST_SUITE("Stereo reader");
+
+namespace {
+
+typedef void (*read_func_t)(const int32 *, const int32 *, int32 &, int32 &, int, const stereo_matrix_t &, float *, uint32);
+
+} // namespace
+
+TEST_CASE("Fused stereo read-out") {
+	const uint32 COUNT = 4096;
+	const int RUNS = 2000;
+
+	std::mt19937 rng {1};
+	std::uniform_int_distribution<int32> Delta {-(1 << 19), 1 << 19};
+	std::vector<int32> Mid(COUNT), Side(COUNT);
+	for (auto &x : Mid)
+		x = Delta(rng);
+	for (auto &x : Side)
+		x = Delta(rng);
+	std::vector<float> Samples(COUNT * 2);
+	const stereo_matrix_t Matrix {.8f, .2f, .2f, .8f};
+
+	auto Measure = [&] (const char *Name, read_func_t Func) {
+		int32 AccumMid = 0, AccumSide = 0;
+		double Seconds = MeasureSeconds([&] {
+			for (int i = 0; i < RUNS; ++i)
+				Func(Mid.data(), Side.data(), AccumMid, AccumSide, 9, Matrix, Samples.data(), COUNT);
+		});
+		std::printf("Stereo read-out (%s): %.3f ns/sample\n", Name, Seconds * 1e9 / (RUNS * COUNT));
+	};
+
+	Measure("scalar", CStereoReader::ReadScalar);
+	if (CStereoReader::HasSSE2())
+		Measure("SSE2", CStereoReader::ReadSSE2);
+	if (CStereoReader::HasAVX2())
+		Measure("AVX2", CStereoReader::ReadAVX2);
+}
@@ -0,0 +1,37 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include "Benchmark.h"
+#include "VGM/Logger.h"
+#include "VGM/Writer/SN76489.h"
+
+TEST_SUITE("VGM logger");
+
+namespace {
+
+void LogWrites(const char *fname, bool Streaming, int Writes)
+{
+	CVGMLogger logger {fname, Streaming};
+	CVGMWriterSN76489 writer {logger};
+
+	double Seconds = MeasureSeconds([&] {
+		for (int i = 0; i < Writes; ++i) {
+			writer.WriteReg(0, 0x90 | (i & 0x6F));
+			if (!(i & 0x3F))
+				logger.DelayTicks(1);
+		}
+	});
+
+	std::printf("VGM writes (%s): %d in %.3f ms, %.2f ns/write\n",
+		Streaming ? "streaming" : "buffered", Writes, Seconds * 1e3, Seconds * 1e9 / Writes);
+}
+
+} // namespace
+
+TEST_CASE("VGM command encoding") {
+	const char *fname = "benchVGMLogger.vgm";
+	const int WRITES = 1000000;
+	LogWrites(fname, false, WRITES);
+	LogWrites(fname, true, WRITES);
+	std::remove(fname);
+}
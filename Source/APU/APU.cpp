@@ -1,321 +1,459 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include <algorithm>		// // //
-#include <vector>
-#include "../stdafx.h"
-#include <cstdio>
-#include <memory>
-#include <cmath>
-#include "APU.h"
-#include "SN76489_new.h"		// // //
-#include "../VGM/Writer/Base.h"		// // //
-
-const uint32 CAPU::BASE_FREQ_NTSC		= 3579540;		// // //
-const uint32 CAPU::BASE_FREQ_PAL		= 3546893;
-const uint8	 CAPU::FRAME_RATE_NTSC		= 60;
-const uint8	 CAPU::FRAME_RATE_PAL		= 50;
-
-// // //
-
-CAPU::CAPU(IAudioCallback *pCallback) :		// // //
-	m_pParent(pCallback),
-	m_iFrameCycles(0),
-	m_pSoundBuffer(NULL),
-	m_pMixer(new CMixer()),
-	m_iExternalSoundChip(0),
-	m_iCyclesToRun(0)
-{
-	m_pSN76489 = new CSN76489(m_pMixer);		// // //
-
-#ifdef LOGGING
-	m_pLog = new CFile("apu_log.txt", CFile::modeCreate | CFile::modeWrite);
-	m_iFrame = 0;
-#endif
-}
-
-CAPU::~CAPU()
-{
-	SAFE_RELEASE(m_pSN76489);		// // //
-
-	SAFE_RELEASE(m_pMixer);
-
-	SAFE_RELEASE(m_pSoundBuffer);
-
-#ifdef LOGGING
-	m_pLog->Close();
-	delete m_pLog;
-#endif
-}
-
-// // //
-
-inline void CAPU::RunSN(uint32 Time)		// // //
-{
-	m_pSN76489->Process(Time);
-}
-
-// The main APU emulation
-//
-// The amount of cycles that will be emulated is added by CAPU::AddCycles
-//
-void CAPU::Process()
-{	
-	while (m_iCyclesToRun > 0) {
-		uint32 Time = std::min(m_iCyclesToRun, m_iFrameClock);		// // //
-		
-		// Run internal channels
-		RunSN(Time);		// // //
-
-		m_iFrameCycles	  += Time;
-		m_iFrameClock	  -= Time;
-		m_iCyclesToRun	  -= Time;
-
-		// // //
-
-		if (m_iFrameClock == 0)
-			EndFrame();
-	}
-}
-
-// End of audio frame, flush the buffer if enough samples has been produced, and start a new frame
-void CAPU::EndFrame()
-{
-	// The APU will always output audio in 32 bit signed format
-	
-	m_pSN76489->EndFrame();		// // //
-
-	int SamplesAvail = m_pMixer->FinishBuffer(m_iFrameCycles);
-	int ReadSamples	= m_pMixer->ReadBuffer(SamplesAvail, m_pSoundBuffer, m_bStereoEnabled);
-	m_pParent->FlushBuffer(m_pSoundBuffer, ReadSamples);
-	
-	m_iFrameClock /*+*/= m_iFrameCycleCount;
-	m_iFrameCycles = 0;
-
-#ifdef LOGGING
-	++m_iFrame;
-#endif
-}
-
-void CAPU::Reset()
-{
-	// Reset APU
-	//
-	
-	m_iCyclesToRun		= 0;
-	m_iFrameCycles		= 0;
-	m_iFrameSequence	= 0;
-	m_iFrameClock		= m_iFrameCycleCount;
-	
-	m_pMixer->ClearBuffer();
-
-	m_pSN76489->Reset();		// // //
-
-#ifdef LOGGING
-	m_iFrame = 0;
-#endif
-}
-
-void CAPU::SetupMixer(int LowCut, int HighCut, int HighDamp, int Volume) const
-{
-	// New settings
-	m_pMixer->UpdateSettings(LowCut, HighCut, HighDamp, float(Volume) / 100.0f);
-	// // //
-}
-
-void CAPU::SetExternalSound(uint8 Chip)
-{
-	// Set expansion chip
-	m_iExternalSoundChip = Chip;
-	m_pMixer->ExternalSound(Chip);
-
-	// // //
-
-	Reset();
-}
-
-void CAPU::ChangeMachine(int Machine)
-{
-	// Allow to change speed on the fly
-	//
-	// // //
-	/*
-	switch (Machine) {
-		case MACHINE_NTSC:
-			m_pNoise->PERIOD_TABLE = CNoise::NOISE_PERIODS_NTSC;
-			// // //
-			m_pMixer->SetClockRate(BASE_FREQ_NTSC);
-			break;
-		case MACHINE_PAL:
-			m_pNoise->PERIOD_TABLE = CNoise::NOISE_PERIODS_PAL;
-			// // //
-			m_pMixer->SetClockRate(BASE_FREQ_PAL);
-			break;
-	}
-	*/
-}
-
-bool CAPU::SetupSound(int SampleRate, int NrChannels, int Machine)
-{
-	// Allocate a sound buffer
-	//
-	// Returns false if a buffer couldn't be allocated
-	//
-	
-	uint32 BaseFreq = (Machine == MACHINE_NTSC) ? BASE_FREQ_NTSC : BASE_FREQ_PAL;
-	uint8 FrameRate = (Machine == MACHINE_NTSC) ? FRAME_RATE_NTSC : FRAME_RATE_PAL;
-
-	m_iSoundBufferSamples = uint32(SampleRate / FRAME_RATE_PAL);	// Samples / frame. Allocate for PAL, since it's more
-	m_bStereoEnabled	  = (NrChannels == 2);	
-	m_iSoundBufferSize	  = m_iSoundBufferSamples * NrChannels;		// Total amount of samples to allocate
-	m_iSampleSizeShift	  = (NrChannels == 2) ? 1 : 0;
-	m_iBufferPointer	  = 0;
-
-	if (!m_pMixer->AllocateBuffer(m_iSoundBufferSamples, SampleRate, NrChannels))
-		return false;
-
-	m_pMixer->SetClockRate(BaseFreq);
-
-	SAFE_RELEASE_ARRAY(m_pSoundBuffer);
-
-	m_pSoundBuffer = new int16[m_iSoundBufferSize << 1];
-
-	if (m_pSoundBuffer == NULL)
-		return false;
-
-	ChangeMachine(Machine);
-
-	// // //
-
-	// Numbers of cycles/audio frame
-	m_iFrameCycleCount = BaseFreq / FrameRate;
-
-	return true;
-}
-
-void CAPU::AddTime(int32 Cycles)
-{
-	if (Cycles < 0)
-		return;
-	m_iCyclesToRun += Cycles;
-}
-
-void CAPU::Write(uint16 Address, uint8 Value)
-{
-	// Data was written to an APU register
-	//
-
-	Process();
-
-	if (Address == CSN76489::STEREO_PORT || Address <= 0x10 || Address == (uint16)-1) {		// // //
-		m_pSN76489->Write(Address, Value);
-	}
-
-	// // //m_iRegs[Address & 0x1F] = Value;
-
-#ifdef LOGGING
-	m_iRegs[Address & 0x1F] = Value;
-#endif
-}
-
-// // //
-
-void CAPU::ExternalWrite(uint16 Address, uint8 Value)
-{
-	// Data was written to an external sound chip 
-	// (this doesn't really belong in the APU but are here for convenience)
-	//
-
-	Process();
-
-	// // //
-}
-
-uint8 CAPU::ExternalRead(uint16 Address)
-{
-	// Data read from an external chip
-	//
-
-	uint8 Value(0);
-	bool Mapped(false);
-
-	Process();
-
-	// // //
-
-	if (!Mapped)
-		Value = Address >> 8;	// open bus
-
-	return Value;
-}
-
-// Expansion for famitracker
-
-int32 CAPU::GetVol(uint8 Chan) const	
-{
-	return m_pMixer->GetChanOutput(Chan);
-}
-
-// // //
-
-#ifdef LOGGING
-void CAPU::Log()
-{
-	CString str;
-	str.Format("Frame %08i: ", m_iFrame);
-	for (int i = 0; i < 0x14; ++i)
-		str.AppendFormat("%02X ", m_iRegs[i]);
-	str.Append("\n");
-	m_pLog->Write(str, str.GetLength());
-}
-#endif
-
-void CAPU::SetChipLevel(chip_level_t Chip, float Level) const
-{
-	float fLevel = powf(10, Level / 20.0f);		// Convert dB to linear
-
-	// // //
-	m_pMixer->SetChipLevel(Chip, fLevel);
-}
-
-void CAPU::SetStereoSeparation(float Sep) const		// // //
-{
-	m_pMixer->SetChipLevel(CHIP_LEVEL_SN7Sep, Sep);
-}
-
-void CAPU::SetVGMWriter(VGMChip Chip, const CVGMWriterBase *pWrite)		// // //
-{
-	switch (Chip) {
-	case VGMChip::SN76489:
-		m_pSN76489->SetVGMWriter(pWrite);
-		break;
-	}
-}
-
-uint8 CAPU::GetReg(int Chip, int Reg) const 
-{
-	switch (Chip) {
-		case SNDCHIP_NONE:
-			return m_iRegs[Reg & 0x1F]; 
-		// // //
-	}
-
-	return 0;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include <algorithm>		// // //
+#include <vector>
+#include <cstdio>
+#include <memory>
+#include <cmath>
+#include "APU.h"
+#include "SN76489_new.h"		// // //
+#include "OutputResampler.h"		// // //
+#include "../VGM/Writer/Base.h"		// // //
+
+const uint32 CAPU::BASE_FREQ_NTSC		= 3579540;		// // //
+const uint32 CAPU::BASE_FREQ_PAL		= 3546893;
+const uint8	 CAPU::FRAME_RATE_NTSC		= 60;
+const uint8	 CAPU::FRAME_RATE_PAL		= 50;
+
+// // //
+
+CAPU::CAPU(IAudioCallback *pCallback) :		// // //
+	m_pParent(pCallback),
+	m_iFrameCycles(0),
+	m_pSoundBuffer(NULL),
+	m_pResampler(NULL),		// // //
+	m_iResampleBufferSize(0),
+	m_pResampleBuffer(NULL),
+	m_iOutputSampleRate(0),		// // //
+	m_pMixer(new CMixer()),
+	m_iExternalSoundChip(0),
+	m_iCyclesToRun(0)
+{
+	m_pSN76489.push_back(new CSN76489(m_pMixer, 0));		// // //
+	m_WriteQueue.reserve(64);		// // // a frame of writes from every channel
+
+#ifdef LOGGING
+	m_pLog = new CFile("apu_log.txt", CFile::modeCreate | CFile::modeWrite);
+	m_iFrame = 0;
+#endif
+}
+
+CAPU::~CAPU()
+{
+	for (auto &x : m_pSN76489)		// // //
+		SAFE_RELEASE(x);
+
+	SAFE_RELEASE(m_pMixer);
+
+	SAFE_RELEASE(m_pSoundBuffer);
+	SAFE_RELEASE(m_pResampler);		// // //
+	for (auto &x : m_pStemResamplers)
+		SAFE_RELEASE(x);
+	SAFE_RELEASE_ARRAY(m_pResampleBuffer);
+
+#ifdef LOGGING
+	m_pLog->Close();
+	delete m_pLog;
+#endif
+}
+
+// // //
+
+inline void CAPU::RunSN(uint32 Time)		// // //
+{
+	for (auto x : m_pSN76489)
+		x->Process(Time);
+}
+
+// The main APU emulation
+//
+// The amount of cycles that will be emulated is added by CAPU::AddCycles
+// // // Queued register writes are applied at their timestamps in between
+//
+void CAPU::Process()
+{	
+	uint32 Elapsed = 0;
+	for (const auto &x : m_WriteQueue) {		// // //
+		Run(x.Time - Elapsed);
+		Elapsed = x.Time;
+		m_pSN76489[x.Chip]->Write(x.Address, x.Value);
+	}
+	m_WriteQueue.clear();
+
+	Run(m_iCyclesToRun - Elapsed);
+	m_iCyclesToRun = 0;
+}
+
+void CAPU::Run(uint32 Cycles)		// // //
+{
+	while (Cycles > 0) {
+		uint32 Time = std::min(Cycles, m_iFrameClock);		// // //
+		
+		// Run internal channels
+		RunSN(Time);		// // //
+
+		m_iFrameCycles	  += Time;
+		m_iFrameClock	  -= Time;
+		Cycles			  -= Time;
+
+		// // //
+
+		if (m_iFrameClock == 0)
+			EndFrame();
+	}
+}
+
+// End of audio frame, flush the buffer if enough samples has been produced, and start a new frame
+void CAPU::EndFrame()
+{
+	// // // The APU will always output audio in 32 bit floating point format
+	
+	for (auto x : m_pSN76489)		// // //
+		x->EndFrame();
+
+	int SamplesAvail = m_pMixer->FinishBuffer(m_iFrameCycles);
+	int ReadSamples	= m_pMixer->ReadBuffer(SamplesAvail, m_pSoundBuffer, m_bStereoEnabled);
+	if (m_pResampler != NULL)		// // //
+		m_pParent->FlushBuffer(m_pResampleBuffer,
+			m_pResampler->Process(m_pSoundBuffer, ReadSamples, m_pResampleBuffer, m_iResampleBufferSize));
+	else
+		m_pParent->FlushBuffer(m_pSoundBuffer, ReadSamples);
+
+	// // // Stems reuse the transfer buffers once the master mix is flushed
+	for (int i = 0, n = m_pMixer->GetStemCount(); i < n; ++i) {
+		int StemSamples = m_pMixer->ReadStem(i, SamplesAvail, m_pSoundBuffer, m_bStereoEnabled);
+		if (m_pResampler != NULL)
+			m_pParent->FlushStem(i, m_pResampleBuffer,
+				m_pStemResamplers[i]->Process(m_pSoundBuffer, StemSamples, m_pResampleBuffer, m_iResampleBufferSize));
+		else
+			m_pParent->FlushStem(i, m_pSoundBuffer, StemSamples);
+	}
+	
+	m_iFrameClock /*+*/= m_iFrameCycleCount;
+	m_iFrameCycles = 0;
+
+#ifdef LOGGING
+	++m_iFrame;
+#endif
+}
+
+void CAPU::Reset()
+{
+	// Reset APU
+	//
+	
+	m_iCyclesToRun		= 0;
+	m_WriteQueue.clear();		// // //
+	m_iFrameCycles		= 0;
+	m_iFrameSequence	= 0;
+	m_iFrameClock		= m_iFrameCycleCount;
+	
+	m_pMixer->ClearBuffer();
+
+	for (auto x : m_pSN76489)		// // //
+		x->Reset();
+
+#ifdef LOGGING
+	m_iFrame = 0;
+#endif
+}
+
+void CAPU::SetupMixer(int LowCut, int HighCut, int HighDamp, int Volume) const
+{
+	// New settings
+	m_pMixer->UpdateSettings(LowCut, HighCut, HighDamp, float(Volume) / 100.0f);
+	// // //
+}
+
+void CAPU::SetExternalSound(uint8 Chip)
+{
+	// Set expansion chip
+	m_iExternalSoundChip = Chip;
+	m_pMixer->ExternalSound(Chip);
+
+	SetChipCount((Chip & SNDCHIP_SN76489_2) ? 2 : 1);		// // //
+
+	Reset();
+}
+
+void CAPU::ChangeMachine(int Machine)
+{
+	// Allow to change speed on the fly
+	//
+	// // //
+	/*
+	switch (Machine) {
+		case MACHINE_NTSC:
+			m_pNoise->PERIOD_TABLE = CNoise::NOISE_PERIODS_NTSC;
+			// // //
+			m_pMixer->SetClockRate(BASE_FREQ_NTSC);
+			break;
+		case MACHINE_PAL:
+			m_pNoise->PERIOD_TABLE = CNoise::NOISE_PERIODS_PAL;
+			// // //
+			m_pMixer->SetClockRate(BASE_FREQ_PAL);
+			break;
+	}
+	*/
+}
+
+bool CAPU::SetupSound(int SampleRate, int NrChannels, int Machine, bool HighQuality)
+{
+	// Allocate a sound buffer
+	//
+	// Returns false if a buffer couldn't be allocated
+	//
+	// // // In high quality mode, audio is synthesized at a fixed internal rate
+	// and resampled to SampleRate at the end of each frame
+	//
+
+	SAFE_RELEASE(m_pResampler);
+	SAFE_RELEASE_ARRAY(m_pResampleBuffer);
+	m_iResampleBufferSize = 0;
+	m_iOutputSampleRate = SampleRate;		// // //
+
+	if (HighQuality) {
+		m_pResampler = new COutputResampler();
+		m_pResampler->Init(SampleRate, NrChannels);
+		m_iResampleBufferSize = uint32(SampleRate / FRAME_RATE_PAL + 2) * NrChannels * 2;
+		m_pResampleBuffer = new float[m_iResampleBufferSize];
+		SampleRate = COutputResampler::INTERNAL_SAMPLE_RATE;
+	}
+	
+	uint32 BaseFreq = (Machine == MACHINE_NTSC) ? BASE_FREQ_NTSC : BASE_FREQ_PAL;
+	uint8 FrameRate = (Machine == MACHINE_NTSC) ? FRAME_RATE_NTSC : FRAME_RATE_PAL;
+
+	m_iSoundBufferSamples = uint32(SampleRate / FRAME_RATE_PAL);	// Samples / frame. Allocate for PAL, since it's more
+	m_bStereoEnabled	  = (NrChannels == 2);	
+	SetupStemResamplers();		// // //
+	m_iSoundBufferSize	  = m_iSoundBufferSamples * NrChannels;		// Total amount of samples to allocate
+	m_iSampleSizeShift	  = (NrChannels == 2) ? 1 : 0;
+	m_iBufferPointer	  = 0;
+
+	if (!m_pMixer->AllocateBuffer(m_iSoundBufferSamples, SampleRate, NrChannels))
+		return false;
+
+	m_pMixer->SetClockRate(BaseFreq);
+
+	SAFE_RELEASE_ARRAY(m_pSoundBuffer);
+
+	m_pSoundBuffer = new float[m_iSoundBufferSize << 1];		// // //
+
+	if (m_pSoundBuffer == NULL)
+		return false;
+
+	ChangeMachine(Machine);
+
+	// // //
+
+	// Numbers of cycles/audio frame
+	m_iFrameCycleCount = BaseFreq / FrameRate;
+
+	return true;
+}
+
+void CAPU::AddTime(int32 Cycles)
+{
+	if (Cycles < 0)
+		return;
+	m_iCyclesToRun += Cycles;
+}
+
+void CAPU::Write(uint16 Address, uint8 Value)
+{
+	// Data was written to an APU register
+	//
+
+	Write(0, Address, Value);		// // //
+}
+
+void CAPU::Write(unsigned Chip, uint16 Address, uint8 Value)		// // //
+{
+	// Data was written to a register of an SN76489 instance
+	// The write is applied after the cycles added so far have been emulated
+	// Writes to instances that are not present are ignored, like expansion chips
+	//
+
+	if (Chip >= m_pSN76489.size())
+		return;
+
+	if (Address == CSN76489::STEREO_PORT || Address <= 0x10 || Address == (uint16)-1) {		// // //
+		m_WriteQueue.push_back({m_iCyclesToRun, Address, Value, (uint8)Chip});
+	}
+
+	// // //m_iRegs[Address & 0x1F] = Value;
+
+#ifdef LOGGING
+	m_iRegs[Address & 0x1F] = Value;
+#endif
+}
+
+// // //
+
+void CAPU::ExternalWrite(uint16 Address, uint8 Value)
+{
+	// Data was written to an external sound chip 
+	// (this doesn't really belong in the APU but are here for convenience)
+	//
+
+	Process();
+
+	// // //
+}
+
+uint8 CAPU::ExternalRead(uint16 Address)
+{
+	// Data read from an external chip
+	//
+
+	uint8 Value(0);
+	bool Mapped(false);
+
+	Process();
+
+	// // //
+
+	if (!Mapped)
+		Value = Address >> 8;	// open bus
+
+	return Value;
+}
+
+// Expansion for famitracker
+
+int32 CAPU::GetVol(uint8 Chan) const	
+{
+	return m_pMixer->GetChanOutput(Chan);
+}
+
+// // //
+
+#ifdef LOGGING
+void CAPU::Log()
+{
+	CString str;
+	str.Format("Frame %08i: ", m_iFrame);
+	for (int i = 0; i < 0x14; ++i)
+		str.AppendFormat("%02X ", m_iRegs[i]);
+	str.Append("\n");
+	m_pLog->Write(str, str.GetLength());
+}
+#endif
+
+void CAPU::SetChipLevel(chip_level_t Chip, float Level) const
+{
+	float fLevel = powf(10, Level / 20.0f);		// Convert dB to linear
+
+	// // //
+	m_pMixer->SetChipLevel(Chip, fLevel);
+}
+
+void CAPU::SetStereoSeparation(float Sep) const		// // //
+{
+	m_pMixer->SetChipLevel(CHIP_LEVEL_SN7Sep, Sep);
+}
+
+void CAPU::SetMetering(bool Enable) const		// // //
+{
+	m_pMixer->SetMetering(Enable);
+}
+
+bool CAPU::SetStemCount(int Count)		// // //
+{
+	// Stems are rendered along with the master mix in the same pass, this should
+	// be called while the APU is reset
+	//
+
+	if (!m_pMixer->SetStemCount(Count))
+		return false;
+	SetupStemResamplers();
+	return true;
+}
+
+int CAPU::GetStemCount() const		// // //
+{
+	return m_pMixer->GetStemCount();
+}
+
+void CAPU::SetupStemResamplers()		// // //
+{
+	for (auto &x : m_pStemResamplers)
+		SAFE_RELEASE(x);
+	m_pStemResamplers.clear();
+
+	if (m_pResampler == NULL)
+		return;
+	for (int i = 0, n = m_pMixer->GetStemCount(); i < n; ++i) {
+		m_pStemResamplers.push_back(new COutputResampler());
+		m_pStemResamplers.back()->Init(m_iOutputSampleRate, m_bStereoEnabled ? 2 : 1);
+	}
+}
+
+void CAPU::SetVGMWriter(VGMChip Chip, const CVGMWriterBase *pWrite, unsigned Instance)		// // //
+{
+	switch (Chip) {
+	case VGMChip::SN76489:
+		if (Instance < m_pSN76489.size())
+			m_pSN76489[Instance]->SetVGMWriter(pWrite);
+		break;
+	}
+}
+
+void CAPU::SetChipCount(unsigned Count)		// // //
+{
+	// Adds or removes SN76489 instances, new instances start silent
+	//
+
+	Count = std::max(1u, std::min(Count, MAX_SN76489_CHIPS));
+
+	Process();
+
+	while (m_pSN76489.size() > Count) {
+		// Return the mixer channels of the removed instance to zero, otherwise
+		// their last levels would remain in the output as an offset
+		const int First = (int)(m_pSN76489.size() - 1) * SN76489_CHANNELS;
+		for (int i = First; i < First + SN76489_CHANNELS; ++i)
+			m_pMixer->AddValue(i, SNDCHIP_NONE, 0, 0, m_iFrameCycles);
+		delete m_pSN76489.back();
+		m_pSN76489.pop_back();
+	}
+	while (m_pSN76489.size() < Count) {
+		CSN76489 *pChip = new CSN76489(m_pMixer, (unsigned)m_pSN76489.size());
+		pChip->Reset();
+		m_pSN76489.push_back(pChip);
+	}
+}
+
+unsigned CAPU::GetChipCount() const		// // //
+{
+	return (unsigned)m_pSN76489.size();
+}
+
+uint8 CAPU::GetReg(int Chip, int Reg) const 
+{
+	switch (Chip) {
+		case SNDCHIP_NONE:
+			return m_iRegs[Reg & 0x1F]; 
+		// // //
+	}
+
+	return 0;
+}
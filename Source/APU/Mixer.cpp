@@ -1,311 +1,482 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-/*
-
- This will mix and synthesize the APU audio using blargg's blip-buffer
-
- Mixing of internal audio relies on Blargg's findings
-
- Mixing of external channles are based on my own research:
-
- VRC6 (Madara): 
-	Pulse channels has the same amplitude as internal-
-    pulse channels on equal volume levels.
-
- FDS: 
-	Square wave @ v = $1F: 2.4V
-	  			  v = $0F: 1.25V
-	(internal square wave: 1.0V)
-
- MMC5 (just breed): 
-	2A03 square @ v = $0F: 760mV (the cart attenuates internal channels a little)
-	MMC5 square @ v = $0F: 900mV
-
- VRC7:
-	2A03 Square  @ v = $0F: 300mV (the cart attenuates internal channels a lot)
-	VRC7 Patch 5 @ v = $0F: 900mV
-	Did some more tests and found patch 14 @ v=15 to be 13.77dB stronger than a 50% square @ v=15
-
- ---
-
- N163 & 5B are still unknown
-
-*/
-
-#include "../stdafx.h"
-#include <algorithm>		// // //
-#include <memory>
-#include <cmath>
-#include "Mixer.h"
-#include "APU.h"
-#include "SN76489_new.h"		// // //
-
-//#define LINEAR_MIXING
-
-static const double AMP_2A03 = 400.0;
-
-static const float LEVEL_FALL_OFF_RATE	= 0.6f;
-static const int   LEVEL_FALL_OFF_DELAY = 3;
-
-CMixer::CMixer()
-{
-	memset(m_iChannelsLeft, 0, sizeof(int32) * CHANNELS);		// // //
-	memset(m_iChannelsRight, 0, sizeof(int32) * CHANNELS);		// // //
-	memset(m_fChannelLevels, 0, sizeof(float) * CHANNELS);
-	memset(m_iChanLevelFallOff, 0, sizeof(uint32) * CHANNELS);
-
-	m_fLevelSN7Left = 1.0f;
-	m_fLevelSN7Right = 1.0f;
-	m_fLevelSN7SepHi = 1.0f;		// // //
-	m_fLevelSN7SepLo = 0.0f;		// // //
-
-	m_iExternalChip = 0;
-	m_iSampleRate = 0;
-	m_iLowCut = 0;
-	m_iHighCut = 0;
-	m_iHighDamp = 0;
-	m_fOverallVol = 1.0f;
-
-	m_dSumSS = 0.0;
-	m_dSumTND = 0.0;
-}
-
-CMixer::~CMixer()
-{
-}
-
-// // //
-
-void CMixer::ExternalSound(int Chip)
-{
-	m_iExternalChip = Chip;
-	UpdateSettings(m_iLowCut, m_iHighCut, m_iHighDamp, m_fOverallVol);
-}
-
-void CMixer::SetChipLevel(chip_level_t Chip, float Level)
-{
-	switch (Chip) {
-		case CHIP_LEVEL_SN7L:
-			m_fLevelSN7Left = Level;
-			break;
-		case CHIP_LEVEL_SN7R:
-			m_fLevelSN7Right = Level;
-			break;
-		case CHIP_LEVEL_SN7Sep:		// // //
-			m_fLevelSN7SepHi = .5f + Level / 2.f;
-			m_fLevelSN7SepLo = .5f - Level / 2.f;
-			break;
-	}
-}
-
-float CMixer::GetAttenuation() const
-{
-	// // //
-
-	float Attenuation = 1.0f;
-
-	// Increase headroom if some expansion chips are enabled
-
-	// // //
-
-	return Attenuation;
-}
-
-void CMixer::UpdateSettings(int LowCut,	int HighCut, int HighDamp, float OverallVol)
-{
-	float Volume = OverallVol * GetAttenuation();
-
-	// Blip-buffer filtering
-	BlipBufferLeft.bass_freq(LowCut);
-	BlipBufferRight.bass_freq(LowCut);		// // //
-
-	blip_eq_t eq(-HighDamp, HighCut, m_iSampleRate);
-
-	SynthSN76489Left.treble_eq(eq);
-	SynthSN76489Right.treble_eq(eq);
-	// // //
-
-	// Volume levels
-	SynthSN76489Left.volume(Volume * 0.2f * m_fLevelSN7Left);
-	SynthSN76489Right.volume(Volume * 0.2f * m_fLevelSN7Right);		// // //
-
-	m_iLowCut = LowCut;
-	m_iHighCut = HighCut;
-	m_iHighDamp = HighDamp;
-	m_fOverallVol = OverallVol;
-}
-
-// // //
-
-void CMixer::MixSamples(blip_sample_t *pBuffer, uint32 Count)
-{
-	// For VRC7
-	BlipBufferLeft.mix_samples(pBuffer, Count);
-	//blip_mix_samples(, Count);
-}
-
-uint32 CMixer::GetMixSampleCount(int t) const
-{
-	return BlipBufferLeft.count_samples(t);
-}
-
-bool CMixer::AllocateBuffer(unsigned int BufferLength, uint32 SampleRate, uint8 NrChannels)
-{
-	m_iSampleRate = SampleRate;
-	return BlipBufferLeft.set_sample_rate(SampleRate, (BufferLength * 1000 * 2) / SampleRate) == nullptr		// // //
-		&& BlipBufferRight.set_sample_rate(SampleRate, (BufferLength * 1000 * 2) / SampleRate) == nullptr;
-}
-
-void CMixer::SetClockRate(uint32 Rate)
-{
-	// Change the clockrate
-	BlipBufferLeft.clock_rate(Rate);
-	BlipBufferRight.clock_rate(Rate);		// // //
-}
-
-void CMixer::ClearBuffer()
-{
-	BlipBufferLeft.clear();
-	BlipBufferRight.clear();		// // //
-
-	m_dSumSS = 0;
-	m_dSumTND = 0;
-}
-
-int CMixer::SamplesAvail() const
-{	
-	return std::min<int>(BlipBufferLeft.samples_avail(), BlipBufferRight.samples_avail());		// // //
-}
-
-int CMixer::FinishBuffer(int t)
-{
-	BlipBufferLeft.end_frame(t);
-	BlipBufferRight.end_frame(t);		// // //
-
-	for (int i = 0; i < CHANNELS; ++i) {
-		if (m_iChanLevelFallOff[i] > 0)
-			m_iChanLevelFallOff[i]--;
-		else {
-			if (m_fChannelLevels[i] > 0) {
-				m_fChannelLevels[i] -= LEVEL_FALL_OFF_RATE;
-				if (m_fChannelLevels[i] < 0)
-					m_fChannelLevels[i] = 0;
-			}
-		}
-	}
-
-	// Return number of samples available
-	return SamplesAvail();		// // //
-}
-
-//
-// Mixing
-//
-
-// // //
-
-void CMixer::AddValue(int ChanID, int Chip, int Left, int Right, int FrameCycles)		// // //
-{
-	// Add sound to mixer
-	//
-	
-	StoreChannelLevel(ChanID, (int)sqrt((Left * Left + Right * Right) / 2));		// // //
-
-	if (int Delta = Left - m_iChannelsLeft[ChanID]) {		// // //
-		m_iChannelsLeft[ChanID] = Left;
-		switch (Chip) {
-		case SNDCHIP_NONE:
-			switch (ChanID) {
-			case CHANID_SQUARE1:
-			case CHANID_SQUARE2:
-			case CHANID_SQUARE3:
-			case CHANID_NOISE:
-				SynthSN76489Left.offset(FrameCycles, (int)(Delta * m_fLevelSN7SepHi), &BlipBufferLeft);
-				SynthSN76489Right.offset(FrameCycles, (int)(Delta * m_fLevelSN7SepLo), &BlipBufferRight);
-			}
-			break;
-		}
-	}
-
-	if (int Delta = Right - m_iChannelsRight[ChanID]) {		// // //
-		m_iChannelsRight[ChanID] = Right;
-		switch (Chip) {
-		case SNDCHIP_NONE:
-			switch (ChanID) {
-			case CHANID_SQUARE1:
-			case CHANID_SQUARE2:
-			case CHANID_SQUARE3:
-			case CHANID_NOISE:
-				SynthSN76489Left.offset(FrameCycles, (int)(Delta * m_fLevelSN7SepLo), &BlipBufferLeft);
-				SynthSN76489Right.offset(FrameCycles, (int)(Delta * m_fLevelSN7SepHi), &BlipBufferRight);
-			}
-			break;
-		}
-	}
-}
-
-int CMixer::ReadBuffer(int Size, void *Buffer, bool Stereo)
-{
-	if (Stereo) {		// // //
-		long Samples = BlipBufferLeft.read_samples((blip_sample_t*)Buffer, Size, true);
-		Samples += BlipBufferRight.read_samples((blip_sample_t*)Buffer + 1, Size, true);
-		return Samples;
-	}
-	return BlipBufferLeft.read_samples((blip_sample_t*)Buffer, Size);
-}
-
-int32 CMixer::GetChanOutput(uint8 Chan) const
-{
-	return (int32)m_fChannelLevels[Chan];
-}
-
-void CMixer::StoreChannelLevel(int Channel, int Value)
-{
-	int AbsVol = abs(Value);
-
-	// Adjust channel levels for some channels
-	switch (Channel) {		// // // 
-	case CHANID_SQUARE1:
-	case CHANID_SQUARE2:
-	case CHANID_SQUARE3:
-	case CHANID_NOISE:
-		int Lv = AbsVol;
-		AbsVol = 0;
-		while (AbsVol < 15 && Lv >= CSN76489::VOLUME_TABLE[14 - AbsVol])
-			++AbsVol;
-	}
-
-	if (float(AbsVol) >= m_fChannelLevels[Channel]) {
-		m_fChannelLevels[Channel] = float(AbsVol);
-		m_iChanLevelFallOff[Channel] = LEVEL_FALL_OFF_DELAY;
-	}
-}
-
-void CMixer::ClearChannelLevels()
-{
-	memset(m_fChannelLevels, 0, sizeof(float) * CHANNELS);
-	memset(m_iChanLevelFallOff, 0, sizeof(uint32) * CHANNELS);
-}
-
-uint32 CMixer::ResampleDuration(uint32 Time) const
-{
-	return (uint32)BlipBufferLeft.resampled_duration((blip_time_t)Time);
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+/*
+
+ This will mix and synthesize the APU audio using blargg's blip-buffer
+
+ Mixing of internal audio relies on Blargg's findings
+
+ Mixing of external channles are based on my own research:
+
+ VRC6 (Madara): 
+	Pulse channels has the same amplitude as internal-
+    pulse channels on equal volume levels.
+
+ FDS: 
+	Square wave @ v = $1F: 2.4V
+	  			  v = $0F: 1.25V
+	(internal square wave: 1.0V)
+
+ MMC5 (just breed): 
+	2A03 square @ v = $0F: 760mV (the cart attenuates internal channels a little)
+	MMC5 square @ v = $0F: 900mV
+
+ VRC7:
+	2A03 Square  @ v = $0F: 300mV (the cart attenuates internal channels a lot)
+	VRC7 Patch 5 @ v = $0F: 900mV
+	Did some more tests and found patch 14 @ v=15 to be 13.77dB stronger than a 50% square @ v=15
+
+ ---
+
+ N163 & 5B are still unknown
+
+*/
+
+#include <algorithm>		// // //
+#include <memory>
+#include <cmath>
+#include <cstring>		// // //
+#include "Mixer.h"
+#include "APU.h"
+#include "SN76489_new.h"		// // //
+#include "StereoReader.h"		// // //
+
+//#define LINEAR_MIXING
+
+static const double AMP_2A03 = 400.0;
+
+static const float LEVEL_FALL_OFF_RATE	= 0.6f;
+static const int   LEVEL_FALL_OFF_DELAY = 3;
+
+CMixer::CMixer()
+{
+	memset(m_iChannelsLeft, 0, sizeof(int32) * MIXER_CHANNELS);		// // //
+	memset(m_iChannelsRight, 0, sizeof(int32) * MIXER_CHANNELS);		// // //
+	memset(m_fChannelLevels, 0, sizeof(float) * MIXER_CHANNELS);
+	memset(m_iChanLevelFallOff, 0, sizeof(uint32) * MIXER_CHANNELS);
+	std::fill_n(m_iChanPeak, MIXER_CHANNELS, -1);		// // //
+	m_bMetering = true;
+
+	m_fLevelSN7Left = 1.0f;
+	m_fLevelSN7Right = 1.0f;
+	m_fLevelSN7SepHi = 1.0f;		// // //
+	m_fLevelSN7SepLo = 0.0f;		// // //
+
+	m_iExternalChip = 0;
+	m_iSampleRate = 0;
+	m_iLowCut = 0;
+	m_iHighCut = 0;
+	m_iHighDamp = 0;
+	m_fOverallVol = 1.0f;
+
+	m_dSumSS = 0.0;
+	m_dSumTND = 0.0;
+}
+
+CMixer::~CMixer()
+{
+}
+
+// // //
+
+void CMixer::ExternalSound(int Chip)
+{
+	m_iExternalChip = Chip;
+	UpdateSettings(m_iLowCut, m_iHighCut, m_iHighDamp, m_fOverallVol);
+}
+
+void CMixer::SetChipLevel(chip_level_t Chip, float Level)
+{
+	switch (Chip) {
+		case CHIP_LEVEL_SN7L:
+			m_fLevelSN7Left = Level;
+			break;
+		case CHIP_LEVEL_SN7R:
+			m_fLevelSN7Right = Level;
+			break;
+		case CHIP_LEVEL_SN7Sep:		// // //
+			m_fLevelSN7SepHi = .5f + Level / 2.f;
+			m_fLevelSN7SepLo = .5f - Level / 2.f;
+			break;
+	}
+}
+
+void CMixer::SetMetering(bool Enable)		// // //
+{
+	m_bMetering = Enable;
+	ClearChannelLevels();
+}
+
+float CMixer::GetAttenuation() const
+{
+	// // //
+
+	float Attenuation = 1.0f;
+
+	// Increase headroom if some expansion chips are enabled
+
+	// // //
+
+	return Attenuation;
+}
+
+void CMixer::UpdateSettings(int LowCut,	int HighCut, int HighDamp, float OverallVol)
+{
+	float Volume = OverallVol * GetAttenuation();
+
+	// Blip-buffer filtering
+	BlipBufferMid.bass_freq(LowCut);
+	BlipBufferSide.bass_freq(LowCut);		// // //
+	for (auto &x : m_pStems) {		// // //
+		x->Mid.bass_freq(LowCut);
+		x->Side.bass_freq(LowCut);
+	}
+
+	blip_eq_t eq(-HighDamp, HighCut, m_iSampleRate);
+
+	SynthSN76489.treble_eq(eq);		// // //
+
+	// Volume levels, chip levels and stereo separation are applied in ReadBuffer
+	SynthSN76489.volume(Volume * 0.2f);		// // //
+
+	m_iLowCut = LowCut;
+	m_iHighCut = HighCut;
+	m_iHighDamp = HighDamp;
+	m_fOverallVol = OverallVol;
+}
+
+// // //
+
+void CMixer::MixSamples(blip_sample_t *pBuffer, uint32 Count)
+{
+	// For VRC7
+	BlipBufferMid.mix_samples(pBuffer, Count);
+	//blip_mix_samples(, Count);
+}
+
+uint32 CMixer::GetMixSampleCount(int t) const
+{
+	return BlipBufferMid.count_samples(t);
+}
+
+bool CMixer::AllocateBuffer(unsigned int BufferLength, uint32 SampleRate, uint8 NrChannels)
+{
+	m_iSampleRate = SampleRate;
+	const int Length = (BufferLength * 1000 * 2) / SampleRate;
+	if (BlipBufferMid.set_sample_rate(SampleRate, Length) != nullptr		// // //
+		|| BlipBufferSide.set_sample_rate(SampleRate, Length) != nullptr)
+		return false;
+	for (auto &x : m_pStems)		// // //
+		if (x->Mid.set_sample_rate(SampleRate, Length) != nullptr || x->Side.set_sample_rate(SampleRate, Length) != nullptr)
+			return false;
+	return true;
+}
+
+void CMixer::SetClockRate(uint32 Rate)
+{
+	// Change the clockrate
+	BlipBufferMid.clock_rate(Rate);
+	BlipBufferSide.clock_rate(Rate);		// // //
+	for (auto &x : m_pStems) {		// // //
+		x->Mid.clock_rate(Rate);
+		x->Side.clock_rate(Rate);
+	}
+}
+
+void CMixer::ClearBuffer()
+{
+	BlipBufferMid.clear();
+	BlipBufferSide.clear();		// // //
+	for (auto &x : m_pStems) {		// // //
+		x->Mid.clear();
+		x->Side.clear();
+	}
+
+	m_dSumSS = 0;
+	m_dSumTND = 0;
+}
+
+int CMixer::SamplesAvail() const
+{	
+	return std::min<int>(BlipBufferMid.samples_avail(), BlipBufferSide.samples_avail());		// // //
+}
+
+int CMixer::FinishBuffer(int t)
+{
+	BlipBufferMid.end_frame(t);
+	BlipBufferSide.end_frame(t);		// // //
+	for (auto &x : m_pStems) {		// // //
+		x->Mid.end_frame(t);
+		x->Side.end_frame(t);
+	}
+
+	if (!m_bMetering)		// // //
+		return SamplesAvail();
+
+	for (int i = 0; i < MIXER_CHANNELS; ++i) {		// // //
+		if (m_iChanPeak[i] >= 0) {		// // //
+			StoreChannelLevel(i, (int)sqrt(m_iChanPeak[i] / 2));
+			m_iChanPeak[i] = -1;
+		}
+
+		if (m_iChanLevelFallOff[i] > 0)
+			m_iChanLevelFallOff[i]--;
+		else {
+			if (m_fChannelLevels[i] > 0) {
+				m_fChannelLevels[i] -= LEVEL_FALL_OFF_RATE;
+				if (m_fChannelLevels[i] < 0)
+					m_fChannelLevels[i] = 0;
+			}
+		}
+	}
+
+	// Return number of samples available
+	return SamplesAvail();		// // //
+}
+
+//
+// Mixing
+//
+
+// // //
+
+// // // Mid and side levels, deltas are taken between these so that rounding does not accumulate
+
+static inline int GetMid(int Left, int Right)
+{
+	return (Left + Right) >> 1;
+}
+
+static inline int GetSide(int Left, int Right)
+{
+	return (Left - Right) >> 1;
+}
+
+void CMixer::AddValue(int ChanID, int Chip, int Left, int Right, int FrameCycles)		// // //
+{
+	// Add sound to mixer
+	// // // ChanID is the channel of an SN76489 instance, offset by SN76489_CHANNELS for each instance
+	//
+	
+	StorePeak(ChanID, Left * Left + Right * Right);		// // //
+
+	const int PrevLeft = m_iChannelsLeft[ChanID];		// // //
+	const int PrevRight = m_iChannelsRight[ChanID];
+	if (Left == PrevLeft && Right == PrevRight)
+		return;
+	m_iChannelsLeft[ChanID] = Left;
+	m_iChannelsRight[ChanID] = Right;
+
+	switch (Chip) {
+	case SNDCHIP_NONE: {		// // // all instances share the synth
+		stem_buffer_t *pStem = GetStem(ChanID);		// // //
+		if (int Mid = GetMid(Left, Right) - GetMid(PrevLeft, PrevRight)) {		// // //
+			SynthSN76489.offset(FrameCycles, Mid, &BlipBufferMid);
+			if (pStem != nullptr)
+				SynthSN76489.offset(FrameCycles, Mid, &pStem->Mid);
+		}
+		if (int Side = GetSide(Left, Right) - GetSide(PrevLeft, PrevRight)) {
+			SynthSN76489.offset(FrameCycles, Side, &BlipBufferSide);
+			if (pStem != nullptr)
+				SynthSN76489.offset(FrameCycles, Side, &pStem->Side);
+		}
+		break;
+	}
+	}
+}
+
+void CMixer::AddToggles(int ChanID, int Chip, int Left, int Right, int FrameCycles, int Period, int Count)		// // //
+{
+	// Add Count level changes Period cycles apart, starting at FrameCycles, that
+	// alternate between (Left, Right) and silence. The channel must currently be
+	// at one of these two levels. Gives the same output as calling AddValue for
+	// every change.
+	//
+
+	if (Count <= 0)
+		return;
+
+	if (Chip != SNDCHIP_NONE)		// // //
+		return;
+
+	const bool Rising = m_iChannelsLeft[ChanID] != Left || m_iChannelsRight[ChanID] != Right;
+	StorePeak(ChanID, (Rising || Count > 1) ? Left * Left + Right * Right : 0);
+	if (Count & 1) {
+		m_iChannelsLeft[ChanID] = Rising ? Left : 0;
+		m_iChannelsRight[ChanID] = Rising ? Right : 0;
+	}
+
+	int DeltaMid = GetMid(Left, Right);
+	int DeltaSide = GetSide(Left, Right);
+	if (!Rising) {
+		DeltaMid = -DeltaMid;
+		DeltaSide = -DeltaSide;
+	}
+
+	AddToggleDeltas(BlipBufferMid, FrameCycles, Period, DeltaMid, Count);
+	AddToggleDeltas(BlipBufferSide, FrameCycles, Period, DeltaSide, Count);
+	if (stem_buffer_t *pStem = GetStem(ChanID)) {		// // //
+		AddToggleDeltas(pStem->Mid, FrameCycles, Period, DeltaMid, Count);
+		AddToggleDeltas(pStem->Side, FrameCycles, Period, DeltaSide, Count);
+	}
+}
+
+void CMixer::AddToggleDeltas(Blip_Buffer &Buffer, int FrameCycles, int Period, int Delta, int Count)		// // //
+{
+	if (!Delta)
+		return;
+	const blip_resampled_time_t Step = Buffer.resampled_duration(Period);
+	blip_resampled_time_t Time = Buffer.resampled_time(FrameCycles);
+	for (int i = 0; i < Count; ++i, Time += Step, Delta = -Delta)
+		SynthSN76489.offset_resampled(Time, Delta, &Buffer);
+}
+
+int CMixer::ReadBuffer(int Size, float *Buffer, bool Stereo)
+{
+	return ReadMidSide(BlipBufferMid, BlipBufferSide, Size, Buffer, Stereo);		// // //
+}
+
+int CMixer::ReadStem(int Stem, int Size, float *Buffer, bool Stereo)		// // //
+{
+	// Reads a stem the same way as the master mix, the sum of all stems is the
+	// master mix if every channel has a stem
+
+	if (Stem < 0 || Stem >= GetStemCount())
+		return 0;
+	return ReadMidSide(m_pStems[Stem]->Mid, m_pStems[Stem]->Side, Size, Buffer, Stereo);
+}
+
+bool CMixer::SetStemCount(int Count)		// // //
+{
+	// Stems follow the current buffer settings, this should only be called while
+	// the buffers are empty so that they line up with the master mix
+
+	Count = std::max(0, std::min(Count, MIXER_CHANNELS));
+	if (Count < GetStemCount())
+		m_pStems.resize(Count);
+
+	while (GetStemCount() < Count) {
+		auto pStem = std::make_unique<stem_buffer_t>();
+		for (Blip_Buffer *x : {&pStem->Mid, &pStem->Side}) {
+			x->bass_freq(m_iLowCut);
+			if (m_iSampleRate && x->set_sample_rate(BlipBufferMid.sample_rate(), BlipBufferMid.length()) != nullptr)
+				return false;
+			if (BlipBufferMid.clock_rate())
+				x->clock_rate(BlipBufferMid.clock_rate());
+		}
+		m_pStems.push_back(std::move(pStem));
+	}
+
+	return true;
+}
+
+int CMixer::GetStemCount() const		// // //
+{
+	return static_cast<int>(m_pStems.size());
+}
+
+CMixer::stem_buffer_t *CMixer::GetStem(int ChanID) const		// // //
+{
+	return ChanID < GetStemCount() ? m_pStems[ChanID].get() : nullptr;
+}
+
+int CMixer::ReadMidSide(Blip_Buffer &BufferMid, Blip_Buffer &BufferSide, int Size, float *Buffer, bool Stereo)		// // //
+{
+	// // // Convert the mid and side signals to left and right, the stereo separation
+	// and chip levels are applied here instead of for every delta. The output is not
+	// clamped, 1.0 is full scale
+
+	const float Sep = m_fLevelSN7SepHi - m_fLevelSN7SepLo;
+	stereo_matrix_t Matrix = {
+		m_fLevelSN7Left, m_fLevelSN7Left * Sep,
+		m_fLevelSN7Right, -m_fLevelSN7Right * Sep,
+	};
+	if (!Stereo) {
+		Matrix.RightMid = Matrix.LeftMid;
+		Matrix.RightSide = Matrix.LeftSide;
+	}
+
+	long Count = std::min<long>(Size, std::min(BufferMid.samples_avail(), BufferSide.samples_avail()));
+	float *pBuffer = Buffer;
+	if (!Stereo) {
+		if (m_fMonoSamples.size() < (size_t)Count * 2)
+			m_fMonoSamples.resize(Count * 2);
+		pBuffer = m_fMonoSamples.data();
+	}
+
+	Blip_Reader Mid, Side;
+	int BassShift = Mid.begin(BufferMid);
+	Side.begin(BufferSide);		// same bass frequency
+	CStereoReader::Read(Mid.data(), Side.data(), Mid.raw_accum(), Side.raw_accum(),
+		BassShift, Matrix, pBuffer, Count);
+	Mid.end(BufferMid);
+	Side.end(BufferSide);
+	BufferMid.remove_samples(Count);
+	BufferSide.remove_samples(Count);
+
+	if (Stereo)
+		return Count * 2;
+
+	for (long i = 0; i < Count; ++i)
+		Buffer[i] = m_fMonoSamples[i * 2];
+	return Count;
+}
+
+int32 CMixer::GetChanOutput(uint8 Chan) const
+{
+	return (int32)m_fChannelLevels[Chan];
+}
+
+void CMixer::StorePeak(int Channel, int Power)		// // //
+{
+	// Meter levels are only computed once per frame in FinishBuffer, since a
+	// single update with the highest level gives the same result
+	if (m_bMetering && Power > m_iChanPeak[Channel])
+		m_iChanPeak[Channel] = Power;
+}
+
+void CMixer::StoreChannelLevel(int Channel, int Value)
+{
+	int AbsVol = abs(Value);
+
+	// // // Convert to the attenuation scale, every channel belongs to an SN76489
+	int Lv = AbsVol;
+	AbsVol = 0;
+	while (AbsVol < 15 && Lv >= CSN76489::VOLUME_TABLE[14 - AbsVol])
+		++AbsVol;
+
+	if (float(AbsVol) >= m_fChannelLevels[Channel]) {
+		m_fChannelLevels[Channel] = float(AbsVol);
+		m_iChanLevelFallOff[Channel] = LEVEL_FALL_OFF_DELAY;
+	}
+}
+
+void CMixer::ClearChannelLevels()
+{
+	memset(m_fChannelLevels, 0, sizeof(float) * MIXER_CHANNELS);		// // //
+	memset(m_iChanLevelFallOff, 0, sizeof(uint32) * MIXER_CHANNELS);
+	std::fill_n(m_iChanPeak, MIXER_CHANNELS, -1);		// // //
+}
+
+uint32 CMixer::ResampleDuration(uint32 Time) const
+{
+	return (uint32)BlipBufferMid.resampled_duration((blip_time_t)Time);
+}
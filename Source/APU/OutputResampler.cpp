@@ -0,0 +1,106 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "OutputResampler.h"
+#include <algorithm>
+#include <cmath>
+#include "../resampler/resample.inl"
+
+const uint32 COutputResampler::INTERNAL_SAMPLE_RATE = 192000;
+
+namespace {
+
+// 16 zero crossings on each side of the impulse response
+const size_t SINC_SIZE = 4096;
+const size_t SINC_FIRST_NULL = 256;
+
+// Passband relative to the output Nyquist frequency
+const float CUTOFF = 0.9f;
+
+} // namespace
+
+COutputResampler::CChannel::CChannel(const jarh::sinc &Sinc) :
+	jarh::resample<CChannel>(Sinc),
+	m_iInputPos(0)
+{
+}
+
+void COutputResampler::CChannel::Push(const float *pInput, uint32 Count, int Stride)
+{
+	m_fInput.erase(m_fInput.begin(), m_fInput.begin() + m_iInputPos);
+	m_iInputPos = 0;
+	for (uint32 i = 0; i < Count; ++i)
+		m_fInput.push_back(pInput[i * Stride]);
+}
+
+bool COutputResampler::CChannel::Ready() const
+{
+	return m_fInput.size() - m_iInputPos >= needed();
+}
+
+bool COutputResampler::CChannel::initstream()
+{
+	m_fInput.clear();
+	m_iInputPos = 0;
+	return true;
+}
+
+float *COutputResampler::CChannel::fill(float *begin, float *end)
+{
+	// Only the initial window may be requested before any input arrives, it is
+	// padded with silence; otherwise Ready() guarantees enough input
+	size_t Count = std::min<size_t>(end - begin, m_fInput.size() - m_iInputPos);
+	std::copy(m_fInput.begin() + m_iInputPos, m_fInput.begin() + m_iInputPos + Count, begin);
+	std::fill(begin + Count, end, 0.f);
+	m_iInputPos += Count;
+	return end;
+}
+
+COutputResampler::COutputResampler() :
+	m_Sinc(SINC_SIZE, SINC_FIRST_NULL),
+	m_Channel {CChannel {m_Sinc}, CChannel {m_Sinc}},
+	m_iChannels(2)
+{
+}
+
+void COutputResampler::Init(uint32 OutputRate, int NrChannels)
+{
+	m_iChannels = NrChannels == 2 ? 2 : 1;
+	for (auto &x : m_Channel)
+		x.init((float)OutputRate / INTERNAL_SAMPLE_RATE, CUTOFF);
+}
+
+uint32 COutputResampler::Process(const float *pInput, uint32 Size, float *pOutput, uint32 MaxSize)
+{
+	const uint32 Count = Size / m_iChannels;
+	for (int i = 0; i < m_iChannels; ++i)
+		m_Channel[i].Push(pInput + i, Count, m_iChannels);
+
+	// All channels consume their input at the same positions
+	uint32 Written = 0;
+	while (Written + m_iChannels <= MaxSize && m_Channel[0].Ready()) {
+		for (int i = 0; i < m_iChannels; ++i)
+			pOutput[Written++] = m_Channel[i].get();
+	}
+
+	return Written;
+}
@@ -0,0 +1,73 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include <vector>
+#include "../Common.h"
+#include "../resampler/resample.hpp"
+
+// // // High quality output path
+//
+// The mixer synthesizes at a fixed internal rate, and its interleaved output is
+// converted to the output rate by the polyphase FIR resampler. Used for offline
+// renders only, realtime playback synthesizes at the output rate directly.
+
+class COutputResampler
+{
+public:
+	COutputResampler();
+
+	void	Init(uint32 OutputRate, int NrChannels);
+
+	// Converts Size interleaved samples at the internal rate, returns the number of
+	// interleaved samples written to the output
+	uint32	Process(const float *pInput, uint32 Size, float *pOutput, uint32 MaxSize);
+
+public:
+	static const uint32 INTERNAL_SAMPLE_RATE;
+
+private:
+	// Pulls its input from the samples pushed since the last frame
+	class CChannel : public jarh::resample<CChannel>
+	{
+		friend class jarh::resample<CChannel>;
+	public:
+		explicit CChannel(const jarh::sinc &Sinc);
+
+		void	Push(const float *pInput, uint32 Count, int Stride);
+		bool	Ready() const;
+
+	protected:
+		bool	initstream();
+		float	*fill(float *begin, float *end);
+
+	private:
+		std::vector<float> m_fInput;
+		size_t	m_iInputPos;
+	};
+
+private:
+	jarh::sinc	m_Sinc;
+	CChannel	m_Channel[2];
+	int			m_iChannels;
+};
@@ -1,301 +1,369 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include "SN76489_new.h"
-#include "../VGM/Writer/Base.h"
-
-const uint16 CSN76489::STEREO_PORT = 0x4F;
-const uint16 CSN76489::VOLUME_TABLE[] = {
-	1516, 1205, 957, 760, 603, 479, 381, 303, 240, 191, 152, 120, 96, 76, 60, 0
-};
-const uint16 CSNSquare::CUTOFF_PERIOD = /* 0x01 */ 0x06;
-
-
-
-void CSN76489Channel::Reset()
-{
-	SetStereo(true, true);
-	SetAttenuation(0xF);
-}
-
-void CSN76489Channel::SetVGMWriter(const CVGMWriterBase *pWrite)
-{
-	m_pVGMWriter = pWrite;
-}
-
-void CSN76489Channel::SetStereo(bool Left, bool Right)
-{
-	m_bLeft = Left;
-	m_bRight = Right;
-}
-
-void CSN76489Channel::SetAttenuation(uint8 Value)
-{
-	Value &= 0xF;
-	if (Value != m_iAttenuation) {
-		if (m_pVGMWriter != nullptr)
-			m_pVGMWriter->WriteReg(0, 0x90 | (m_iChanId << 5) | Value);
-		m_iAttenuation = Value;
-	}
-}
-
-int32 CSN76489Channel::GetVolume() const
-{
-	return CSN76489::VOLUME_TABLE[m_iAttenuation];
-}
-
-
-
-CSNSquare::CSNSquare(CMixer *pMixer, int ID) :
-	CSN76489Channel(pMixer, 0, ID)
-{
-}
-
-CSNSquare::~CSNSquare()
-{
-}
-
-void CSNSquare::Reset()
-{
-	CSN76489Channel::Reset();
-	
-	SetPeriodLo(0);
-	SetPeriodHi(0);
-
-	m_iSquareCounter = 0;
-	m_bSqaureActive = true;
-}
-
-void CSNSquare::Process(uint32 Time)
-{
-	uint16 Period = GetPeriod();
-	if (!Period)
-		Period = 1; // or 0x400 according to one of the vgm flags
-
-	while (Time >= m_iSquareCounter) {
-		Time -= m_iSquareCounter;
-		m_iTime += m_iSquareCounter;
-		m_iSquareCounter = Period << 4;
-		m_bSqaureActive = Period > CUTOFF_PERIOD ? !m_bSqaureActive : 0;
-		int32 Vol = m_bSqaureActive ? GetVolume() : 0;
-		Mix(m_bLeft ? Vol : 0, m_bRight ? Vol : 0);
-	}
-
-	m_iSquareCounter -= Time;
-	m_iTime += Time;
-}
-
-void CSNSquare::SetPeriodLo(uint8 Value)
-{
-	m_iPrevPeriod = GetPeriod();
-	m_iSquarePeriodLo = Value & 0xF;
-}
-
-void CSNSquare::SetPeriodHi(uint8 Value)
-{
-	m_iSquarePeriodHi = Value & 0x3F;
-	FlushPeriod();
-}
-
-void CSNSquare::FlushPeriod() const
-{
-	if (m_pVGMWriter == nullptr)
-		return;
-	uint16 NewPeriod = GetPeriod();
-	if (NewPeriod == m_iPrevPeriod)
-		return;
-	m_pVGMWriter->WriteReg(0, 0x80 | (m_iChanId << 5) | m_iSquarePeriodLo);
-	if (m_iSquarePeriodHi != (m_iPrevPeriod >> 4))
-		m_pVGMWriter->WriteReg(0, m_iSquarePeriodHi);
-}
-
-uint16 CSNSquare::GetPeriod() const
-{
-	return m_iSquarePeriodLo | (m_iSquarePeriodHi << 4);
-}
-
-
-
-const uint16 CSNNoise::LFSR_INIT = 0x8000;
-
-CSNNoise::CSNNoise(CMixer *pMixer) :
-	CSN76489Channel(pMixer, 0, CHANID_NOISE), m_iCH3Period(0)
-{
-}
-
-CSNNoise::~CSNNoise()
-{
-}
-
-void CSNNoise::Reset()
-{
-	CSN76489Channel::Reset();
-
-	SetControlMode(SN_NOI_DIV_512 | (SN_NOI_FB_LONG << 2));
-
-	m_iSquareCounter = 0;
-	m_bSqaureActive = true;
-}
-
-void CSNNoise::Process(uint32 Time)
-{
-	uint16 Period;
-	switch (m_iNoiseFreq) {
-	case SN_NOI_DIV_512:  Period = 0x10; break;
-	case SN_NOI_DIV_1024: Period = 0x20; break;
-	case SN_NOI_DIV_2048: Period = 0x40; break;
-	case SN_NOI_DIV_CH3:  Period = m_iCH3Period ? m_iCH3Period : 1; break;
-	default: assert(false);
-	}
-	
-	while (Time >= m_iSquareCounter) {
-		Time -= m_iSquareCounter;
-		m_iTime += m_iSquareCounter;
-		m_iSquareCounter = Period << 4;
-		if ((m_bSqaureActive = !m_bSqaureActive)) {
-			int Feedback = m_iLFSRState;
-			switch (m_iNoiseFeedback) {
-			case SN_NOI_FB_SHORT: Feedback &= 1; break;
-			case SN_NOI_FB_LONG:  Feedback = ((Feedback & 0x0009) && ((Feedback & 0x0009) ^ 0x0009)); break;
-			default: assert(false);
-			}
-			m_iLFSRState = (m_iLFSRState >> 1) | (Feedback << (16 - 1));
-			int32 Vol = (m_iLFSRState & 1) ? GetVolume() : 0;
-			Mix(m_bLeft ? Vol : 0, m_bRight ? Vol : 0);
-		}
-	}
-
-	m_iSquareCounter -= Time;
-	m_iTime += Time;
-}
-
-void CSNNoise::SetControlMode(uint8 Value)
-{
-	Value &= 0x7;
-	m_iNoiseFreq = static_cast<SN_noise_div_t>(Value & 0x03);
-	m_iNoiseFeedback = static_cast<SN_noise_fb_t>(Value & 0x04);
-	m_iLFSRState = LFSR_INIT;
-	if (m_pVGMWriter != nullptr)
-		m_pVGMWriter->WriteReg(0, 0xE0 | Value);
-}
-
-void CSNNoise::CachePeriod(uint16 Period)
-{
-	m_iCH3Period = Period;
-}
-
-
-
-CSN76489::CSN76489(CMixer *pMixer) : CExternal(pMixer)
-{
-	for (int i = CHANID_SQUARE1; i <= CHANID_SQUARE3; ++i)
-		m_pChannels[i] = new CSNSquare(pMixer, i);
-	m_pChannels[CHANID_NOISE] = new CSNNoise(pMixer);
-}
-
-CSN76489::~CSN76489()
-{
-	for (auto &x : m_pChannels)
-		delete x;
-}
-
-void CSN76489::Reset()
-{
-	for (auto &x : m_pChannels)
-		x->Reset();
-
-	m_iAddressLatch = 0;
-}
-
-void CSN76489::Process(uint32 Time)
-{
-	for (auto &x : m_pChannels)
-		x->Process(Time);
-}
-
-void CSN76489::EndFrame()
-{
-	for (int i = CHANID_SQUARE1; i <= CHANID_SQUARE3; ++i)
-		GetSquare(i)->FlushPeriod();
-	for (auto &x : m_pChannels)
-		x->EndFrame();
-}
-
-void CSN76489::Write(uint16 Address, uint8 Value)
-{
-	switch (Address) {
-	case 0: case 2: case 4:
-		m_iAddressLatch = (uint8)Address;
-		GetSquare(Address / 2)->SetPeriodLo(Value);
-		break;
-	case 1: case 3: case 5: case 7:
-		GetSquare(m_iAddressLatch / 2)->FlushPeriod();
-		m_pChannels[Address / 2]->SetAttenuation(Value);
-		break;
-	case 6:
-		GetSquare(m_iAddressLatch / 2)->FlushPeriod();
-		GetNoise()->SetControlMode(Value);
-		break;
-	case STEREO_PORT:
-		if (m_pVGMWriter != nullptr)
-			m_pVGMWriter->WriteReg(0, Value, 0x06);
-		for (const auto &x : m_pChannels) {
-			x->SetStereo((Value & 0x10) != 0, (Value & 0x01) != 0);
-			Value >>= 1;
-		}
-		break;
-	default:
-		GetSquare(m_iAddressLatch / 2)->SetPeriodHi(Value);
-		if (m_iAddressLatch / 2 == CHANID_SQUARE3)
-			UpdateNoisePeriod();
-	}
-
-	if (Address / 2 == CHANID_SQUARE3)
-		UpdateNoisePeriod();
-}
-
-uint8 CSN76489::Read(uint16 Address, bool &Mapped)
-{
-	return 0;
-}
-
-void CSN76489::SetVGMWriter(const CVGMWriterBase *pWrite)
-{
-	for (const auto &x : m_pChannels)
-		x->SetVGMWriter(pWrite);
-	m_pVGMWriter = pWrite;
-}
-
-CSNSquare *CSN76489::GetSquare(uint8 ID) const
-{
-	assert(ID <= 2u && m_pChannels[ID] != nullptr);
-	return static_cast<CSNSquare*>(m_pChannels[ID]);
-}
-
-CSNNoise *CSN76489::GetNoise() const
-{
-	assert(m_pChannels[CHANID_NOISE] != nullptr);
-	return static_cast<CSNNoise*>(m_pChannels[CHANID_NOISE]);
-}
-
-void CSN76489::UpdateNoisePeriod() const
-{
-	GetNoise()->CachePeriod(GetSquare(CHANID_SQUARE3)->GetPeriod());
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "SN76489_new.h"
+#include "../VGM/Writer/Base.h"
+
+const uint16 CSN76489::STEREO_PORT = 0x4F;
+const uint16 CSN76489::VOLUME_TABLE[] = {
+	1516, 1205, 957, 760, 603, 479, 381, 303, 240, 191, 152, 120, 96, 76, 60, 0
+};
+const uint16 CSNSquare::CUTOFF_PERIOD = /* 0x01 */ 0x06;
+
+
+
+CSN76489Channel::CSN76489Channel(CMixer *pMixer, unsigned Instance, uint8 ID) :		// // //
+	CExChannel(pMixer, SNDCHIP_NONE, (uint8)(Instance * CSN76489::CHANNEL_COUNT + ID)),
+	m_iChipChanId(ID)
+{
+	assert(Instance < MAX_SN76489_CHIPS);
+}
+
+void CSN76489Channel::Reset()
+{
+	SetStereo(true, true);
+	SetAttenuation(0xF);
+}
+
+void CSN76489Channel::SetVGMWriter(const CVGMWriterBase *pWrite)
+{
+	m_pVGMWriter = pWrite;
+}
+
+void CSN76489Channel::SetStereo(bool Left, bool Right)
+{
+	m_bLeft = Left;
+	m_bRight = Right;
+}
+
+void CSN76489Channel::SetAttenuation(uint8 Value)
+{
+	Value &= 0xF;
+	if (Value != m_iAttenuation) {
+		if (m_pVGMWriter != nullptr)
+			m_pVGMWriter->WriteReg(0, 0x90 | (m_iChipChanId << 5) | Value);
+		m_iAttenuation = Value;
+	}
+}
+
+int32 CSN76489Channel::GetVolume() const
+{
+	return CSN76489::VOLUME_TABLE[m_iAttenuation];
+}
+
+
+
+CSNSquare::CSNSquare(CMixer *pMixer, int ID, unsigned Instance) :
+	CSN76489Channel(pMixer, Instance, ID)
+{
+}
+
+CSNSquare::~CSNSquare()
+{
+}
+
+void CSNSquare::Reset()
+{
+	CSN76489Channel::Reset();
+	
+	SetPeriodLo(0);
+	SetPeriodHi(0);
+
+	m_iSquareCounter = 0;
+	m_bSqaureActive = true;
+}
+
+void CSNSquare::Process(uint32 Time)
+{
+	uint16 Period = GetPeriod();
+	if (!Period)
+		Period = 1; // or 0x400 according to one of the vgm flags
+
+	if (Time >= m_iSquareCounter) {
+		Time -= m_iSquareCounter;
+		m_iTime += m_iSquareCounter;
+		m_iSquareCounter = Period << 4;
+		m_bSqaureActive = Period > CUTOFF_PERIOD ? !m_bSqaureActive : 0;
+		int32 Vol = m_bSqaureActive ? GetVolume() : 0;
+		Mix(m_bLeft ? Vol : 0, m_bRight ? Vol : 0);
+
+		// // // the remaining half periods only toggle between the current level and silence
+		if (uint32 Count = Time / m_iSquareCounter) {
+			if (Period > CUTOFF_PERIOD) {
+				Vol = GetVolume();
+				m_pMixer->AddToggles(m_iChanId, m_iChip, m_bLeft ? Vol : 0, m_bRight ? Vol : 0,
+					m_iTime + m_iSquareCounter, m_iSquareCounter, Count);
+				if (Count & 1)
+					m_bSqaureActive = !m_bSqaureActive;
+			}
+			Time -= Count * m_iSquareCounter;
+			m_iTime += Count * m_iSquareCounter;
+		}
+	}
+
+	m_iSquareCounter -= Time;
+	m_iTime += Time;
+}
+
+void CSNSquare::SetPeriodLo(uint8 Value)
+{
+	m_iPrevPeriod = GetPeriod();
+	m_iSquarePeriodLo = Value & 0xF;
+}
+
+void CSNSquare::SetPeriodHi(uint8 Value)
+{
+	m_iSquarePeriodHi = Value & 0x3F;
+	FlushPeriod();
+}
+
+void CSNSquare::FlushPeriod() const
+{
+	if (m_pVGMWriter == nullptr)
+		return;
+	uint16 NewPeriod = GetPeriod();
+	if (NewPeriod == m_iPrevPeriod)
+		return;
+	m_pVGMWriter->WriteReg(0, 0x80 | (m_iChipChanId << 5) | m_iSquarePeriodLo);
+	if (m_iSquarePeriodHi != (m_iPrevPeriod >> 4))
+		m_pVGMWriter->WriteReg(0, m_iSquarePeriodHi);
+}
+
+uint16 CSNSquare::GetPeriod() const
+{
+	return m_iSquarePeriodLo | (m_iSquarePeriodHi << 4);
+}
+
+
+
+const uint16 CSNNoise::LFSR_INIT = 0x8000;
+const unsigned CSNNoise::MAX_LFSR_STEPS = 8;		// // //
+
+CSNNoise::CSNNoise(CMixer *pMixer, unsigned Instance) :
+	CSN76489Channel(pMixer, Instance, CHANID_NOISE), m_iCH3Period(0)
+{
+}
+
+CSNNoise::~CSNNoise()
+{
+}
+
+void CSNNoise::Reset()
+{
+	CSN76489Channel::Reset();
+
+	SetControlMode(SN_NOI_DIV_512 | (SN_NOI_FB_LONG << 2));
+
+	m_iSquareCounter = 0;
+	m_bSqaureActive = true;
+}
+
+void CSNNoise::Process(uint32 Time)
+{
+	uint16 Period;
+	switch (m_iNoiseFreq) {
+	case SN_NOI_DIV_512:  Period = 0x10; break;
+	case SN_NOI_DIV_1024: Period = 0x20; break;
+	case SN_NOI_DIV_2048: Period = 0x40; break;
+	case SN_NOI_DIV_CH3:  Period = m_iCH3Period ? m_iCH3Period : 1; break;
+	default: assert(false);
+	}
+	
+	if (Time >= m_iSquareCounter) {		// // //
+		Time -= m_iSquareCounter;
+		m_iTime += m_iSquareCounter;
+		m_iSquareCounter = Period << 4;
+
+		// the LFSR steps on every other counter reload
+		uint32 Count = 1 + Time / m_iSquareCounter;
+		uint32 Steps = (Count + !m_bSqaureActive) / 2;
+		MixSteps(m_bSqaureActive ? m_iTime + m_iSquareCounter : m_iTime, m_iSquareCounter << 1, Steps);
+		if (Count & 1)
+			m_bSqaureActive = !m_bSqaureActive;
+		Time -= (Count - 1) * m_iSquareCounter;
+		m_iTime += (Count - 1) * m_iSquareCounter;
+	}
+
+	m_iSquareCounter -= Time;
+	m_iTime += Time;
+}
+
+void CSNNoise::MixSteps(uint32 Time, uint32 Interval, uint32 Steps)		// // //
+{
+	if (!Steps)
+		return;
+
+	const int32 Vol = GetVolume();
+	const int32 Left = m_bLeft ? Vol : 0;
+	const int32 Right = m_bRight ? Vol : 0;
+
+	// always mix the first step so that the channel level is updated
+	bool Level = StepLFSR(m_iLFSRState, 1, m_iNoiseFeedback) & 1;
+	m_pMixer->AddValue(m_iChanId, m_iChip, Level ? Left : 0, Level ? Right : 0, Time);
+	--Steps;
+
+	// afterwards only the output changes need to be mixed
+	while (Steps) {
+		unsigned n = Steps < MAX_LFSR_STEPS ? Steps : MAX_LFSR_STEPS;
+		unsigned Output = StepLFSR(m_iLFSRState, n, m_iNoiseFeedback);
+		unsigned Edges = Output ^ ((Output << 1) | Level);
+		for (unsigned i = 0; i < n; ++i)
+			if (Edges & (1 << i)) {
+				bool Bit = (Output >> i) & 1;
+				m_pMixer->AddValue(m_iChanId, m_iChip, Bit ? Left : 0, Bit ? Right : 0, Time + (i + 1) * Interval);
+			}
+		Level = (Output >> (n - 1)) & 1;
+		Time += n * Interval;
+		Steps -= n;
+	}
+}
+
+uint8 CSNNoise::StepLFSR(uint16 &State, unsigned Steps, SN_noise_fb_t Mode)		// // //
+{
+	// Advances the LFSR by up to MAX_LFSR_STEPS at once and returns the output
+	// after each step in the lower bits. The outputs are the bits that are
+	// shifted out, and the feedback taps are 3 bits apart, so all new bits
+	// depend only on the current state.
+	assert(Steps > 0 && Steps <= MAX_LFSR_STEPS);
+	const unsigned Mask = (1 << Steps) - 1;
+	unsigned Feedback = State;
+	switch (Mode) {
+	case SN_NOI_FB_SHORT: break;
+	case SN_NOI_FB_LONG:  Feedback ^= State >> 3; break;
+	default: assert(false);
+	}
+	uint8 Output = (State >> 1) & Mask;
+	State = (State >> Steps) | ((Feedback & Mask) << (16 - Steps));
+	return Output;
+}
+
+void CSNNoise::SetControlMode(uint8 Value)
+{
+	Value &= 0x7;
+	m_iNoiseFreq = static_cast<SN_noise_div_t>(Value & 0x03);
+	m_iNoiseFeedback = static_cast<SN_noise_fb_t>(Value & 0x04);
+	m_iLFSRState = LFSR_INIT;
+	if (m_pVGMWriter != nullptr)
+		m_pVGMWriter->WriteReg(0, 0xE0 | Value);
+}
+
+void CSNNoise::CachePeriod(uint16 Period)
+{
+	m_iCH3Period = Period;
+}
+
+
+
+CSN76489::CSN76489(CMixer *pMixer, unsigned Instance) : CExternal(pMixer)		// // //
+{
+	for (int i = CHANID_SQUARE1; i <= CHANID_SQUARE3; ++i)
+		m_pChannels[i] = new CSNSquare(pMixer, i, Instance);
+	m_pChannels[CHANID_NOISE] = new CSNNoise(pMixer, Instance);
+}
+
+CSN76489::~CSN76489()
+{
+	for (auto &x : m_pChannels)
+		delete x;
+}
+
+void CSN76489::Reset()
+{
+	for (auto &x : m_pChannels)
+		x->Reset();
+
+	m_iAddressLatch = 0;
+}
+
+void CSN76489::Process(uint32 Time)
+{
+	for (auto &x : m_pChannels)
+		x->Process(Time);
+}
+
+void CSN76489::EndFrame()
+{
+	for (int i = CHANID_SQUARE1; i <= CHANID_SQUARE3; ++i)
+		GetSquare(i)->FlushPeriod();
+	for (auto &x : m_pChannels)
+		x->EndFrame();
+}
+
+void CSN76489::Write(uint16 Address, uint8 Value)
+{
+	switch (Address) {
+	case 0: case 2: case 4:
+		m_iAddressLatch = (uint8)Address;
+		GetSquare(Address / 2)->SetPeriodLo(Value);
+		break;
+	case 1: case 3: case 5: case 7:
+		GetSquare(m_iAddressLatch / 2)->FlushPeriod();
+		m_pChannels[Address / 2]->SetAttenuation(Value);
+		break;
+	case 6:
+		GetSquare(m_iAddressLatch / 2)->FlushPeriod();
+		GetNoise()->SetControlMode(Value);
+		break;
+	case STEREO_PORT:
+		if (m_pVGMWriter != nullptr)
+			m_pVGMWriter->WriteReg(0, Value, 0x06);
+		for (const auto &x : m_pChannels) {
+			x->SetStereo((Value & 0x10) != 0, (Value & 0x01) != 0);
+			Value >>= 1;
+		}
+		break;
+	default:
+		GetSquare(m_iAddressLatch / 2)->SetPeriodHi(Value);
+		if (m_iAddressLatch / 2 == CHANID_SQUARE3)
+			UpdateNoisePeriod();
+	}
+
+	if (Address / 2 == CHANID_SQUARE3)
+		UpdateNoisePeriod();
+}
+
+uint8 CSN76489::Read(uint16 Address, bool &Mapped)
+{
+	return 0;
+}
+
+void CSN76489::SetVGMWriter(const CVGMWriterBase *pWrite)
+{
+	for (const auto &x : m_pChannels)
+		x->SetVGMWriter(pWrite);
+	m_pVGMWriter = pWrite;
+}
+
+CSNSquare *CSN76489::GetSquare(uint8 ID) const
+{
+	assert(ID <= 2u && m_pChannels[ID] != nullptr);
+	return static_cast<CSNSquare*>(m_pChannels[ID]);
+}
+
+CSNNoise *CSN76489::GetNoise() const
+{
+	assert(m_pChannels[CHANID_NOISE] != nullptr);
+	return static_cast<CSNNoise*>(m_pChannels[CHANID_NOISE]);
+}
+
+void CSN76489::UpdateNoisePeriod() const
+{
+	GetNoise()->CachePeriod(GetSquare(CHANID_SQUARE3)->GetPeriod());
+}
@@ -0,0 +1,180 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "SampleConverter.h"
+#include <cmath>
+#include <cstring>
+#include "StereoReader.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SAMPLE_CONVERTER_X86
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+template <typename T>
+struct sample_traits;
+
+template <>
+struct sample_traits<int16>
+{
+	static float Scale() { return 32768.f; }
+	static float Min() { return -32768.f; }
+	static float Max() { return 32767.f; }
+	static int16 Store(int Value) { return (int16)Value; }
+};
+
+template <>
+struct sample_traits<uint8>
+{
+	static float Scale() { return 128.f; }
+	static float Min() { return -128.f; }
+	static float Max() { return 127.f; }
+	static uint8 Store(int Value) { return (uint8)(Value ^ 0x80); }
+};
+
+// Difference of two uniform values taken from a 32-bit xorshift generator, in LSBs
+const float DITHER_SCALE = 1.f / 65536.f;
+
+inline float NextDither(uint32_t &State)
+{
+	State ^= State << 13;
+	State ^= State >> 17;
+	State ^= State << 5;
+	return (float)((int)(State >> 16) - (int)(State & 0xFFFF)) * DITHER_SCALE;
+}
+
+#ifdef SAMPLE_CONVERTER_X86
+const uint8 BIT_COUNT[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+inline __m128 NextDither(__m128i &State)
+{
+	State = _mm_xor_si128(State, _mm_slli_epi32(State, 13));
+	State = _mm_xor_si128(State, _mm_srli_epi32(State, 17));
+	State = _mm_xor_si128(State, _mm_slli_epi32(State, 5));
+	__m128i Diff = _mm_sub_epi32(_mm_srli_epi32(State, 16), _mm_and_si128(State, _mm_set1_epi32(0xFFFF)));
+	return _mm_mul_ps(_mm_cvtepi32_ps(Diff), _mm_set1_ps(DITHER_SCALE));
+}
+
+inline void Store4(int16 *pOut, __m128i Value)
+{
+	_mm_storel_epi64((__m128i *)pOut, _mm_packs_epi32(Value, Value));
+}
+
+inline void Store4(uint8 *pOut, __m128i Value)
+{
+	__m128i Words = _mm_packs_epi32(Value, Value);
+	int Bytes = _mm_cvtsi128_si32(_mm_xor_si128(_mm_packs_epi16(Words, Words), _mm_set1_epi8((char)0x80)));
+	std::memcpy(pOut, &Bytes, sizeof(Bytes));
+}
+#endif
+
+} // namespace
+
+CSampleConverter::CSampleConverter(uint32 Seed)
+{
+	for (int i = 0; i < LANES; ++i) {
+		m_iDitherState[i] = (Seed + i) * 0x9E3779B9u;
+		if (!m_iDitherState[i])
+			m_iDitherState[i] = 1;
+	}
+}
+
+uint32 CSampleConverter::ToInt16(const float *pIn, int16 *pOut, uint32 Count, bool Dither)
+{
+	return CStereoReader::HasSSE2() ? ToInt16SSE2(pIn, pOut, Count, Dither) : ToInt16Scalar(pIn, pOut, Count, Dither);
+}
+
+uint32 CSampleConverter::ToUInt8(const float *pIn, uint8 *pOut, uint32 Count, bool Dither)
+{
+	return CStereoReader::HasSSE2() ? ToUInt8SSE2(pIn, pOut, Count, Dither) : ToUInt8Scalar(pIn, pOut, Count, Dither);
+}
+
+uint32 CSampleConverter::ToInt16Scalar(const float *pIn, int16 *pOut, uint32 Count, bool Dither)
+{
+	return ConvertScalar(pIn, pOut, Count, Dither);
+}
+
+uint32 CSampleConverter::ToInt16SSE2(const float *pIn, int16 *pOut, uint32 Count, bool Dither)
+{
+	return ConvertSSE2(pIn, pOut, Count, Dither);
+}
+
+uint32 CSampleConverter::ToUInt8Scalar(const float *pIn, uint8 *pOut, uint32 Count, bool Dither)
+{
+	return ConvertScalar(pIn, pOut, Count, Dither);
+}
+
+uint32 CSampleConverter::ToUInt8SSE2(const float *pIn, uint8 *pOut, uint32 Count, bool Dither)
+{
+	return ConvertSSE2(pIn, pOut, Count, Dither);
+}
+
+template <typename T>
+uint32 CSampleConverter::ConvertScalar(const float *pIn, T *pOut, uint32 Count, bool Dither)
+{
+	// Sample i uses the generator of lane i % LANES, as the SIMD path does
+	const float Scale = sample_traits<T>::Scale();
+	const float Min = sample_traits<T>::Min();
+	const float Max = sample_traits<T>::Max();
+
+	uint32 Clips = 0;
+	for (uint32 i = 0; i < Count; ++i) {
+		float Value = pIn[i] * Scale;
+		if (Dither)
+			Value += NextDither(m_iDitherState[i % LANES]);
+		Clips += Value > Max || Value < Min;
+		Value = Value > Min ? Value : Min;		// same as _mm_max_ps and _mm_min_ps
+		Value = Value < Max ? Value : Max;
+		pOut[i] = sample_traits<T>::Store((int)std::lrint(Value));
+	}
+	return Clips;
+}
+
+template <typename T>
+uint32 CSampleConverter::ConvertSSE2(const float *pIn, T *pOut, uint32 Count, bool Dither)
+{
+#ifdef SAMPLE_CONVERTER_X86
+	if (!CStereoReader::HasSSE2())
+#endif
+		return ConvertScalar(pIn, pOut, Count, Dither);
+#ifdef SAMPLE_CONVERTER_X86
+	const __m128 Scale = _mm_set1_ps(sample_traits<T>::Scale());
+	const __m128 Min = _mm_set1_ps(sample_traits<T>::Min());
+	const __m128 Max = _mm_set1_ps(sample_traits<T>::Max());
+	__m128i State = _mm_loadu_si128((const __m128i *)m_iDitherState);
+
+	uint32 Clips = 0;
+	uint32 i = 0;
+	for (; i + LANES <= Count; i += LANES) {
+		__m128 Value = _mm_mul_ps(_mm_loadu_ps(pIn + i), Scale);
+		if (Dither)
+			Value = _mm_add_ps(Value, NextDither(State));
+		Clips += BIT_COUNT[_mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(Value, Max), _mm_cmplt_ps(Value, Min)))];
+		Store4(pOut + i, _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(Value, Min), Max)));
+	}
+
+	_mm_storeu_si128((__m128i *)m_iDitherState, State);
+	return Clips + ConvertScalar(pIn + i, pOut + i, Count - i, Dither);
+#endif
+}
@@ -0,0 +1,58 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include "../Common.h"
+#include <cstdint>
+
+// // // Conversion of the floating point output to integer samples
+
+class CSampleConverter
+{
+public:
+	explicit CSampleConverter(uint32 Seed = 1);
+
+	// Converts Count samples, where 1.0 is full scale, to 16-bit signed or 8-bit unsigned
+	// samples rounded to nearest, optionally adding triangular dither of one LSB before
+	// rounding. Returns the number of samples that were clipped.
+	uint32	ToInt16(const float *pIn, int16 *pOut, uint32 Count, bool Dither);
+	uint32	ToUInt8(const float *pIn, uint8 *pOut, uint32 Count, bool Dither);
+
+	// Implementations used by the above, these give identical results
+	uint32	ToInt16Scalar(const float *pIn, int16 *pOut, uint32 Count, bool Dither);
+	uint32	ToInt16SSE2(const float *pIn, int16 *pOut, uint32 Count, bool Dither);
+	uint32	ToUInt8Scalar(const float *pIn, uint8 *pOut, uint32 Count, bool Dither);
+	uint32	ToUInt8SSE2(const float *pIn, uint8 *pOut, uint32 Count, bool Dither);
+
+private:
+	template <typename T>
+	uint32	ConvertScalar(const float *pIn, T *pOut, uint32 Count, bool Dither);
+	template <typename T>
+	uint32	ConvertSSE2(const float *pIn, T *pOut, uint32 Count, bool Dither);
+
+public:
+	static const int LANES = 4;
+
+private:
+	uint32_t	m_iDitherState[LANES];		// One generator for each SIMD lane
+};
@@ -0,0 +1,190 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "StereoReader.h"
+#include <algorithm>
+#include "../Blip_Buffer/Blip_Buffer.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define STEREO_READER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+const int SAMPLE_SHIFT = blip_sample_bits - 16;
+
+// Full scale of the output, a power of two so that scaling is exact
+const float OUTPUT_SCALE = 1.f / 32768.f;
+
+#ifdef STEREO_READER_X86
+// Integrates two samples from each buffer, returns the sample values as {M0, S0, M1, S1}
+inline __m128i Integrate2(const int32 *pMid, const int32 *pSide, __m128i &Accum, __m128i Bass)
+{
+	__m128i In = _mm_unpacklo_epi32(_mm_loadl_epi64((const __m128i *)pMid), _mm_loadl_epi64((const __m128i *)pSide));
+	__m128i First = _mm_srai_epi32(Accum, SAMPLE_SHIFT);
+	Accum = _mm_add_epi32(Accum, _mm_sub_epi32(In, _mm_sra_epi32(Accum, Bass)));
+	__m128i Second = _mm_srai_epi32(Accum, SAMPLE_SHIFT);
+	Accum = _mm_add_epi32(Accum, _mm_sub_epi32(_mm_srli_si128(In, 8), _mm_sra_epi32(Accum, Bass)));
+	return _mm_unpacklo_epi64(First, Second);
+}
+#endif
+
+} // namespace
+
+void CStereoReader::Read(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+	int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count)
+{
+	typedef void (*read_func_t)(const int32 *, const int32 *, int32 &, int32 &, int, const stereo_matrix_t &, float *, uint32);
+	static const read_func_t Func = HasAVX2() ? ReadAVX2 : HasSSE2() ? ReadSSE2 : ReadScalar;
+	Func(pMid, pSide, AccumMid, AccumSide, BassShift, Matrix, pOut, Count);
+}
+
+void CStereoReader::ReadScalar(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+	int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count)
+{
+	const float LeftMid = Matrix.LeftMid * OUTPUT_SCALE;
+	const float LeftSide = Matrix.LeftSide * OUTPUT_SCALE;
+	const float RightMid = Matrix.RightMid * OUTPUT_SCALE;
+	const float RightSide = Matrix.RightSide * OUTPUT_SCALE;
+	for (uint32 i = 0; i < Count; ++i) {
+		float Mid = (float)(AccumMid >> SAMPLE_SHIFT);
+		float Side = (float)(AccumSide >> SAMPLE_SHIFT);
+		AccumMid += pMid[i] - (AccumMid >> BassShift);
+		AccumSide += pSide[i] - (AccumSide >> BassShift);
+		*pOut++ = Mid * LeftMid + Side * LeftSide;
+		*pOut++ = Mid * RightMid + Side * RightSide;
+	}
+}
+
+void CStereoReader::ReadSSE2(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+	int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count)
+{
+#ifdef STEREO_READER_X86
+	if (sizeof(int32) != 4 || !HasSSE2())
+#endif
+		return ReadScalar(pMid, pSide, AccumMid, AccumSide, BassShift, Matrix, pOut, Count);
+#ifdef STEREO_READER_X86
+	const __m128i Bass = _mm_cvtsi32_si128(BassShift);
+	const __m128 CoefMid = _mm_mul_ps(_mm_setr_ps(Matrix.LeftMid, Matrix.RightMid, Matrix.LeftMid, Matrix.RightMid),
+		_mm_set1_ps(OUTPUT_SCALE));
+	const __m128 CoefSide = _mm_mul_ps(_mm_setr_ps(Matrix.LeftSide, Matrix.RightSide, Matrix.LeftSide, Matrix.RightSide),
+		_mm_set1_ps(OUTPUT_SCALE));
+	__m128i Accum = _mm_setr_epi32(AccumMid, AccumSide, 0, 0);
+
+	uint32 i = 0;
+	for (; i + 2 <= Count; i += 2) {
+		__m128 Samples = _mm_cvtepi32_ps(Integrate2(pMid + i, pSide + i, Accum, Bass));
+		__m128 Mid = _mm_shuffle_ps(Samples, Samples, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 Side = _mm_shuffle_ps(Samples, Samples, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(pOut + i * 2, _mm_add_ps(_mm_mul_ps(Mid, CoefMid), _mm_mul_ps(Side, CoefSide)));
+	}
+
+	AccumMid = _mm_cvtsi128_si32(Accum);
+	AccumSide = _mm_cvtsi128_si32(_mm_srli_si128(Accum, 4));
+	ReadScalar(pMid + i, pSide + i, AccumMid, AccumSide, BassShift, Matrix, pOut + i * 2, Count - i);
+#endif
+}
+
+#ifdef STEREO_READER_X86
+TARGET_AVX2
+#endif
+void CStereoReader::ReadAVX2(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+	int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count)
+{
+#ifdef STEREO_READER_X86
+	if (sizeof(int32) != 4 || !HasAVX2())
+#endif
+		return ReadSSE2(pMid, pSide, AccumMid, AccumSide, BassShift, Matrix, pOut, Count);
+#ifdef STEREO_READER_X86
+	// the integration is sequential, only the conversion works on four samples at once
+	const __m128i Bass = _mm_cvtsi32_si128(BassShift);
+	const __m256 CoefMid = _mm256_mul_ps(_mm256_setr_ps(Matrix.LeftMid, Matrix.RightMid, Matrix.LeftMid, Matrix.RightMid,
+														Matrix.LeftMid, Matrix.RightMid, Matrix.LeftMid, Matrix.RightMid),
+		_mm256_set1_ps(OUTPUT_SCALE));
+	const __m256 CoefSide = _mm256_mul_ps(_mm256_setr_ps(Matrix.LeftSide, Matrix.RightSide, Matrix.LeftSide, Matrix.RightSide,
+														 Matrix.LeftSide, Matrix.RightSide, Matrix.LeftSide, Matrix.RightSide),
+		_mm256_set1_ps(OUTPUT_SCALE));
+	__m128i Accum = _mm_setr_epi32(AccumMid, AccumSide, 0, 0);
+
+	uint32 i = 0;
+	for (; i + 4 <= Count; i += 4) {
+		__m128i First = Integrate2(pMid + i, pSide + i, Accum, Bass);
+		__m128i Second = Integrate2(pMid + i + 2, pSide + i + 2, Accum, Bass);
+		__m256 Samples = _mm256_cvtepi32_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(First), Second, 1));
+		__m256 Mid = _mm256_shuffle_ps(Samples, Samples, _MM_SHUFFLE(2, 2, 0, 0));
+		__m256 Side = _mm256_shuffle_ps(Samples, Samples, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm256_storeu_ps(pOut + i * 2, _mm256_add_ps(_mm256_mul_ps(Mid, CoefMid), _mm256_mul_ps(Side, CoefSide)));
+	}
+
+	AccumMid = _mm_cvtsi128_si32(Accum);
+	AccumSide = _mm_cvtsi128_si32(_mm_srli_si128(Accum, 4));
+	ReadSSE2(pMid + i, pSide + i, AccumMid, AccumSide, BassShift, Matrix, pOut + i * 2, Count - i);
+#endif
+}
+
+bool CStereoReader::HasSSE2()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return true;
+#elif defined(_MSC_VER) && defined(_M_IX86)
+	static const bool SSE2 = [] {
+		int Info[4];
+		__cpuid(Info, 1);
+		return (Info[3] & (1 << 26)) != 0;
+	}();
+	return SSE2;
+#elif defined(STEREO_READER_X86)
+	return __builtin_cpu_supports("sse2") != 0;
+#else
+	return false;
+#endif
+}
+
+bool CStereoReader::HasAVX2()
+{
+#if defined(_MSC_VER) && defined(STEREO_READER_X86)
+	static const bool AVX2 = [] {
+		int Info[4];
+		__cpuid(Info, 0);
+		if (Info[0] < 7)
+			return false;
+		__cpuid(Info, 1);
+		const int OSXSAVE_AVX = (1 << 27) | (1 << 28);
+		if ((Info[2] & OSXSAVE_AVX) != OSXSAVE_AVX || (_xgetbv(0) & 0x6) != 0x6)		// YMM state enabled by the OS
+			return false;
+		__cpuidex(Info, 7, 0);
+		return (Info[1] & (1 << 5)) != 0;
+	}();
+	return AVX2;
+#elif defined(STEREO_READER_X86)
+	return __builtin_cpu_supports("avx2") != 0;
+#else
+	return false;
+#endif
+}
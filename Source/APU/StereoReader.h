@@ -0,0 +1,56 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+#include "../Common.h"
+
+// // // Fused read-out of the mixer's mid and side Blip_Buffers
+
+struct stereo_matrix_t
+{
+	float LeftMid, LeftSide;
+	float RightMid, RightSide;
+};
+
+class CStereoReader
+{
+public:
+	// Integrates Count raw samples from both buffers with the bass high-pass filter,
+	// converts them to left and right with the matrix, then writes the samples to the
+	// interleaved output, where 1.0 is the full scale of 16-bit output. Samples are not
+	// clamped. The accumulators are updated for the next read.
+	static void Read(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+		int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count);
+
+	// Implementations used by Read, these give identical results
+	static void ReadScalar(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+		int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count);
+	static void ReadSSE2(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+		int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count);
+	static void ReadAVX2(const int32 *pMid, const int32 *pSide, int32 &AccumMid, int32 &AccumSide,
+		int BassShift, const stereo_matrix_t &Matrix, float *pOut, uint32 Count);
+
+	static bool HasSSE2();
+	static bool HasAVX2();
+};
@@ -1,40 +1,48 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#pragma once
-
-#include "../Common.h"
-
-const uint8 SNDCHIP_NONE  = 0;
-// // //
-
-enum chan_id_t {
-	CHANID_SQUARE1,
-	CHANID_SQUARE2,
-	CHANID_SQUARE3,
-	CHANID_NOISE,
-	// // //
-	CHANNELS		/* Total number of channels */
-};
-
-enum apu_machine_t {
-	MACHINE_NTSC, 
-	MACHINE_PAL
-};
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include "../Common.h"
+
+const uint8 SNDCHIP_NONE  = 0;
+const uint8 SNDCHIP_SN76489_2 = 1;		// // // Second SN76489
+
+enum chan_id_t {
+	CHANID_SQUARE1,
+	CHANID_SQUARE2,
+	CHANID_SQUARE3,
+	CHANID_NOISE,
+	// // // Second SN76489
+	CHANID_SQUARE1_2,
+	CHANID_SQUARE2_2,
+	CHANID_SQUARE3_2,
+	CHANID_NOISE_2,
+	CHANNELS		/* Total number of channels */
+};
+
+const int SN76489_CHANNELS = CHANID_SQUARE1_2;					// // // Channels of one SN76489 instance
+const unsigned MAX_SN76489_CHIPS = 4;							// // // SN76489 instances one APU can run
+const int MIXER_CHANNELS = SN76489_CHANNELS * MAX_SN76489_CHIPS;	// // // Mixer channels of all instances
+
+enum apu_machine_t {
+	MACHINE_NTSC, 
+	MACHINE_PAL
+};
@@ -0,0 +1,83 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#include "AudioFeeder.h"
+#include "AudioRing.h"
+#include <cstring>
+
+// // // CAudioFeeder
+
+CAudioFeeder::CAudioFeeder() :
+	m_pRing(NULL),
+	m_pChannel(NULL),
+	m_pBlock(NULL),
+	m_cSilence(0),
+	m_bStarved(false)
+{
+}
+
+CAudioFeeder::~CAudioFeeder()
+{
+	delete [] m_pBlock;
+}
+
+void CAudioFeeder::SetOutput(CAudioRing *pRing, CAudioChannel *pChannel)
+{
+	m_pRing = pRing;
+	m_pChannel = pChannel;
+	m_bStarved = false;
+
+	delete [] m_pBlock;
+	m_pBlock = NULL;
+
+	if (m_pChannel != NULL) {
+		m_pBlock = new char[m_pChannel->GetBlockSize()];
+		m_cSilence = (m_pChannel->GetSampleSize() == 8) ? (char)0x80 : 0;
+	}
+}
+
+buffer_event_t CAudioFeeder::Feed(unsigned int Timeout, bool &Underrun)
+{
+	Underrun = false;
+
+	buffer_event_t Event = m_pChannel->WaitForSyncEvent(Timeout);
+	switch (Event) {
+		case BUFFER_IN_SYNC: {
+			const unsigned int Size = m_pChannel->GetBlockSize();
+			unsigned int Read = m_pRing->Read(m_pBlock, Size);
+			if (Read < Size) {
+				memset(m_pBlock + Read, m_cSilence, Size - Read);
+				Underrun = !m_bStarved;
+			}
+			m_bStarved = Read < Size;
+			m_pChannel->WriteBuffer(m_pBlock, Size);
+			break;
+		}
+		case BUFFER_OUT_OF_SYNC:
+			// The device caught up with the feeder
+			Underrun = true;
+			break;
+	}
+
+	return Event;
+}
@@ -0,0 +1,56 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+#include "AudioSink.h"
+
+class CAudioRing;
+
+// // // Device side of audio playback, passes blocks from the audio ring to a channel
+//
+// This does not depend on the platform, CSoundGen runs it on the audio device
+// thread and the unit tests run it against the null sink.
+
+class CAudioFeeder
+{
+public:
+	CAudioFeeder();
+	~CAudioFeeder();
+
+	// Not thread safe, the feeder may not be running
+	void	SetOutput(CAudioRing *pRing, CAudioChannel *pChannel);
+
+	// Waits for the device and passes it one block. The ring running empty is
+	// counted as an underrun and silence is played instead, an underrun lasts
+	// until a full block is available again. Underrun is set when playback fell
+	// behind, either because of the ring or because the device caught up
+	buffer_event_t Feed(unsigned int Timeout, bool &Underrun);
+
+private:
+	CAudioRing		*m_pRing;
+	CAudioChannel	*m_pChannel;
+	char			*m_pBlock;
+	char			m_cSilence;
+	bool			m_bStarved;
+};
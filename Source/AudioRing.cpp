@@ -0,0 +1,109 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "AudioRing.h"
+#include <algorithm>
+#include <cstring>
+
+CAudioRing::CAudioRing() :
+	m_pBuffer(NULL),
+	m_iCapacity(0),
+	m_iWritePos(0),
+	m_iReadPos(0)
+{
+}
+
+CAudioRing::~CAudioRing()
+{
+	delete [] m_pBuffer;
+}
+
+bool CAudioRing::Allocate(unsigned int Size)
+{
+	unsigned int Capacity = 1;
+	while (Capacity < Size) {
+		if (Capacity >= 0x80000000u)
+			return false;
+		Capacity <<= 1;
+	}
+
+	if (Capacity != m_iCapacity) {
+		delete [] m_pBuffer;
+		m_pBuffer = new char[Capacity];
+		m_iCapacity = Capacity;
+	}
+
+	Clear();
+	return true;
+}
+
+void CAudioRing::Clear()
+{
+	m_iWritePos.store(0);
+	m_iReadPos.store(0);
+}
+
+unsigned int CAudioRing::Write(const char *pData, unsigned int Size)
+{
+	const unsigned int Pos = m_iWritePos.load(std::memory_order_relaxed);
+	const unsigned int Fill = Pos - m_iReadPos.load(std::memory_order_acquire);
+	Size = std::min(Size, m_iCapacity - Fill);
+
+	// Copy up to the end of the buffer, then the rest from the start
+	const unsigned int Offset = Pos & (m_iCapacity - 1);
+	const unsigned int First = std::min(Size, m_iCapacity - Offset);
+	memcpy(m_pBuffer + Offset, pData, First);
+	memcpy(m_pBuffer, pData + First, Size - First);
+
+	m_iWritePos.store(Pos + Size, std::memory_order_release);
+	return Size;
+}
+
+unsigned int CAudioRing::GetFree() const
+{
+	return m_iCapacity - GetFill();
+}
+
+unsigned int CAudioRing::Read(char *pData, unsigned int Size)
+{
+	const unsigned int Pos = m_iReadPos.load(std::memory_order_relaxed);
+	const unsigned int Fill = m_iWritePos.load(std::memory_order_acquire) - Pos;
+	Size = std::min(Size, Fill);
+
+	const unsigned int Offset = Pos & (m_iCapacity - 1);
+	const unsigned int First = std::min(Size, m_iCapacity - Offset);
+	memcpy(pData, m_pBuffer + Offset, First);
+	memcpy(pData + First, m_pBuffer, Size - First);
+
+	m_iReadPos.store(Pos + Size, std::memory_order_release);
+	return Size;
+}
+
+unsigned int CAudioRing::GetFill() const
+{
+	return m_iWritePos.load(std::memory_order_acquire) - m_iReadPos.load(std::memory_order_acquire);
+}
+
+unsigned int CAudioRing::GetCapacity() const
+{
+	return m_iCapacity;
+}
@@ -0,0 +1,59 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include <atomic>
+
+// // // Lock-free ring buffer between one producer and one consumer thread
+//
+// The positions only ever increase and wrap around at 2^32, the fill level is
+// their difference. Each side only stores its own position, so no locks are
+// needed as long as there is a single reader and a single writer.
+
+class CAudioRing
+{
+public:
+	CAudioRing();
+	~CAudioRing();
+
+	// Not thread safe, neither side may be running
+	bool	Allocate(unsigned int Size);		// Rounded up to a power of two
+	void	Clear();
+
+	// Producer side, returns the number of bytes written
+	unsigned int Write(const char *pData, unsigned int Size);
+	unsigned int GetFree() const;
+
+	// Consumer side, returns the number of bytes read
+	unsigned int Read(char *pData, unsigned int Size);
+
+	// Either side
+	unsigned int GetFill() const;
+	unsigned int GetCapacity() const;
+
+private:
+	char	*m_pBuffer;
+	unsigned int m_iCapacity;
+	std::atomic<unsigned int> m_iWritePos;
+	std::atomic<unsigned int> m_iReadPos;
+};
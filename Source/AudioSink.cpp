@@ -0,0 +1,85 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "AudioSink.h"
+#include <cstring>
+
+// // // CAudioChannel
+
+CAudioChannel::CAudioChannel() :
+	m_iSampleSize(0),
+	m_iSampleRate(0),
+	m_iChannels(0),
+	m_iBufferLength(0),
+	m_iSoundBufferSize(0),
+	m_iBlocks(0),
+	m_iBlockSize(0)
+{
+}
+
+CAudioChannel::~CAudioChannel()
+{
+}
+
+unsigned int CAudioChannel::GetLatency() const
+{
+	return m_iBufferLength;
+}
+
+void CAudioChannel::SetFormat(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks)
+{
+	// Adjust buffer length in case a buffer would end up in half samples
+	while ((SampleRate * BufferLength / (Blocks * 1000) != (double)SampleRate * BufferLength / (Blocks * 1000)))
+		++BufferLength;
+
+	int SoundBufferSize = CAudioSink::CalculateBufferLength(BufferLength, SampleRate, SampleSize, Channels);
+
+	m_iBufferLength		= BufferLength;				// in ms
+	m_iSoundBufferSize	= SoundBufferSize;			// in bytes
+	m_iBlockSize		= SoundBufferSize / Blocks;	// in bytes
+	m_iBlocks			= Blocks;
+	m_iSampleSize		= SampleSize;
+	m_iSampleRate		= SampleRate;
+	m_iChannels			= Channels;
+}
+
+// // // CAudioSink
+
+CAudioSink::~CAudioSink()
+{
+}
+
+int CAudioSink::MatchDeviceID(const char *Name) const
+{
+	for (unsigned int i = 0; i < GetDeviceCount(); ++i) {
+		if (!strcmp(Name, GetDeviceName(i)))
+			return i;
+	}
+
+	return 0;
+}
+
+int CAudioSink::CalculateBufferLength(int BufferLen, int Samplerate, int Samplesize, int Channels)
+{
+	// Calculate size of the buffer, in bytes
+	return ((Samplerate * BufferLen) / 1000) * (Samplesize / 8) * Channels;
+}
@@ -0,0 +1,115 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+// // // Audio output interface
+//
+// CSoundGen writes blocks of PCM audio to a channel opened on a sink. The
+// channel signals when the device has consumed a block, which paces playback.
+// Nothing in here depends on the platform. The device side of playback
+// (CAudioFeeder) can be run against the null or file sink without an audio
+// device; the player thread in CSoundGen still needs MFC.
+
+// Return values from WaitForSyncEvent()
+enum buffer_event_t {
+	BUFFER_NONE = 0,
+	BUFFER_CUSTOM_EVENT = 1, 
+	BUFFER_TIMEOUT, 
+	BUFFER_IN_SYNC, 
+	BUFFER_OUT_OF_SYNC
+};
+
+// Available sinks, selected with the "Output" setting
+enum audio_sink_t {
+	SINK_DIRECTSOUND,
+	SINK_NULL,
+	SINK_FILE
+};
+
+// Output stream
+class CAudioChannel
+{
+public:
+	CAudioChannel();
+	virtual ~CAudioChannel();
+
+	virtual bool Play() = 0;
+	virtual bool Stop() = 0;
+	virtual bool IsPlaying() const = 0;
+	virtual bool ClearBuffer() = 0;
+	virtual bool WriteBuffer(const char *pBuffer, unsigned int Samples) = 0;
+
+	// Waits until a block can be written, returns early on Interrupt()
+	virtual buffer_event_t WaitForSyncEvent(unsigned int Timeout) = 0;
+	virtual void Interrupt() = 0;
+
+	// Time from writing a block until it is heard, in ms
+	virtual unsigned int GetLatency() const;
+
+	int GetBlockSize() const	{ return m_iBlockSize; };
+	int GetBlockSamples() const	{ return m_iBlockSize >> ((m_iSampleSize >> 3) - 1); };
+	int GetBlocks()	const		{ return m_iBlocks; };
+	int	GetBufferLength() const	{ return m_iBufferLength; };
+	int GetSampleSize()	const	{ return m_iSampleSize;	};
+	int	GetSampleRate()	const	{ return m_iSampleRate;	};
+	int GetChannels() const		{ return m_iChannels; };
+
+protected:
+	void SetFormat(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks);
+
+protected:
+	// Configuration
+	unsigned int	m_iSampleSize;
+	unsigned int	m_iSampleRate;
+	unsigned int	m_iChannels;
+	unsigned int	m_iBufferLength;
+	unsigned int	m_iSoundBufferSize;			// in bytes
+	unsigned int	m_iBlocks;
+	unsigned int	m_iBlockSize;				// in bytes
+};
+
+// Output device
+class CAudioSink
+{
+public:
+	virtual ~CAudioSink();
+
+	virtual bool			SetupDevice(int iDevice) = 0;
+	virtual void			CloseDevice() = 0;
+
+	virtual CAudioChannel	*OpenChannel(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks) = 0;
+	virtual void			CloseChannel(CAudioChannel *pChannel) = 0;
+
+	// Enumeration
+	virtual void			EnumerateDevices() = 0;
+	virtual unsigned int	GetDeviceCount() const = 0;
+	virtual const char		*GetDeviceName(unsigned int iDevice) const = 0;
+	int						MatchDeviceID(const char *Name) const;
+
+	static int				CalculateBufferLength(int BufferLen, int Samplerate, int Samplesize, int Channels);
+
+public:
+	static const unsigned int MAX_BLOCKS = 16;
+	static const unsigned int MAX_SAMPLE_RATE = 96000;
+	static const unsigned int MAX_BUFFER_LENGTH = 10000;
+};
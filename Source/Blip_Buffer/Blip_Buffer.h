@@ -243,6 +243,10 @@ public:
 	// using Blip_Buffer::remove_samples().
 	void end( Blip_Buffer& b )              { b.reader_accum = accum; }
 	
+	// Raw samples and accumulator, for readers that process several samples at once
+	const Blip_Buffer::buf_t_* data() const { return buf; }
+	long& raw_accum()                       { return accum; }
+	
 private:
 	const Blip_Buffer::buf_t_* buf;
 	long accum;
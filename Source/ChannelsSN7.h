@@ -1,89 +1,108 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#pragma once
-
-//
-// Derived channels, SN76489
-//
-
-class CChannelHandlerSN7 : public CChannelHandler {		// // //
-public:
-	CChannelHandlerSN7();
-	virtual void ProcessChannel();
-	virtual void ResetChannel();
-
-	static void SwapChannels(int ID);
-
-protected:
-	virtual void HandleNoteData(stChanNote *pNoteData, int EffColumns);
-	virtual void HandleCustomEffects(int EffNum, int EffParam);
-	virtual bool HandleInstrument(int Instrument, bool Trigger, bool NewInstrument);
-	virtual void HandleEmptyNote();
-	virtual void HandleCut();
-	virtual void HandleRelease();
-	virtual void HandleNote(int Note, int Octave);
-	int CalculateVolume() const override;		// // //
-
-	void SetStereo(bool Left, bool Right) const;
-
-protected:
-	unsigned char m_cSweep;			// Sweep, used by pulse channels
-
-	bool	m_bManualVolume;		// Flag for Exx
-	int		m_iInitVolume;			// Initial volume
-	// // //
-	int		m_iPostEffect;
-	int		m_iPostEffectParam;
-
-	static int m_iRegisterPos[3];		// // //
-	static uint8 m_cStereoFlag;		// // //
-	static uint8 m_cStereoFlagLast;		// // //
-};
-
-// Square 1
-class CSquareChan : public CChannelHandlerSN7 {		// // //
-public:
-	CSquareChan() : CChannelHandlerSN7() { m_iDefaultDuty = 0; };
-	virtual void RefreshChannel();
-protected:
-	virtual void ClearRegisters();
-};
-
-// Noise
-class CNoiseChan : public CChannelHandlerSN7 {
-public:
-	CNoiseChan();
-	virtual void RefreshChannel();
-protected:
-	virtual void HandleCustomEffects(int EffNum, int EffParam);
-	virtual void ClearRegisters();
-	virtual void HandleNote(int Note, int Octave);
-	virtual void SetupSlide(int Type, int EffParam);
-
-	int TriggerNote(int Note);
-
-private:
-	int m_iLastCtrl;		// // //
-	bool m_bNoiseReset;		// // //
-	bool m_bTrigger;		// // // 0CC-FT has this built-in
-};
-
-// // //
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+//
+// Derived channels, SN76489
+//
+
+// // // State shared by the channel handlers of one SN76489 instance
+class CChipHandlerSN7 {
+public:
+	CChipHandlerSN7(unsigned Instance = 0);
+
+	unsigned GetInstance() const;
+
+	void	SwapChannels(int ID);
+	int		GetRegisterPos(int Channel) const;
+	void	ResetRegisterPos(int Channel);
+
+	void	SetStereo(int Channel, bool Left, bool Right);
+	bool	UpdateStereo(uint8 &Value);		// Returns true and the new stereo flags if they have changed
+
+private:
+	unsigned m_iInstance;
+	int		m_iRegisterPos[3];
+	uint8	m_cStereoFlag;
+	uint8	m_cStereoFlagLast;
+};
+
+class CChannelHandlerSN7 : public CChannelHandler {		// // //
+public:
+	CChannelHandlerSN7(CChipHandlerSN7 *pChip);		// // //
+	virtual void ProcessChannel();
+	virtual void ResetChannel();
+
+protected:
+	virtual void HandleNoteData(stChanNote *pNoteData, int EffColumns);
+	virtual void HandleCustomEffects(int EffNum, int EffParam);
+	virtual bool HandleInstrument(int Instrument, bool Trigger, bool NewInstrument);
+	virtual void HandleEmptyNote();
+	virtual void HandleCut();
+	virtual void HandleRelease();
+	virtual void HandleNote(int Note, int Octave);
+	int CalculateVolume() const override;		// // //
+
+	void SetStereo(bool Left, bool Right) const;
+	void WriteChipRegister(uint16 Reg, uint8 Value);		// // // to the SN76489 instance of this channel
+	int  GetChipChannel() const;		// // // index of this channel within its SN76489 instance
+
+protected:
+	unsigned char m_cSweep;			// Sweep, used by pulse channels
+
+	bool	m_bManualVolume;		// Flag for Exx
+	int		m_iInitVolume;			// Initial volume
+	// // //
+	int		m_iPostEffect;
+	int		m_iPostEffectParam;
+
+	CChipHandlerSN7 *m_pChip;		// // //
+};
+
+// Square 1
+class CSquareChan : public CChannelHandlerSN7 {		// // //
+public:
+	CSquareChan(CChipHandlerSN7 *pChip) : CChannelHandlerSN7(pChip) { m_iDefaultDuty = 0; };		// // //
+	virtual void RefreshChannel();
+protected:
+	virtual void ClearRegisters();
+};
+
+// Noise
+class CNoiseChan : public CChannelHandlerSN7 {
+public:
+	CNoiseChan(CChipHandlerSN7 *pChip);		// // //
+	virtual void RefreshChannel();
+protected:
+	virtual void HandleCustomEffects(int EffNum, int EffParam);
+	virtual void ClearRegisters();
+	virtual void HandleNote(int Note, int Octave);
+	virtual void SetupSlide(int Type, int EffParam);
+
+	int TriggerNote(int Note);
+
+private:
+	int m_iLastCtrl;		// // //
+	bool m_bNoiseReset;		// // //
+	bool m_bTrigger;		// // // 0CC-FT has this built-in
+};
+
+// // //
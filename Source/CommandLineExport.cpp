@@ -1,182 +1,328 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include <vector>		// needed for Complier.h > Chunk.h
-#include "stdafx.h"
-#include "FamiTracker.h"
-#include "FamiTrackerDoc.h"
-#include "CommandLineExport.h"
-#include "Compiler.h"
-#include "SoundGen.h"
-#include "TextExporter.h"
-// // //
-
-// Command line export logger
-class CCommandLineLog : public CCompilerLog
-{
-public:
-	CCommandLineLog(CStdioFile *pFile) : m_pFile(pFile) {};
-	void WriteLog(LPCTSTR text) {
-		m_pFile->WriteString(text);
-	};
-	void Clear() {};
-private:
-	CStdioFile *m_pFile;
-};
-
-// Command line export function
-void CCommandLineExport::CommandLineExport(const CString& fileIn, const CString& fileOut, const CString& fileLog)		// // //
-{
-	// open log
-	bool bLog = false;
-	CStdioFile fLog;
-	if (fileLog.GetLength() > 0)
-	{
-		if(fLog.Open(fileLog, CFile::modeCreate | CFile::modeWrite | CFile::typeText, NULL))
-			bLog = true;
-	}
-
-	// create CFamiTrackerDoc for export
-	CRuntimeClass* pRuntimeClass = RUNTIME_CLASS(CFamiTrackerDoc);
-	CObject* pObject = pRuntimeClass->CreateObject();
-	if (pObject == NULL || !pObject->IsKindOf(RUNTIME_CLASS(CFamiTrackerDoc)))
-	{
-		if (bLog) fLog.WriteString(_T("Error: unable to create CFamiTrackerDoc\n"));
-		return;
-	}
-	CFamiTrackerDoc* pExportDoc = static_cast<CFamiTrackerDoc*>(pObject);
-
-	// open file
-	if(!pExportDoc->OnOpenDocument(fileIn))
-	{
-		if (bLog)
-		{
-			fLog.WriteString(_T("Error: unable to open document: "));
-			fLog.WriteString(fileIn);
-			fLog.WriteString(_T("\n"));
-		}
-		return;
-	}
-	if (bLog)
-	{
-		fLog.WriteString(_T("Opened: "));
-		fLog.WriteString(fileIn);
-		fLog.WriteString(_T("\n"));
-	}
-
-	// find extension
-	int nPos = fileOut.ReverseFind(TCHAR('.'));
-	if (nPos < 0)
-	{
-		if (bLog)
-		{
-			fLog.WriteString(_T("Error: export filename has no extension: "));
-			fLog.WriteString(fileOut);
-			fLog.WriteString(_T("\n"));
-		}
-		return;
-	}
-	CString ext = fileOut.Mid(nPos);
-
-	theApp.GetSoundGenerator()->GenerateVibratoTable(pExportDoc->GetVibratoStyle());
-
-	// export
-	if      (0 == ext.CompareNoCase(_T(".nsf")))
-	{
-		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
-		compiler.ExportNSF(fileOut, pExportDoc->GetMachine() );
-		if (bLog)
-		{
-			fLog.WriteString(_T("\nNSF export complete.\n"));
-		}
-		return;
-	}
-	else if (0 == ext.CompareNoCase(_T(".nes")))
-	{
-		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
-		compiler.ExportNES(fileOut, pExportDoc->GetMachine() == PAL);
-		if (bLog)
-		{
-			fLog.WriteString(_T("\nNES export complete.\n"));
-		}
-		return;
-	}
-	// BIN export requires two files
-	else if (0 == ext.CompareNoCase(_T(".bin")))
-	{
-		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
-		compiler.ExportBIN(fileOut);		// // //
-		if (bLog)
-		{
-			fLog.WriteString(_T("\nBIN export complete.\n"));
-		}
-		return;
-	}
-	else if (0 == ext.CompareNoCase(_T(".prg")))
-	{
-		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
-		compiler.ExportPRG(fileOut, pExportDoc->GetMachine() == PAL);
-		if (bLog)
-		{
-			fLog.WriteString(_T("\nPRG export complete.\n"));
-		}
-		return;
-	}
-	else if (0 == ext.CompareNoCase(_T(".asm")))
-	{
-		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
-		compiler.ExportASM(fileOut);
-		if (bLog)
-		{
-			fLog.WriteString(_T("\nASM export complete.\n"));
-		}
-		return;
-	}
-	else if (0 == ext.CompareNoCase(_T(".txt")))
-	{
-		CTextExport textExport;
-		CString result = textExport.ExportFile(fileOut, pExportDoc);
-		if (result.GetLength() > 0)
-		{
-			if (bLog)
-			{
-				fLog.WriteString(_T("Error: "));
-				fLog.WriteString(result);
-				fLog.WriteString(_T("\n"));
-			}
-		}
-		else if (bLog)
-		{
-			fLog.WriteString(_T("Exported: "));
-			fLog.WriteString(fileOut);
-			fLog.WriteString(_T("\n"));
-		}
-		return;
-	}
-	// // //
-
-	if (bLog)
-	{
-		fLog.WriteString(_T("Error: unable to find matching export extension for: "));
-		fLog.WriteString(fileOut);
-		fLog.WriteString(_T("\n"));
-	}
-	return;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include <vector>		// needed for Complier.h > Chunk.h
+#include "stdafx.h"
+#include "FamiTracker.h"
+#include "FamiTrackerDoc.h"
+#include "CommandLineExport.h"
+#include "Compiler.h"
+#include "SoundGen.h"
+#include "TextExporter.h"
+#include "PlayerEngine.h"		// // //
+#include "WaveFile.h"		// // //
+#include "Settings.h"		// // //
+#include "TrackerChannel.h"		// // //
+#include <memory>		// // //
+
+// Command line export logger
+class CCommandLineLog : public CCompilerLog
+{
+public:
+	CCommandLineLog(CStdioFile *pFile) : m_pFile(pFile) {};
+	void WriteLog(LPCTSTR text) {
+		m_pFile->WriteString(text);
+	};
+	void Clear() {};
+private:
+	CStdioFile *m_pFile;
+};
+
+// Command line export function
+void CCommandLineExport::CommandLineExport(const CString& fileIn, const CString& fileOut, const CString& fileLog, bool bStems, bool bFloat, unsigned int Track)		// // //
+{
+	// open log
+	bool bLog = false;
+	CStdioFile fLog;
+	if (fileLog.GetLength() > 0)
+	{
+		if(fLog.Open(fileLog, CFile::modeCreate | CFile::modeWrite | CFile::typeText, NULL))
+			bLog = true;
+	}
+
+	// create CFamiTrackerDoc for export
+	CRuntimeClass* pRuntimeClass = RUNTIME_CLASS(CFamiTrackerDoc);
+	CObject* pObject = pRuntimeClass->CreateObject();
+	if (pObject == NULL || !pObject->IsKindOf(RUNTIME_CLASS(CFamiTrackerDoc)))
+	{
+		if (bLog) fLog.WriteString(_T("Error: unable to create CFamiTrackerDoc\n"));
+		return;
+	}
+	CFamiTrackerDoc* pExportDoc = static_cast<CFamiTrackerDoc*>(pObject);
+
+	// open file
+	if(!pExportDoc->OnOpenDocument(fileIn))
+	{
+		if (bLog)
+		{
+			fLog.WriteString(_T("Error: unable to open document: "));
+			fLog.WriteString(fileIn);
+			fLog.WriteString(_T("\n"));
+		}
+		return;
+	}
+	if (bLog)
+	{
+		fLog.WriteString(_T("Opened: "));
+		fLog.WriteString(fileIn);
+		fLog.WriteString(_T("\n"));
+	}
+
+	// find extension
+	int nPos = fileOut.ReverseFind(TCHAR('.'));
+	if (nPos < 0)
+	{
+		if (bLog)
+		{
+			fLog.WriteString(_T("Error: export filename has no extension: "));
+			fLog.WriteString(fileOut);
+			fLog.WriteString(_T("\n"));
+		}
+		return;
+	}
+	CString ext = fileOut.Mid(nPos);
+
+	theApp.GetSoundGenerator()->GenerateVibratoTable(pExportDoc->GetVibratoStyle());
+
+	// // // only WAV and VGM exports use the track index
+	if ((0 == ext.CompareNoCase(_T(".wav")) || 0 == ext.CompareNoCase(_T(".vgm"))) && Track >= pExportDoc->GetTrackCount())
+	{
+		if (bLog)
+		{
+			CString str;
+			str.Format(_T("Error: track %u does not exist in: "), Track + 1);
+			fLog.WriteString(str);
+			fLog.WriteString(fileIn);
+			fLog.WriteString(_T("\n"));
+		}
+		return;
+	}
+
+	// export
+	if      (0 == ext.CompareNoCase(_T(".nsf")))
+	{
+		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
+		compiler.ExportNSF(fileOut, pExportDoc->GetMachine() );
+		if (bLog)
+		{
+			fLog.WriteString(_T("\nNSF export complete.\n"));
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".nes")))
+	{
+		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
+		compiler.ExportNES(fileOut, pExportDoc->GetMachine() == PAL);
+		if (bLog)
+		{
+			fLog.WriteString(_T("\nNES export complete.\n"));
+		}
+		return;
+	}
+	// BIN export requires two files
+	else if (0 == ext.CompareNoCase(_T(".bin")))
+	{
+		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
+		compiler.ExportBIN(fileOut);		// // //
+		if (bLog)
+		{
+			fLog.WriteString(_T("\nBIN export complete.\n"));
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".prg")))
+	{
+		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
+		compiler.ExportPRG(fileOut, pExportDoc->GetMachine() == PAL);
+		if (bLog)
+		{
+			fLog.WriteString(_T("\nPRG export complete.\n"));
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".asm")))
+	{
+		CCompiler compiler(pExportDoc, bLog ? new CCommandLineLog(&fLog) : NULL);
+		compiler.ExportASM(fileOut);
+		if (bLog)
+		{
+			fLog.WriteString(_T("\nASM export complete.\n"));
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".txt")))
+	{
+		CTextExport textExport;
+		CString result = textExport.ExportFile(fileOut, pExportDoc);
+		if (result.GetLength() > 0)
+		{
+			if (bLog)
+			{
+				fLog.WriteString(_T("Error: "));
+				fLog.WriteString(result);
+				fLog.WriteString(_T("\n"));
+			}
+		}
+		else if (bLog)
+		{
+			fLog.WriteString(_T("Exported: "));
+			fLog.WriteString(fileOut);
+			fLog.WriteString(_T("\n"));
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".wav")))		// // //
+	{
+		// Render offline, without going through the sound thread, with the
+		// resampled high quality output
+		const CSettings *pSettings = theApp.GetSettings();
+		const int SampleRate = pSettings->Sound.iSampleRate;
+
+		const bool FloatRender = bFloat || pSettings->Sound.bFloatRender;		// // // /float or the WAV dialog setting
+
+		// Stems are rendered in the same pass, to "<name> - <channel>.wav" for every
+		// channel of the document
+		const int Stems = bStems ? pExportDoc->GetChannelCount() : 0;		// // // channel types of both chips are contiguous
+
+		CPlayerEngine Engine;
+		CWaveFile WaveFile;
+		if (!Engine.SetStemCount(Stems) || !Engine.Initialize(pExportDoc, SampleRate, true) ||
+			!WaveFile.OpenFile(const_cast<LPTSTR>((LPCTSTR)fileOut), SampleRate, FloatRender ? CWaveFile::FLOAT_SAMPLE_SIZE : 16, 2))
+		{
+			if (bLog)
+			{
+				fLog.WriteString(_T("Error: unable to render to: "));
+				fLog.WriteString(fileOut);
+				fLog.WriteString(_T("\n"));
+			}
+			return;
+		}
+
+		Engine.SetChipLevel(CHIP_LEVEL_SN7L, float(pSettings->ChipLevels.iLevelSN7L / 10.0f));
+		Engine.SetChipLevel(CHIP_LEVEL_SN7R, float(pSettings->ChipLevels.iLevelSN7R / 10.0f));
+		Engine.SetStereoSeparation(float(pSettings->ChipLevels.iLevelSN7Sep / 100.0f));
+		Engine.SetupMixer(pSettings->Sound.iBassFilter, pSettings->Sound.iTrebleFilter, pSettings->Sound.iTrebleDamping, pSettings->Sound.iMixVolume);
+
+		std::vector<CString> stemFiles(Stems);
+		std::unique_ptr<CWaveFile[]> StemWaveFiles(new CWaveFile[Stems]);
+		for (int i = 0; i < pExportDoc->GetChannelCount(); ++i)
+		{
+			const int Stem = pExportDoc->GetChannelType(i);
+			if (Stem >= Stems)
+				continue;
+			const CTrackerChannel *pChannel = pExportDoc->GetChannel(i);
+			stemFiles[Stem].Format(_T("%s - %s%s"), (LPCTSTR)fileOut.Left(nPos),
+				pChannel != NULL ? pChannel->GetChannelName() : _T("Channel"), (LPCTSTR)ext);
+		}
+		for (int i = 0; i < Stems; ++i)
+		{
+			if (stemFiles[i].GetLength() == 0)
+				stemFiles[i].Format(_T("%s - %d%s"), (LPCTSTR)fileOut.Left(nPos), i + 1, (LPCTSTR)ext);
+			if (!StemWaveFiles[i].OpenFile(const_cast<LPTSTR>((LPCTSTR)stemFiles[i]), SampleRate, FloatRender ? CWaveFile::FLOAT_SAMPLE_SIZE : 16, 2))
+			{
+				if (bLog)
+				{
+					fLog.WriteString(_T("Error: unable to render to: "));
+					fLog.WriteString(stemFiles[i]);
+					fLog.WriteString(_T("\n"));
+				}
+				WaveFile.CloseFile();
+				while (i--)
+					StemWaveFiles[i].CloseFile();
+				return;
+			}
+		}
+
+		Engine.StartTrack(Track, SONG_LOOP_LIMIT, 1);		// // //
+
+		const unsigned int BLOCK_SIZE = 4096;
+		if (FloatRender) {
+			std::vector<float> Buffer(BLOCK_SIZE * 2 * (Stems + 1));
+			std::vector<float*> pStemBuffers(Stems);
+			for (int i = 0; i < Stems; ++i)
+				pStemBuffers[i] = Buffer.data() + BLOCK_SIZE * 2 * (i + 1);
+			while (unsigned int Samples = Engine.Render(Buffer.data(), pStemBuffers.data(), BLOCK_SIZE)) {
+				WaveFile.WriteWave(reinterpret_cast<char*>(Buffer.data()), Samples * 2 * sizeof(float));
+				for (int i = 0; i < Stems; ++i)
+					StemWaveFiles[i].WriteWave(reinterpret_cast<char*>(pStemBuffers[i]), Samples * 2 * sizeof(float));
+			}
+		}
+		else {
+			std::vector<int16> Buffer(BLOCK_SIZE * 2 * (Stems + 1));
+			std::vector<int16*> pStemBuffers(Stems);
+			for (int i = 0; i < Stems; ++i)
+				pStemBuffers[i] = Buffer.data() + BLOCK_SIZE * 2 * (i + 1);
+			while (unsigned int Samples = Engine.Render(Buffer.data(), pStemBuffers.data(), BLOCK_SIZE)) {
+				WaveFile.WriteWave(reinterpret_cast<char*>(Buffer.data()), Samples * 2 * sizeof(int16));
+				for (int i = 0; i < Stems; ++i)
+					StemWaveFiles[i].WriteWave(reinterpret_cast<char*>(pStemBuffers[i]), Samples * 2 * sizeof(int16));
+			}
+		}
+		WaveFile.CloseFile();
+		for (int i = 0; i < Stems; ++i)
+			StemWaveFiles[i].CloseFile();
+
+		if (bLog)
+		{
+			fLog.WriteString(_T("Rendered: "));
+			fLog.WriteString(fileOut);
+			fLog.WriteString(_T("\n"));
+			for (int i = 0; i < Stems; ++i)
+			{
+				fLog.WriteString(_T("Rendered: "));
+				fLog.WriteString(stemFiles[i]);
+				fLog.WriteString(_T("\n"));
+			}
+		}
+		return;
+	}
+	else if (0 == ext.CompareNoCase(_T(".vgm")))		// // //
+	{
+		CPlayerEngine Engine;
+		if (!Engine.Initialize(pExportDoc, theApp.GetSettings()->Sound.iSampleRate) ||
+			!Engine.ExportVGM(fileOut, Track))		// // //
+		{
+			if (bLog)
+			{
+				fLog.WriteString(_T("Error: unable to export VGM: "));
+				fLog.WriteString(fileOut);
+				fLog.WriteString(_T("\n"));
+			}
+			return;
+		}
+
+		if (bLog)
+		{
+			fLog.WriteString(_T("Exported: "));
+			fLog.WriteString(fileOut);
+			fLog.WriteString(_T("\n"));
+		}
+		return;
+	}
+	// // //
+
+	if (bLog)
+	{
+		fLog.WriteString(_T("Error: unable to find matching export extension for: "));
+		fLog.WriteString(fileOut);
+		fLog.WriteString(_T("\n"));
+	}
+	return;
+}
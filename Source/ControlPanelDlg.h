@@ -1,50 +1,50 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routin, in whole or in part,
-** must bear this legend.
-*/
-
-#pragma once
-
-
-// CControlPanelDlg dialog
-
-class CControlPanelDlg : public CDialog
-{
-	DECLARE_DYNAMIC(CControlPanelDlg)
-
-public:
-	CControlPanelDlg(CWnd* pParent = NULL);   // standard constructor
-	virtual ~CControlPanelDlg();
-
-	void SetFrameParent(CWnd *pMainFrm = NULL);
-
-// Dialog Data
-	enum { IDD = IDD_MAINFRAME };
-
-protected:
-	virtual void DoDataExchange(CDataExchange* pDX);    // DDX/DDV support
-
-	CWnd *m_pMainFrame;
-
-	DECLARE_MESSAGE_MAP()
-public:
-	virtual BOOL PreTranslateMessage(MSG* pMsg);
-	virtual BOOL OnCmdMsg(UINT nID, int nCode, void* pExtra, AFX_CMDHANDLERINFO* pHandlerInfo);
-protected:
-	virtual BOOL OnNotify(WPARAM wParam, LPARAM lParam, LRESULT* pResult);
-};
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routin, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+
+// CControlPanelDlg dialog
+
+class CControlPanelDlg : public CDialog
+{
+	DECLARE_DYNAMIC(CControlPanelDlg)
+
+public:
+	CControlPanelDlg(CWnd* pParent = NULL);   // standard constructor
+	virtual ~CControlPanelDlg();
+
+	void SetFrameParent(CWnd *pMainFrm = NULL);
+
+// Dialog Data
+	enum { IDD = IDD_MAINFRAME };
+
+protected:
+	virtual void DoDataExchange(CDataExchange* pDX);    // DDX/DDV support
+
+	CWnd *m_pMainFrame;
+
+	DECLARE_MESSAGE_MAP()
+public:
+	virtual BOOL PreTranslateMessage(MSG* pMsg);
+	virtual BOOL OnCmdMsg(UINT nID, int nCode, void* pExtra, AFX_CMDHANDLERINFO* pHandlerInfo);
+protected:
+	virtual BOOL OnNotify(WPARAM wParam, LPARAM lParam, LRESULT* pResult);
+};
@@ -1,220 +1,224 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include "stdafx.h"
-#include "FamiTracker.h"
-#include "FamiTrackerDoc.h"
-#include "FamiTrackerView.h"
-#include "MainFrm.h"
-#include "SoundGen.h"
-#include "TrackerChannel.h"
-#include "WavProgressDlg.h"
-#include "CreateWaveDlg.h"
-
-const int MAX_LOOP_TIMES = 99;
-const int MAX_PLAY_TIME	 = (99 * 60) + 0;
-
-// CCreateWaveDlg dialog
-
-IMPLEMENT_DYNAMIC(CCreateWaveDlg, CDialog)
-
-CCreateWaveDlg::CCreateWaveDlg(CWnd* pParent /*=NULL*/)
-	: CDialog(CCreateWaveDlg::IDD, pParent)
-{
-}
-
-CCreateWaveDlg::~CCreateWaveDlg()
-{
-}
-
-void CCreateWaveDlg::DoDataExchange(CDataExchange* pDX)
-{
-	CDialog::DoDataExchange(pDX);
-}
-
-
-BEGIN_MESSAGE_MAP(CCreateWaveDlg, CDialog)
-	ON_BN_CLICKED(IDC_BEGIN, &CCreateWaveDlg::OnBnClickedBegin)
-	ON_NOTIFY(UDN_DELTAPOS, IDC_SPIN_LOOP, &CCreateWaveDlg::OnDeltaposSpinLoop)
-	ON_NOTIFY(UDN_DELTAPOS, IDC_SPIN_TIME, &CCreateWaveDlg::OnDeltaposSpinTime)
-END_MESSAGE_MAP()
-
-int CCreateWaveDlg::GetFrameLoopCount() const
-{
-	int Frames = GetDlgItemInt(IDC_TIMES);
-
-	if (Frames < 1)
-		Frames = 1;
-	if (Frames > MAX_LOOP_TIMES)
-		Frames = MAX_LOOP_TIMES;
-
-	return Frames;
-}
-
-int CCreateWaveDlg::GetTimeLimit() const
-{
-	int Minutes, Seconds;
-	TCHAR str[256];
-
-	GetDlgItemText(IDC_SECONDS, str, 256);
-	_stscanf(str, _T("%u:%u"), &Minutes, &Seconds);
-	int Time = (Minutes * 60) + (Seconds % 60);
-
-	if (Time < 1)
-		Time = 1;
-	if (Time > MAX_PLAY_TIME)
-		Time = MAX_PLAY_TIME;
-
-	return Time;
-}
-
-// CCreateWaveDlg message handlers
-
-void CCreateWaveDlg::OnBnClickedBegin()
-{
-	render_end_t EndType = SONG_TIME_LIMIT;
-	int EndParam = 0;
-
-	CFamiTrackerDoc *pDoc = CFamiTrackerDoc::GetDoc();
-	CFamiTrackerView *pView = CFamiTrackerView::GetView();
-
-	CString FileName = pDoc->GetFileTitle();
-
-	int Track = m_ctlTracks.GetCurSel();
-
-	if (pDoc->GetTrackCount() > 1) {
-		FileName.AppendFormat(_T(" - Track %02i (%s)"), Track + 1, pDoc->GetTrackTitle(Track).GetBuffer());
-	}
-
-	CWavProgressDlg ProgressDlg;
-	CString fileFilter = LoadDefaultFilter(IDS_FILTER_WAV, _T(".wav"));	
-	CFileDialog SaveDialog(FALSE, _T("wav"), FileName, OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT, fileFilter);
-
-	// Close this dialog
-	EndDialog(0);
-
-	// Ask for file location
-	if (SaveDialog.DoModal() == IDCANCEL)
-		return;
-	
-	// Save
-	if (IsDlgButtonChecked(IDC_RADIO_LOOP)) {
-		EndType = SONG_LOOP_LIMIT;
-		EndParam = GetFrameLoopCount();
-	}
-	else if (IsDlgButtonChecked(IDC_RADIO_TIME)) {
-		EndType = SONG_TIME_LIMIT;
-		EndParam = GetTimeLimit();
-	}
-
-	pView->UnmuteAllChannels();
-
-	// Mute selected channels
-	for (int i = 0; i < m_ctlChannelList.GetCount(); ++i) {
-		if (m_ctlChannelList.GetCheck(i) == 0)
-			pView->ToggleChannel(i);
-	}
-
-	// Show the render progress dialog, this will also start rendering
-	ProgressDlg.BeginRender(SaveDialog.GetPathName(), EndType, EndParam, Track);
-
-	// Unmute all channels
-	pView->UnmuteAllChannels();
-}
-
-BOOL CCreateWaveDlg::OnInitDialog()
-{
-	CheckDlgButton(IDC_RADIO_LOOP, BST_CHECKED);
-	CheckDlgButton(IDC_RADIO_TIME, BST_UNCHECKED);
-
-	SetDlgItemText(IDC_TIMES, _T("1"));
-	SetDlgItemText(IDC_SECONDS, _T("01:00"));
-
-	m_ctlChannelList.SubclassDlgItem(IDC_CHANNELS, this);
-
-	m_ctlChannelList.ResetContent();
-	m_ctlChannelList.SetCheckStyle(BS_AUTOCHECKBOX);
-
-	m_ctlTracks.SubclassDlgItem(IDC_TRACKS, this);
-
-	CFamiTrackerDoc *pDoc = CFamiTrackerDoc::GetDoc();
-
-	int ChannelCount = pDoc->GetAvailableChannels();
-	for (int i = 0; i < ChannelCount; ++i) {
-		m_ctlChannelList.AddString(pDoc->GetChannel(i)->GetChannelName());
-		m_ctlChannelList.SetCheck(i, 1);
-	}
-
-	for (unsigned int i = 0; i < pDoc->GetTrackCount(); ++i) {
-		CString text;
-		text.Format(_T("#%02i - "), i + 1);
-		text.Append(pDoc->GetTrackTitle(i));
-		m_ctlTracks.AddString(text);
-	}
-
-	CMainFrame *pMainFrm = static_cast<CMainFrame*>(theApp.GetMainWnd());
-	m_ctlTracks.SetCurSel(pMainFrm->GetSelectedTrack());
-
-	return TRUE;  // return TRUE unless you set the focus to a control
-	// EXCEPTION: OCX Property Pages should return FALSE
-}
-
-void CCreateWaveDlg::ShowDialog()
-{
-	CDialog::DoModal();
-}
-
-void CCreateWaveDlg::OnDeltaposSpinLoop(NMHDR *pNMHDR, LRESULT *pResult)
-{
-	LPNMUPDOWN pNMUpDown = reinterpret_cast<LPNMUPDOWN>(pNMHDR);
-	int Times = GetFrameLoopCount() - pNMUpDown->iDelta;
-
-	if (Times < 1)
-		Times = 1;
-	if (Times > MAX_LOOP_TIMES)
-		Times = MAX_LOOP_TIMES;
-
-	SetDlgItemInt(IDC_TIMES, Times);
-	CheckDlgButton(IDC_RADIO_LOOP, BST_CHECKED);
-	CheckDlgButton(IDC_RADIO_TIME, BST_UNCHECKED);
-	*pResult = 0;
-}
-
-void CCreateWaveDlg::OnDeltaposSpinTime(NMHDR *pNMHDR, LRESULT *pResult)
-{
-	LPNMUPDOWN pNMUpDown = reinterpret_cast<LPNMUPDOWN>(pNMHDR);
-	int Minutes, Seconds;
-	int Time = GetTimeLimit() - pNMUpDown->iDelta;
-	CString str;
-
-	if (Time < 1)
-		Time = 1;
-	if (Time > MAX_PLAY_TIME)
-		Time = MAX_PLAY_TIME;
-
-	Seconds = Time % 60;
-	Minutes = Time / 60;
-
-	str.Format(_T("%02i:%02i"), Minutes, Seconds);
-	SetDlgItemText(IDC_SECONDS, str);
-	CheckDlgButton(IDC_RADIO_LOOP, BST_UNCHECKED);
-	CheckDlgButton(IDC_RADIO_TIME, BST_CHECKED);
-	*pResult = 0;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "stdafx.h"
+#include "FamiTracker.h"
+#include "FamiTrackerDoc.h"
+#include "FamiTrackerView.h"
+#include "MainFrm.h"
+#include "SoundGen.h"
+#include "Settings.h"		// // //
+#include "TrackerChannel.h"
+#include "WavProgressDlg.h"
+#include "CreateWaveDlg.h"
+
+const int MAX_LOOP_TIMES = 99;
+const int MAX_PLAY_TIME	 = (99 * 60) + 0;
+
+// CCreateWaveDlg dialog
+
+IMPLEMENT_DYNAMIC(CCreateWaveDlg, CDialog)
+
+CCreateWaveDlg::CCreateWaveDlg(CWnd* pParent /*=NULL*/)
+	: CDialog(CCreateWaveDlg::IDD, pParent)
+{
+}
+
+CCreateWaveDlg::~CCreateWaveDlg()
+{
+}
+
+void CCreateWaveDlg::DoDataExchange(CDataExchange* pDX)
+{
+	CDialog::DoDataExchange(pDX);
+}
+
+
+BEGIN_MESSAGE_MAP(CCreateWaveDlg, CDialog)
+	ON_BN_CLICKED(IDC_BEGIN, &CCreateWaveDlg::OnBnClickedBegin)
+	ON_NOTIFY(UDN_DELTAPOS, IDC_SPIN_LOOP, &CCreateWaveDlg::OnDeltaposSpinLoop)
+	ON_NOTIFY(UDN_DELTAPOS, IDC_SPIN_TIME, &CCreateWaveDlg::OnDeltaposSpinTime)
+END_MESSAGE_MAP()
+
+int CCreateWaveDlg::GetFrameLoopCount() const
+{
+	int Frames = GetDlgItemInt(IDC_TIMES);
+
+	if (Frames < 1)
+		Frames = 1;
+	if (Frames > MAX_LOOP_TIMES)
+		Frames = MAX_LOOP_TIMES;
+
+	return Frames;
+}
+
+int CCreateWaveDlg::GetTimeLimit() const
+{
+	int Minutes, Seconds;
+	TCHAR str[256];
+
+	GetDlgItemText(IDC_SECONDS, str, 256);
+	_stscanf(str, _T("%u:%u"), &Minutes, &Seconds);
+	int Time = (Minutes * 60) + (Seconds % 60);
+
+	if (Time < 1)
+		Time = 1;
+	if (Time > MAX_PLAY_TIME)
+		Time = MAX_PLAY_TIME;
+
+	return Time;
+}
+
+// CCreateWaveDlg message handlers
+
+void CCreateWaveDlg::OnBnClickedBegin()
+{
+	render_end_t EndType = SONG_TIME_LIMIT;
+	int EndParam = 0;
+
+	CFamiTrackerDoc *pDoc = CFamiTrackerDoc::GetDoc();
+	CFamiTrackerView *pView = CFamiTrackerView::GetView();
+
+	CString FileName = pDoc->GetFileTitle();
+
+	int Track = m_ctlTracks.GetCurSel();
+
+	if (pDoc->GetTrackCount() > 1) {
+		FileName.AppendFormat(_T(" - Track %02i (%s)"), Track + 1, pDoc->GetTrackTitle(Track).GetBuffer());
+	}
+
+	CWavProgressDlg ProgressDlg;
+	CString fileFilter = LoadDefaultFilter(IDS_FILTER_WAV, _T(".wav"));	
+	CFileDialog SaveDialog(FALSE, _T("wav"), FileName, OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT, fileFilter);
+
+	// Close this dialog
+	EndDialog(0);
+
+	// Ask for file location
+	if (SaveDialog.DoModal() == IDCANCEL)
+		return;
+	
+	// Save
+	if (IsDlgButtonChecked(IDC_RADIO_LOOP)) {
+		EndType = SONG_LOOP_LIMIT;
+		EndParam = GetFrameLoopCount();
+	}
+	else if (IsDlgButtonChecked(IDC_RADIO_TIME)) {
+		EndType = SONG_TIME_LIMIT;
+		EndParam = GetTimeLimit();
+	}
+
+	theApp.GetSettings()->Sound.bFloatRender = IsDlgButtonChecked(IDC_FLOAT_RENDER) != 0;		// // //
+
+	pView->UnmuteAllChannels();
+
+	// Mute selected channels
+	for (int i = 0; i < m_ctlChannelList.GetCount(); ++i) {
+		if (m_ctlChannelList.GetCheck(i) == 0)
+			pView->ToggleChannel(i);
+	}
+
+	// Show the render progress dialog, this will also start rendering
+	ProgressDlg.BeginRender(SaveDialog.GetPathName(), EndType, EndParam, Track);
+
+	// Unmute all channels
+	pView->UnmuteAllChannels();
+}
+
+BOOL CCreateWaveDlg::OnInitDialog()
+{
+	CheckDlgButton(IDC_RADIO_LOOP, BST_CHECKED);
+	CheckDlgButton(IDC_RADIO_TIME, BST_UNCHECKED);
+
+	SetDlgItemText(IDC_TIMES, _T("1"));
+	SetDlgItemText(IDC_SECONDS, _T("01:00"));
+	CheckDlgButton(IDC_FLOAT_RENDER, theApp.GetSettings()->Sound.bFloatRender ? BST_CHECKED : BST_UNCHECKED);		// // //
+
+	m_ctlChannelList.SubclassDlgItem(IDC_CHANNELS, this);
+
+	m_ctlChannelList.ResetContent();
+	m_ctlChannelList.SetCheckStyle(BS_AUTOCHECKBOX);
+
+	m_ctlTracks.SubclassDlgItem(IDC_TRACKS, this);
+
+	CFamiTrackerDoc *pDoc = CFamiTrackerDoc::GetDoc();
+
+	int ChannelCount = pDoc->GetAvailableChannels();
+	for (int i = 0; i < ChannelCount; ++i) {
+		m_ctlChannelList.AddString(pDoc->GetChannel(i)->GetChannelName());
+		m_ctlChannelList.SetCheck(i, 1);
+	}
+
+	for (unsigned int i = 0; i < pDoc->GetTrackCount(); ++i) {
+		CString text;
+		text.Format(_T("#%02i - "), i + 1);
+		text.Append(pDoc->GetTrackTitle(i));
+		m_ctlTracks.AddString(text);
+	}
+
+	CMainFrame *pMainFrm = static_cast<CMainFrame*>(theApp.GetMainWnd());
+	m_ctlTracks.SetCurSel(pMainFrm->GetSelectedTrack());
+
+	return TRUE;  // return TRUE unless you set the focus to a control
+	// EXCEPTION: OCX Property Pages should return FALSE
+}
+
+void CCreateWaveDlg::ShowDialog()
+{
+	CDialog::DoModal();
+}
+
+void CCreateWaveDlg::OnDeltaposSpinLoop(NMHDR *pNMHDR, LRESULT *pResult)
+{
+	LPNMUPDOWN pNMUpDown = reinterpret_cast<LPNMUPDOWN>(pNMHDR);
+	int Times = GetFrameLoopCount() - pNMUpDown->iDelta;
+
+	if (Times < 1)
+		Times = 1;
+	if (Times > MAX_LOOP_TIMES)
+		Times = MAX_LOOP_TIMES;
+
+	SetDlgItemInt(IDC_TIMES, Times);
+	CheckDlgButton(IDC_RADIO_LOOP, BST_CHECKED);
+	CheckDlgButton(IDC_RADIO_TIME, BST_UNCHECKED);
+	*pResult = 0;
+}
+
+void CCreateWaveDlg::OnDeltaposSpinTime(NMHDR *pNMHDR, LRESULT *pResult)
+{
+	LPNMUPDOWN pNMUpDown = reinterpret_cast<LPNMUPDOWN>(pNMHDR);
+	int Minutes, Seconds;
+	int Time = GetTimeLimit() - pNMUpDown->iDelta;
+	CString str;
+
+	if (Time < 1)
+		Time = 1;
+	if (Time > MAX_PLAY_TIME)
+		Time = MAX_PLAY_TIME;
+
+	Seconds = Time % 60;
+	Minutes = Time / 60;
+
+	str.Format(_T("%02i:%02i"), Minutes, Seconds);
+	SetDlgItemText(IDC_SECONDS, str);
+	CheckDlgButton(IDC_RADIO_LOOP, BST_UNCHECKED);
+	CheckDlgButton(IDC_RADIO_TIME, BST_CHECKED);
+	*pResult = 0;
+}
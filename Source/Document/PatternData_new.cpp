@@ -1,109 +1,273 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** SnevenTracker is (C) HertzDevil 2016
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include "PatternData_new.h"
-#include "PatternNote.h"
-#include <stdexcept>
-
-using namespace FTExt;
-
-
-
-const size_t CPatternData::MAX_SIZE = MAX_PATTERN_LENGTH;
-
-
-
-CPatternData::CPatternData(size_t MaxSize) :
-	m_pNotes(MaxSize),
-	m_iActualSize {MaxSize}
-{
-	if (m_iActualSize > MAX_SIZE)
-		throw std::runtime_error {"Pattern is too large"};
-}
-
-CPatternData &CPatternData::operator=(CPatternData other)
-{
-	swap(*this, other);
-	return *this;
-}
-
-void FTExt::swap(CPatternData &a, CPatternData &b)
-{
-	std::swap(a.m_iActualSize, b.m_iActualSize);
-	a.m_pNotes.swap(b.m_pNotes);
-}
-
-
-
-CPatternNote CPatternData::GetNote(size_t Row) const
-{
-	return m_pNotes[Row];
-}
-
-void CPatternData::SetNote(size_t Row, const CPatternNote &Note)
-{
-	m_pNotes[Row] = Note;
-}
-
-
-
-size_t CPatternData::GetSize() const
-{
-	return m_iActualSize;
-}
-
-void CPatternData::SetSize(size_t Size)
-{
-	if (Size > MAX_SIZE)
-		throw std::runtime_error {"Pattern size beyond limit"};
-	m_iActualSize = Size;
-}
-
-
-
-bool CPatternData::IsEmpty() const
-{
-	for (size_t i = 0u; i < m_iActualSize; ++i)
-		if (m_pNotes[i])
-			return false;
-	return true;
-}
-
-void CPatternData::Clear()
-{
-	for (auto &x : m_pNotes)
-		x.Reset();
-}
-
-
-
-typename std::vector<FTExt::CPatternNote>::iterator
-CPatternData::begin()
-{
-	return m_pNotes.begin();
-}
-
-typename std::vector<FTExt::CPatternNote>::iterator
-CPatternData::end()
-{
-	return begin() + m_iActualSize;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "PatternData_new.h"
+#include "PatternNote.h"
+#include <stdexcept>
+#include <algorithm>
+
+using namespace FTExt;
+
+
+
+const size_t CPatternData::MAX_SIZE = MAX_PATTERN_LENGTH;
+
+namespace {
+const size_t FNV_OFFSET = 2166136261u;
+} // namespace
+
+
+
+CPatternData::CNoteBlock::CNoteBlock(size_t Size) :
+	Notes(Size)
+{
+}
+
+
+
+CPatternData::CPatternData(size_t MaxSize) :
+	m_pNotes(std::make_shared<CNoteBlock>(MaxSize)),
+	m_iActualSize {MaxSize}
+{
+	if (m_iActualSize > MAX_SIZE)
+		throw std::runtime_error {"Pattern is too large"};
+}
+
+CPatternData &CPatternData::operator=(CPatternData other)
+{
+	swap(*this, other);
+	return *this;
+}
+
+void FTExt::swap(CPatternData &a, CPatternData &b)
+{
+	std::swap(a.m_iActualSize, b.m_iActualSize);
+	std::swap(a.m_iHash, b.m_iHash);
+	std::swap(a.m_bHashValid, b.m_bHashValid);
+	a.m_pNotes.swap(b.m_pNotes);
+}
+
+
+
+bool CPatternData::operator==(const CPatternData &other) const
+{
+	if (m_iActualSize != other.m_iActualSize)
+		return false;
+	if (m_pNotes == other.m_pNotes)
+		return true;
+	if (GetHash() != other.GetHash())
+		return false;
+	// Equal patterns have the same blank rows
+	const auto End = GetUsedEnd();
+	const auto &Rows = m_pNotes->UsedRows;
+	if (End - Rows.cbegin() != other.GetUsedEnd() - other.m_pNotes->UsedRows.cbegin())
+		return false;
+	return std::equal(Rows.cbegin(), End, other.m_pNotes->UsedRows.cbegin(), [&] (uint16_t a, uint16_t b) {
+		return a == b && m_pNotes->Notes[a] == other.m_pNotes->Notes[b];
+	});
+}
+
+bool CPatternData::operator!=(const CPatternData &other) const
+{
+	return !(*this == other);
+}
+
+size_t CPatternData::GetHash() const
+{
+	// FNV-1a over the non-blank rows within the pattern size
+	if (!m_bHashValid) {
+		size_t Hash = FNV_OFFSET;
+		const auto Add = [&Hash] (uint8_t x) { Hash = (Hash ^ x) * 16777619u; };
+		for (auto it = m_pNotes->UsedRows.cbegin(), End = GetUsedEnd(); it != End; ++it) {
+			const CPatternNote &Note = m_pNotes->Notes[*it];
+			Add(static_cast<uint8_t>(*it));
+			Add(Note.Note);
+			Add(Note.Octave);
+			Add(Note.Inst);
+			Add(Note.Vol);
+			for (const auto &Cmd : Note.Effect) {
+				Add(Cmd.Index);
+				Add(Cmd.Param);
+			}
+		}
+		m_iHash = Hash ^ m_iActualSize;
+		m_bHashValid = true;
+	}
+	return m_iHash;
+}
+
+size_t CPatternData::GetBlankHash(size_t Size)
+{
+	return FNV_OFFSET ^ Size;
+}
+
+bool CPatternData::ShareData(const CPatternData &other)
+{
+	if (SharesDataWith(other))
+		return true;
+	if (*this != other || m_pNotes->Notes != other.m_pNotes->Notes)
+		return false;
+	m_pNotes = other.m_pNotes;
+	return true;
+}
+
+bool CPatternData::SharesDataWith(const CPatternData &other) const
+{
+	return m_pNotes == other.m_pNotes;
+}
+
+
+
+CPatternNote CPatternData::GetNote(size_t Row) const
+{
+	return Row < m_pNotes->Notes.size() ? m_pNotes->Notes[Row] : CPatternNote::BLANK;
+}
+
+void CPatternData::SetNote(size_t Row, const CPatternNote &Note)
+{
+	if (GetNote(Row) == Note)		// do not unshare for nothing
+		return;
+	if (Row >= MAX_SIZE)
+		throw std::runtime_error {"Pattern row out of bounds"};
+	auto &Data = GetUniqueData();
+	if (Row >= Data.Notes.size())
+		Data.Notes.resize(Row + 1);
+	Data.Notes[Row] = Note;
+
+	// Keep the index of non-blank rows up to date
+	const bool Used = Note != CPatternNote::BLANK;
+	if (Data.UsedMask[Row] != Used) {
+		Data.UsedMask[Row] = Used;
+		const auto it = std::lower_bound(Data.UsedRows.begin(), Data.UsedRows.end(), Row);
+		if (Used)
+			Data.UsedRows.insert(it, static_cast<uint16_t>(Row));
+		else
+			Data.UsedRows.erase(it);
+	}
+}
+
+
+
+size_t CPatternData::GetSize() const
+{
+	return m_iActualSize;
+}
+
+void CPatternData::SetSize(size_t Size)
+{
+	if (Size > MAX_SIZE)
+		throw std::runtime_error {"Pattern size beyond limit"};
+	if (Size > m_pNotes->Notes.size())
+		GetUniqueData().Notes.resize(Size);
+	m_iActualSize = Size;
+	m_bHashValid = false;
+}
+
+void CPatternData::ShrinkToSize()
+{
+	if (m_pNotes->Notes.size() > m_iActualSize) {
+		auto pBlock = std::make_shared<CNoteBlock>(0u);
+		pBlock->Notes.assign(begin(), end());
+		pBlock->UsedRows.assign(m_pNotes->UsedRows.cbegin(), GetUsedEnd());
+		for (const auto Row : pBlock->UsedRows)
+			pBlock->UsedMask.set(Row);
+		m_pNotes = std::move(pBlock);
+	}
+}
+
+void CPatternData::ShrinkToFit()
+{
+	const auto &Rows = m_pNotes->UsedRows;
+	const size_t Size = std::max(m_iActualSize, Rows.empty() ? size_t(0) : size_t(Rows.back()) + 1);
+	if (m_pNotes->Notes.size() > Size) {
+		auto pBlock = std::make_shared<CNoteBlock>(*m_pNotes);
+		pBlock->Notes.resize(Size);
+		pBlock->Notes.shrink_to_fit();
+		m_pNotes = std::move(pBlock);
+	}
+}
+
+
+
+bool CPatternData::IsEmpty() const
+{
+	return std::none_of(m_pNotes->UsedRows.cbegin(), GetUsedEnd(), [this] (uint16_t Row) {
+		return static_cast<bool>(m_pNotes->Notes[Row]);
+	});
+}
+
+void CPatternData::Clear()
+{
+	m_pNotes = std::make_shared<CNoteBlock>(m_pNotes->Notes.size());
+	m_bHashValid = false;
+}
+
+
+
+bool CPatternData::IsRowBlank(size_t Row) const
+{
+	return Row >= MAX_SIZE || !m_pNotes->UsedMask[Row];
+}
+
+size_t CPatternData::GetNoteCount() const
+{
+	return GetUsedEnd() - m_pNotes->UsedRows.cbegin();
+}
+
+size_t CPatternData::FindNextNote(size_t Row) const
+{
+	const auto &Rows = m_pNotes->UsedRows;
+	const auto it = std::lower_bound(Rows.cbegin(), Rows.cend(), Row);
+	return it != Rows.cend() ? *it : MAX_SIZE;
+}
+
+
+
+CPatternData::CNoteBlock &CPatternData::GetUniqueData()
+{
+	// Rows are only written through this, the hash has to be recomputed
+	if (m_pNotes.use_count() > 1)
+		m_pNotes = std::make_shared<CNoteBlock>(*m_pNotes);
+	m_bHashValid = false;
+	return *m_pNotes;
+}
+
+std::vector<uint16_t>::const_iterator CPatternData::GetUsedEnd() const
+{
+	// Non-blank rows beyond the pattern size are indexed but not counted
+	const auto &Rows = m_pNotes->UsedRows;
+	return std::lower_bound(Rows.cbegin(), Rows.cend(), m_iActualSize);
+}
+
+
+
+typename std::vector<FTExt::CPatternNote>::const_iterator
+CPatternData::begin() const
+{
+	return m_pNotes->Notes.cbegin();
+}
+
+typename std::vector<FTExt::CPatternNote>::const_iterator
+CPatternData::end() const
+{
+	return begin() + m_iActualSize;
+}
@@ -1,62 +1,105 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** SnevenTracker is (C) HertzDevil 2016
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-
-#pragma once
-
-#include <vector>
-#include "PatternNote.h"
-
-namespace FTExt {
-
-class CPatternData
-{
-public:
-	explicit CPatternData(size_t MaxSize = MAX_SIZE);
-	~CPatternData() = default;
-
-	CPatternData(const CPatternData &other) = default;
-	CPatternData(CPatternData &&other) = default;
-	CPatternData &operator=(CPatternData other);
-	friend void swap(CPatternData &a, CPatternData &b);
-
-	CPatternNote GetNote(size_t Row) const;
-	void SetNote(size_t Row, const CPatternNote &Note);
-
-	size_t GetSize() const;
-	void SetSize(size_t Size);
-
-	bool IsEmpty() const;
-	void Clear();
-
-	typename std::vector<CPatternNote>::iterator begin();
-	typename std::vector<CPatternNote>::iterator end();
-
-public:
-	static const size_t MAX_SIZE;
-
-private:
-	std::vector<CPatternNote> m_pNotes;
-	size_t m_iActualSize = 0u;
-};
-
-} // namespace FTExt
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <bitset>
+#include <cstdint>
+#include "PatternNote.h"
+
+namespace FTExt {
+
+// Patterns share their rows until one of them is modified, copying a
+// pattern is therefore cheap; the rows that are not blank are indexed so
+// that mostly empty patterns can be scanned without visiting every row
+class CPatternData
+{
+public:
+	explicit CPatternData(size_t MaxSize = MAX_SIZE);
+	~CPatternData() = default;
+
+	CPatternData(const CPatternData &other) = default;
+	CPatternData(CPatternData &&other) = default;
+	CPatternData &operator=(CPatternData other);
+	friend void swap(CPatternData &a, CPatternData &b);
+
+	// Shared or unequally hashed patterns are compared without visiting the rows
+	bool operator==(const CPatternData &other) const;
+	bool operator!=(const CPatternData &other) const;
+	size_t GetHash() const;
+	// Hash of a pattern of the given size without any notes
+	static size_t GetBlankHash(size_t Size);
+
+	// Shares the rows of an identical pattern, including rows beyond the size
+	bool ShareData(const CPatternData &other);
+	bool SharesDataWith(const CPatternData &other) const;
+
+	// Rows beyond the pattern size are kept until the pattern is shrunk,
+	// rows that were never written read as blank; ShrinkToFit only drops the
+	// blank rows at the end
+	CPatternNote GetNote(size_t Row) const;
+	void SetNote(size_t Row, const CPatternNote &Note);
+
+	size_t GetSize() const;
+	void SetSize(size_t Size);
+	void ShrinkToSize();
+	void ShrinkToFit();
+
+	bool IsEmpty() const;
+	void Clear();
+
+	// Blank rows are those equal to CPatternNote::BLANK
+	bool IsRowBlank(size_t Row) const;
+	size_t GetNoteCount() const;
+	// Returns the first row at or after Row that is not blank, including rows
+	// beyond the pattern size, or MAX_SIZE if there is none
+	size_t FindNextNote(size_t Row) const;
+
+	typename std::vector<CPatternNote>::const_iterator begin() const;
+	typename std::vector<CPatternNote>::const_iterator end() const;
+
+public:
+	static const size_t MAX_SIZE;
+
+private:
+	struct CNoteBlock
+	{
+		explicit CNoteBlock(size_t Size);
+		std::vector<CPatternNote> Notes;
+		std::vector<uint16_t> UsedRows;		// sorted
+		std::bitset<MAX_PATTERN_LENGTH> UsedMask;
+	};
+
+	CNoteBlock &GetUniqueData();
+	std::vector<uint16_t>::const_iterator GetUsedEnd() const;
+
+private:
+	std::shared_ptr<CNoteBlock> m_pNotes;
+	size_t m_iActualSize = 0u;
+	mutable size_t m_iHash = 0u;
+	mutable bool m_bHashValid = false;
+};
+
+} // namespace FTExt
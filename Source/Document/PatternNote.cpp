@@ -1,47 +1,62 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** SnevenTracker is (C) HertzDevil 2016
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include "PatternNote.h"
-#include <cstring>
-
-using namespace FTExt;
-
-
-
-const CPatternNote CPatternNote::BLANK = CPatternNote { };
-
-
-
-void CPatternNote::Reset()
-{
-	*this = CPatternNote { };
-}
-
-CPatternNote::operator bool() const
-{
-	if (Note != 0 || Inst != MAX_INSTRUMENTS || Vol != MAX_VOLUME)
-		return true;
-	for (const auto &x : Effect)
-		if (x.Name)
-			return true;
-	return false;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "PatternNote.h"
+#include <cstring>
+
+using namespace FTExt;
+
+
+
+const CPatternNote CPatternNote::BLANK = CPatternNote { };
+
+
+
+void CPatternNote::Reset()
+{
+	*this = CPatternNote { };
+}
+
+CPatternNote::operator bool() const
+{
+	if (Note != 0 || Inst != MAX_INSTRUMENTS || Vol != MAX_VOLUME)
+		return true;
+	for (const auto &x : Effect)
+		if (x.Index)
+			return true;
+	return false;
+}
+
+bool CPatternNote::operator==(const CPatternNote &other) const
+{
+	if (Note != other.Note || Octave != other.Octave || Inst != other.Inst || Vol != other.Vol)
+		return false;
+	for (int i = 0; i < MAX_EFFECT_COLUMNS; ++i)
+		if (Effect[i].Index != other.Effect[i].Index || Effect[i].Param != other.Effect[i].Param)
+			return false;
+	return true;
+}
+
+bool CPatternNote::operator!=(const CPatternNote &other) const
+{
+	return !(*this == other);
+}
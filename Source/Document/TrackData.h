@@ -1,61 +1,68 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** SnevenTracker is (C) HertzDevil 2016
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-
-#pragma once
-
-#include "../FamiTrackerTypes.h"
-#include "../Utility/GenCollection.h"
-#include <vector>
-
-namespace FTExt {
-
-class CPatternData;
-
-class CTrackData {
-public:
-	CTrackData() = default;
-
-	const CPatternData *GetPattern(size_t Index) const;
-	CPatternData *GetPattern(size_t Index);
-	CPatternData *NewPattern(size_t Index, size_t Size);
-
-	const CPatternData *GetPatternAtFrame(size_t Frame) const;
-	CPatternData *GetPatternAtFrame(size_t Frame);
-/* do not allow each track to have its own number of frames yet, too many things will break
-	size_t GetTrackLength() const;
-	void SetTrackLength(size_t Size);
-*/
-	size_t GetPatternIndex(size_t Frame) const;
-	void SetPatternIndex(size_t Frame, size_t Index);
-
-	int GetEffectColumnCount() const;
-	void SetEffectColumnCount(int Count);
-
-private:
-	CGenCollection<CPatternData, MAX_PATTERN> m_pPatterns;
-	std::vector<size_t> m_iFrameList = std::vector<size_t>(MAX_PATTERN);
-//	size_t m_iLength = 1u;
-	int m_iEffectColumnCount = 1;
-};
-
-} // namespace FTExt
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+#include "../FamiTrackerTypes.h"
+#include "../Utility/GenCollection.h"
+#include <vector>
+
+namespace FTExt {
+
+class CPatternData;
+
+class CTrackData {
+public:
+	CTrackData() = default;
+
+	const CPatternData *GetPattern(size_t Index) const;
+	CPatternData *GetPattern(size_t Index);
+	CPatternData *NewPattern(size_t Index, size_t Size);
+
+	// Whole-pattern operations work on the pattern objects instead of rows
+	void ClearPattern(size_t Index);
+	void CopyPattern(size_t Target, size_t Source);
+	void SwapPatterns(size_t A, size_t B);
+	CPatternData *ReleasePattern(size_t Index);
+	void ReplacePattern(size_t Index, CPatternData *pPattern);
+
+	const CPatternData *GetPatternAtFrame(size_t Frame) const;
+	CPatternData *GetPatternAtFrame(size_t Frame);
+/* do not allow each track to have its own number of frames yet, too many things will break
+	size_t GetTrackLength() const;
+	void SetTrackLength(size_t Size);
+*/
+	size_t GetPatternIndex(size_t Frame) const;
+	void SetPatternIndex(size_t Frame, size_t Index);
+
+	int GetEffectColumnCount() const;
+	void SetEffectColumnCount(int Count);
+
+private:
+	CGenCollection<CPatternData, MAX_PATTERN> m_pPatterns;
+	std::vector<size_t> m_iFrameList = std::vector<size_t>(MAX_FRAMES);
+//	size_t m_iLength = 1u;
+	int m_iEffectColumnCount = 1;
+};
+
+} // namespace FTExt
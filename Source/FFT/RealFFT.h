@@ -0,0 +1,177 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define REAL_FFT_SSE
+#include <xmmintrin.h>
+#endif
+
+// // // Fast Fourier transform of real input, the size is fixed at compile time
+//
+// The windowed samples are packed into a complex transform of half the size,
+// whose result is then split into the spectrum of the real signal. The Hann
+// window, bit reversal and twiddle tables are computed once per object.
+
+template <unsigned int Points>
+class CRealFFT
+{
+	static_assert(Points >= 16 && (Points & (Points - 1)) == 0, "FFT size must be a power of two");
+
+public:
+	static const unsigned int BINS = Points / 2;
+
+	CRealFFT();
+
+	// Windows and transforms Points samples
+	void Transform(const short *pSamples);
+
+	// Magnitude of a frequency bin, scaled by 1 / sqrt(Points)
+	float GetIntensity(unsigned int Bin) const { return m_fMagnitude[Bin]; }
+	const float *GetMagnitudes() const { return m_fMagnitude; }
+
+	int GetFrequency(unsigned int Bin, int SampleRate) const { return SampleRate * Bin / Points; }
+
+private:
+	void Butterflies();
+
+private:
+	static const unsigned int HALF = Points / 2;	// Size of the complex transform
+
+	float m_fWindow[Points];
+	unsigned int m_iBitRev[HALF];
+	float m_fTwiddleRe[HALF];						// Butterflies of span S use entries S to 2S - 1
+	float m_fTwiddleIm[HALF];
+	float m_fSplitRe[HALF];							// exp(-2 pi i k / Points)
+	float m_fSplitIm[HALF];
+	float m_fRe[HALF];
+	float m_fIm[HALF];
+	float m_fMagnitude[BINS];
+};
+
+template <unsigned int Points>
+CRealFFT<Points>::CRealFFT()
+{
+	const double PI = 3.14159265358979323846;
+
+	for (unsigned int i = 0; i < Points; ++i)
+		m_fWindow[i] = (float)(0.5 * (1.0 - cos(2.0 * PI * i / (Points - 1))));
+
+	unsigned int Bits = 0;
+	while ((1u << Bits) < HALF)
+		++Bits;
+	for (unsigned int i = 0; i < HALF; ++i) {
+		unsigned int Rev = 0;
+		for (unsigned int b = 0; b < Bits; ++b)
+			Rev |= ((i >> b) & 1) << (Bits - 1 - b);
+		m_iBitRev[i] = Rev;
+	}
+
+	m_fTwiddleRe[0] = 1.0f;
+	m_fTwiddleIm[0] = 0.0f;
+	for (unsigned int Span = 1; Span < HALF; Span <<= 1)
+		for (unsigned int j = 0; j < Span; ++j) {
+			m_fTwiddleRe[Span + j] = (float)cos(-PI * j / Span);
+			m_fTwiddleIm[Span + j] = (float)sin(-PI * j / Span);
+		}
+
+	for (unsigned int k = 0; k < HALF; ++k) {
+		m_fSplitRe[k] = (float)cos(-2.0 * PI * k / Points);
+		m_fSplitIm[k] = (float)sin(-2.0 * PI * k / Points);
+	}
+
+	for (unsigned int k = 0; k < BINS; ++k)
+		m_fMagnitude[k] = 0.0f;
+}
+
+template <unsigned int Points>
+void CRealFFT<Points>::Transform(const short *pSamples)
+{
+	// Even samples go to the real part and odd samples to the imaginary part
+	for (unsigned int k = 0; k < HALF; ++k) {
+		const unsigned int Pos = m_iBitRev[k];
+		m_fRe[Pos] = pSamples[2 * k] * m_fWindow[2 * k];
+		m_fIm[Pos] = pSamples[2 * k + 1] * m_fWindow[2 * k + 1];
+	}
+
+	Butterflies();
+
+	// Split into the spectrum of the real input, X[k] = E[k] + exp(-2 pi i k / N) O[k]
+	// with E[k] = (Z[k] + Z*[N/2 - k]) / 2 and O[k] = -i (Z[k] - Z*[N/2 - k]) / 2
+	const float Scale = 0.5f / sqrtf((float)Points);
+
+	m_fMagnitude[0] = fabsf(m_fRe[0] + m_fIm[0]) * 2.0f * Scale;
+	for (unsigned int k = 1; k < HALF; ++k) {
+		const float SumRe = m_fRe[k] + m_fRe[HALF - k];
+		const float SumIm = m_fIm[k] - m_fIm[HALF - k];
+		const float DiffRe = m_fRe[k] - m_fRe[HALF - k];
+		const float DiffIm = m_fIm[k] + m_fIm[HALF - k];
+		const float Re = SumRe + m_fSplitRe[k] * DiffIm + m_fSplitIm[k] * DiffRe;
+		const float Im = SumIm + m_fSplitIm[k] * DiffIm - m_fSplitRe[k] * DiffRe;
+		m_fMagnitude[k] = sqrtf(Re * Re + Im * Im) * Scale;
+	}
+}
+
+template <unsigned int Points>
+void CRealFFT<Points>::Butterflies()
+{
+	// Radix-2 decimation in time on bit reversed input, four butterflies at a
+	// time once the span is wide enough
+	for (unsigned int Span = 1; Span < HALF; Span <<= 1) {
+		const float *pWRe = m_fTwiddleRe + Span;
+		const float *pWIm = m_fTwiddleIm + Span;
+		for (unsigned int Start = 0; Start < HALF; Start += Span * 2) {
+			float *pARe = m_fRe + Start;
+			float *pAIm = m_fIm + Start;
+			float *pBRe = pARe + Span;
+			float *pBIm = pAIm + Span;
+			unsigned int j = 0;
+#ifdef REAL_FFT_SSE
+			for (; j + 4 <= Span; j += 4) {
+				const __m128 WRe = _mm_loadu_ps(pWRe + j);
+				const __m128 WIm = _mm_loadu_ps(pWIm + j);
+				const __m128 BRe = _mm_loadu_ps(pBRe + j);
+				const __m128 BIm = _mm_loadu_ps(pBIm + j);
+				const __m128 ARe = _mm_loadu_ps(pARe + j);
+				const __m128 AIm = _mm_loadu_ps(pAIm + j);
+				const __m128 TRe = _mm_sub_ps(_mm_mul_ps(WRe, BRe), _mm_mul_ps(WIm, BIm));
+				const __m128 TIm = _mm_add_ps(_mm_mul_ps(WRe, BIm), _mm_mul_ps(WIm, BRe));
+				_mm_storeu_ps(pBRe + j, _mm_sub_ps(ARe, TRe));
+				_mm_storeu_ps(pBIm + j, _mm_sub_ps(AIm, TIm));
+				_mm_storeu_ps(pARe + j, _mm_add_ps(ARe, TRe));
+				_mm_storeu_ps(pAIm + j, _mm_add_ps(AIm, TIm));
+			}
+#endif
+			for (; j < Span; ++j) {
+				const float TRe = pWRe[j] * pBRe[j] - pWIm[j] * pBIm[j];
+				const float TIm = pWRe[j] * pBIm[j] + pWIm[j] * pBRe[j];
+				pBRe[j] = pARe[j] - TRe;
+				pBIm[j] = pAIm[j] - TIm;
+				pARe[j] += TRe;
+				pAIm[j] += TIm;
+			}
+		}
+	}
+}
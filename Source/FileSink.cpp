@@ -0,0 +1,171 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "FileSink.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+static const char PIPE_MODE[] = "wb";
+#else
+static const char PIPE_MODE[] = "w";
+#endif
+
+// // // CFileChannel
+
+CFileChannel::CFileChannel(FILE *pFile) :
+	m_pFile(pFile),
+	m_bPlaying(false),
+	m_bInterrupt(false)
+{
+}
+
+bool CFileChannel::Play()
+{
+	m_bPlaying = true;
+	return true;
+}
+
+bool CFileChannel::Stop()
+{
+	m_bPlaying = false;
+	return true;
+}
+
+bool CFileChannel::IsPlaying() const
+{
+	return m_bPlaying;
+}
+
+bool CFileChannel::ClearBuffer()
+{
+	// Nothing is buffered besides the stream itself
+	fflush(m_pFile);
+	return Stop();
+}
+
+bool CFileChannel::WriteBuffer(const char *pBuffer, unsigned int Samples)
+{
+	return fwrite(pBuffer, 1, Samples, m_pFile) == Samples;
+}
+
+buffer_event_t CFileChannel::WaitForSyncEvent(unsigned int Timeout)
+{
+	// The next block can always be written, writes block when a pipe is full
+	if (!IsPlaying())
+		Play();
+
+	if (m_bInterrupt.exchange(false))
+		return BUFFER_CUSTOM_EVENT;
+
+	return ferror(m_pFile) ? BUFFER_NONE : BUFFER_IN_SYNC;
+}
+
+void CFileChannel::Interrupt()
+{
+	m_bInterrupt = true;
+}
+
+unsigned int CFileChannel::GetLatency() const
+{
+	return 0;
+}
+
+// // // CFileSink
+
+CFileSink::CFileSink(const char *pPath) :
+	m_sPath(pPath),
+	m_pFile(NULL),
+	m_bPipe(false)
+{
+}
+
+CFileSink::~CFileSink()
+{
+	CloseDevice();
+}
+
+bool CFileSink::SetupDevice(int iDevice)
+{
+	// The stream is kept open while the device is reset, so that output continues
+	if (m_pFile != NULL)
+		return true;
+
+	if (m_sPath == "-")
+		m_pFile = stdout;
+	else if (!m_sPath.empty() && m_sPath[0] == '|') {
+		m_pFile = popen(m_sPath.c_str() + 1, PIPE_MODE);
+		m_bPipe = true;
+	}
+	else
+		m_pFile = fopen(m_sPath.c_str(), "wb");
+
+	return m_pFile != NULL;
+}
+
+void CFileSink::CloseDevice()
+{
+	if (m_pFile == NULL)
+		return;
+
+	if (m_bPipe)
+		pclose(m_pFile);
+	else if (m_pFile != stdout)
+		fclose(m_pFile);
+	else
+		fflush(m_pFile);
+
+	m_pFile = NULL;
+	m_bPipe = false;
+}
+
+CAudioChannel *CFileSink::OpenChannel(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks)
+{
+	if (m_pFile == NULL)
+		return NULL;
+
+	CFileChannel *pChannel = new CFileChannel(m_pFile);
+	pChannel->SetFormat(SampleRate, SampleSize, Channels, BufferLength, Blocks);
+	return pChannel;
+}
+
+void CFileSink::CloseChannel(CAudioChannel *pChannel)
+{
+	if (m_pFile != NULL)
+		fflush(m_pFile);
+
+	delete pChannel;
+}
+
+void CFileSink::EnumerateDevices()
+{
+}
+
+unsigned int CFileSink::GetDeviceCount() const
+{
+	return 1;
+}
+
+const char *CFileSink::GetDeviceName(unsigned int iDevice) const
+{
+	return m_sPath.c_str();
+}
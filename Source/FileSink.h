@@ -0,0 +1,80 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include "AudioSink.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+// // // Audio sink writing raw interleaved PCM to a file, standard output ("-")
+// or the input of another program ("|command")
+//
+// Blocks are accepted as soon as they are written, so playback runs as fast as
+// the file can be written or as the reading end of the pipe allows.
+
+class CFileChannel : public CAudioChannel
+{
+	friend class CFileSink;
+
+public:
+	CFileChannel(FILE *pFile);
+
+	bool Play();
+	bool Stop();
+	bool IsPlaying() const;
+	bool ClearBuffer();
+	bool WriteBuffer(const char *pBuffer, unsigned int Samples);
+
+	buffer_event_t WaitForSyncEvent(unsigned int Timeout);
+	void Interrupt();
+
+	unsigned int GetLatency() const;
+
+private:
+	FILE				*m_pFile;
+	bool				m_bPlaying;
+	std::atomic<bool>	m_bInterrupt;
+};
+
+class CFileSink : public CAudioSink
+{
+public:
+	CFileSink(const char *pPath);
+	~CFileSink();
+
+	bool			SetupDevice(int iDevice);
+	void			CloseDevice();
+
+	CAudioChannel	*OpenChannel(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks);
+	void			CloseChannel(CAudioChannel *pChannel);
+
+	void			EnumerateDevices();
+	unsigned int	GetDeviceCount() const;
+	const char		*GetDeviceName(unsigned int iDevice) const;
+
+private:
+	std::string		m_sPath;
+	FILE			*m_pFile;
+	bool			m_bPipe;
+};
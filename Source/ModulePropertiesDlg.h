@@ -1,65 +1,65 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#pragma once
-
-
-// CModulePropertiesDlg dialog
-
-class CModulePropertiesDlg : public CDialog
-{
-	DECLARE_DYNAMIC(CModulePropertiesDlg)
-
-private:
-	void SelectSong(int Song);
-	void UpdateSongButtons();
-	
-	unsigned int m_iSelectedSong;
-
-	CFamiTrackerDoc *m_pDocument;
-
-public:
-	CModulePropertiesDlg(CWnd* pParent = NULL);   // standard constructor
-	virtual ~CModulePropertiesDlg();
-
-// Dialog Data
-	enum { IDD = IDD_PROPERTIES };
-
-protected:
-	virtual void DoDataExchange(CDataExchange* pDX);    // DDX/DDV support
-
-	void FillSongList();
-
-	DECLARE_MESSAGE_MAP()
-public:
-	virtual BOOL OnInitDialog();
-	afx_msg void OnBnClickedOk();
-	afx_msg void OnBnClickedSongAdd();
-	afx_msg void OnBnClickedSongRemove();
-	afx_msg void OnBnClickedSongUp();
-	afx_msg void OnBnClickedSongDown();
-	afx_msg void OnEnChangeSongname();
-	afx_msg void OnClickSongList(NMHDR *pNMHDR, LRESULT *pResult);
-	afx_msg void OnBnClickedSongImport();
-	afx_msg void OnCbnSelchangeExpansion();
-	afx_msg void OnHScroll(UINT nSBCode, UINT nPos, CScrollBar* pScrollBar);
-	afx_msg void OnLvnItemchangedSonglist(NMHDR *pNMHDR, LRESULT *pResult);
-	virtual BOOL PreTranslateMessage(MSG* pMsg);
-};
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+
+// CModulePropertiesDlg dialog
+
+class CModulePropertiesDlg : public CDialog
+{
+	DECLARE_DYNAMIC(CModulePropertiesDlg)
+
+private:
+	void SelectSong(int Song);
+	void UpdateSongButtons();
+	
+	unsigned int m_iSelectedSong;
+
+	CFamiTrackerDoc *m_pDocument;
+
+public:
+	CModulePropertiesDlg(CWnd* pParent = NULL);   // standard constructor
+	virtual ~CModulePropertiesDlg();
+
+// Dialog Data
+	enum { IDD = IDD_PROPERTIES };
+
+protected:
+	virtual void DoDataExchange(CDataExchange* pDX);    // DDX/DDV support
+
+	void FillSongList();
+
+	DECLARE_MESSAGE_MAP()
+public:
+	virtual BOOL OnInitDialog();
+	afx_msg void OnBnClickedOk();
+	afx_msg void OnBnClickedSongAdd();
+	afx_msg void OnBnClickedSongRemove();
+	afx_msg void OnBnClickedSongUp();
+	afx_msg void OnBnClickedSongDown();
+	afx_msg void OnEnChangeSongname();
+	afx_msg void OnClickSongList(NMHDR *pNMHDR, LRESULT *pResult);
+	afx_msg void OnBnClickedSongImport();
+	afx_msg void OnCbnSelchangeExpansion();
+	afx_msg void OnHScroll(UINT nSBCode, UINT nPos, CScrollBar* pScrollBar);
+	afx_msg void OnLvnItemchangedSonglist(NMHDR *pNMHDR, LRESULT *pResult);
+	virtual BOOL PreTranslateMessage(MSG* pMsg);
+};
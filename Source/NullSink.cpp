@@ -0,0 +1,182 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "NullSink.h"
+#include <algorithm>
+
+// // // CAudioClock
+
+CAudioClock::~CAudioClock()
+{
+}
+
+std::chrono::nanoseconds CSteadyClock::Now() const
+{
+	return std::chrono::steady_clock::now().time_since_epoch();
+}
+
+void CSteadyClock::WaitUntil(std::unique_lock<std::mutex> &Lock, std::condition_variable &Wake, std::chrono::nanoseconds Time)
+{
+	Wake.wait_until(Lock, std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(Time)));
+}
+
+// // // CNullChannel
+
+CNullChannel::CNullChannel(CAudioClock &Clock) :
+	m_Clock(Clock),
+	m_bPlaying(false),
+	m_bInterrupt(false),
+	m_iBlocksPlayed(0)
+{
+}
+
+bool CNullChannel::Play()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (!m_bPlaying) {
+		m_bPlaying = true;
+		m_Start = m_Clock.Now();
+		m_iBlocksPlayed = 0;
+	}
+	return true;
+}
+
+bool CNullChannel::Stop()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_bPlaying = false;
+	return true;
+}
+
+bool CNullChannel::IsPlaying() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_bPlaying;
+}
+
+bool CNullChannel::ClearBuffer()
+{
+	return Stop();
+}
+
+bool CNullChannel::WriteBuffer(const char *pBuffer, unsigned int Samples)
+{
+	// Audio is discarded
+	return Samples == m_iBlockSize;
+}
+
+buffer_event_t CNullChannel::WaitForSyncEvent(unsigned int Timeout)
+{
+	// Returns once for every block that the simulated device has played. When
+	// the caller falls a whole buffer behind the device position has wrapped
+	// around, skip ahead and report it like DirectSound would
+
+	if (!IsPlaying())
+		Play();
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	const std::chrono::nanoseconds Limit = m_Clock.Now() + std::chrono::milliseconds(Timeout);
+	const std::chrono::nanoseconds Next = GetBlockTime(m_iBlocksPlayed + 1);
+
+	while (!m_bInterrupt) {
+		std::chrono::nanoseconds Now = m_Clock.Now();
+		if (Now >= Next)
+			break;
+		if (Now >= Limit)
+			return BUFFER_TIMEOUT;
+		m_Clock.WaitUntil(lock, m_Wake, std::min(Next, Limit));
+	}
+
+	if (m_bInterrupt) {
+		m_bInterrupt = false;
+		return BUFFER_CUSTOM_EVENT;
+	}
+
+	++m_iBlocksPlayed;
+
+	unsigned long long Blocks = m_iBlocksPlayed;
+	while (GetBlockTime(Blocks + 1) <= m_Clock.Now())
+		++Blocks;
+	if (Blocks - m_iBlocksPlayed >= m_iBlocks) {
+		m_iBlocksPlayed = Blocks;
+		return BUFFER_OUT_OF_SYNC;
+	}
+
+	return BUFFER_IN_SYNC;
+}
+
+void CNullChannel::Interrupt()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_bInterrupt = true;
+	m_Wake.notify_one();
+}
+
+std::chrono::nanoseconds CNullChannel::GetBlockTime(unsigned long long Block) const
+{
+	// Time at which a number of blocks have been played
+	const unsigned long long BytesPerSecond = m_iSampleRate * m_iChannels * (m_iSampleSize / 8);
+	return m_Start + std::chrono::nanoseconds(Block * m_iBlockSize * 1000000000ULL / BytesPerSecond);
+}
+
+// // // CNullSink
+
+CNullSink::CNullSink(CAudioClock *pClock) :
+	m_pClock(pClock != NULL ? pClock : &m_SteadyClock)
+{
+}
+
+bool CNullSink::SetupDevice(int iDevice)
+{
+	return true;
+}
+
+void CNullSink::CloseDevice()
+{
+}
+
+CAudioChannel *CNullSink::OpenChannel(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks)
+{
+	CNullChannel *pChannel = new CNullChannel(*m_pClock);
+	pChannel->SetFormat(SampleRate, SampleSize, Channels, BufferLength, Blocks);
+	return pChannel;
+}
+
+void CNullSink::CloseChannel(CAudioChannel *pChannel)
+{
+	delete pChannel;
+}
+
+void CNullSink::EnumerateDevices()
+{
+}
+
+unsigned int CNullSink::GetDeviceCount() const
+{
+	return 1;
+}
+
+const char *CNullSink::GetDeviceName(unsigned int iDevice) const
+{
+	return "Null output";
+}
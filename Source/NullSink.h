@@ -0,0 +1,98 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include "AudioSink.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+// // // Audio sink without a device, consumes blocks at the rate a sound card would
+
+// Time source of the null sink, tests substitute a clock that they advance themselves
+class CAudioClock
+{
+public:
+	virtual ~CAudioClock();
+
+	virtual std::chrono::nanoseconds Now() const = 0;
+	// Blocks until Time or until Wake is notified, the lock is held on return
+	virtual void WaitUntil(std::unique_lock<std::mutex> &Lock, std::condition_variable &Wake, std::chrono::nanoseconds Time) = 0;
+};
+
+class CSteadyClock : public CAudioClock
+{
+public:
+	std::chrono::nanoseconds Now() const;
+	void WaitUntil(std::unique_lock<std::mutex> &Lock, std::condition_variable &Wake, std::chrono::nanoseconds Time);
+};
+
+class CNullChannel : public CAudioChannel
+{
+	friend class CNullSink;
+
+public:
+	CNullChannel(CAudioClock &Clock);
+
+	bool Play();
+	bool Stop();
+	bool IsPlaying() const;
+	bool ClearBuffer();
+	bool WriteBuffer(const char *pBuffer, unsigned int Samples);
+
+	buffer_event_t WaitForSyncEvent(unsigned int Timeout);
+	void Interrupt();
+
+private:
+	std::chrono::nanoseconds GetBlockTime(unsigned long long Block) const;
+
+private:
+	CAudioClock				&m_Clock;
+	mutable std::mutex		m_Mutex;
+	std::condition_variable	m_Wake;
+	bool					m_bPlaying;
+	bool					m_bInterrupt;
+	std::chrono::nanoseconds m_Start;
+	unsigned long long		m_iBlocksPlayed;		// Blocks reported as consumed since Play()
+};
+
+class CNullSink : public CAudioSink
+{
+public:
+	CNullSink(CAudioClock *pClock = NULL);		// Real time unless a clock is given
+
+	bool			SetupDevice(int iDevice);
+	void			CloseDevice();
+
+	CAudioChannel	*OpenChannel(int SampleRate, int SampleSize, int Channels, int BufferLength, int Blocks);
+	void			CloseChannel(CAudioChannel *pChannel);
+
+	void			EnumerateDevices();
+	unsigned int	GetDeviceCount() const;
+	const char		*GetDeviceName(unsigned int iDevice) const;
+
+private:
+	CSteadyClock	m_SteadyClock;
+	CAudioClock		*m_pClock;
+};
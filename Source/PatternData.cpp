@@ -1,228 +1,294 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include "stdafx.h"
-#include "FamiTrackerDoc.h"
-#include "PatternData.h"
-
-// This class contains pattern data
-// A list of these objects exists inside the document one for each song
-
-CPatternData::CPatternData(unsigned int PatternLength, unsigned int Speed, unsigned int Tempo) :
-	m_iPatternLength(PatternLength),
-	m_iFrameCount(1),
-	m_iSongSpeed(Speed),
-	m_iSongTempo(Tempo),
-	m_iRowHighlight1(CFamiTrackerDoc::DEFAULT_FIRST_HIGHLIGHT),
-	m_iRowHighlight2(CFamiTrackerDoc::DEFAULT_SECOND_HIGHLIGHT)
-{
-	// Clear memory
-	memset(m_iFrameList, 0, sizeof(char) * MAX_FRAMES * MAX_CHANNELS);
-	memset(m_pPatternData, 0, sizeof(stChanNote*) * MAX_CHANNELS * MAX_PATTERN);
-	memset(m_iEffectColumns, 0, sizeof(char) * MAX_CHANNELS);
-}
-
-CPatternData::~CPatternData()
-{
-	// Deallocate memory
-	for (int i = 0; i < MAX_CHANNELS; ++i) {
-		for (int j = 0; j < MAX_PATTERN; ++j) {
-			SAFE_RELEASE_ARRAY(m_pPatternData[i][j]);
-		}
-	}
-}
-
-bool CPatternData::IsCellFree(unsigned int Channel, unsigned int Pattern, unsigned int Row) const
-{
-	stChanNote *pNote = GetPatternData(Channel, Pattern, Row);
-
-	if (pNote == NULL)
-		return true;
-
-	bool IsFree = pNote->Note == NONE && 
-		pNote->EffNumber[0] == 0 && pNote->EffNumber[1] == 0 && 
-		pNote->EffNumber[2] == 0 && pNote->EffNumber[3] == 0 && 
-		pNote->Vol == MAX_VOLUME && pNote->Instrument == MAX_INSTRUMENTS;
-
-	return IsFree;
-}
-
-bool CPatternData::IsPatternEmpty(unsigned int Channel, unsigned int Pattern) const
-{
-	// Unallocated pattern means empty
-	if (!m_pPatternData[Channel][Pattern])
-		return true;
-
-	// Check if allocated pattern is empty
-	for (unsigned int i = 0; i < m_iPatternLength; ++i) {
-		if (!IsCellFree(Channel, Pattern, i))
-			return false;
-	}
-
-	return true;
-}
-
-bool CPatternData::IsPatternInUse(unsigned int Channel, unsigned int Pattern) const
-{
-	// Check if pattern is addressed in frame list
-	for (unsigned i = 0; i < m_iFrameCount; ++i) {
-		if (m_iFrameList[i][Channel] == Pattern)
-			return true;
-	}
-
-	return false;
-}
-
-stChanNote *CPatternData::GetPatternData(unsigned int Channel, unsigned int Pattern, unsigned int Row) const
-{
-	// Private method, may return NULL
-	if (!m_pPatternData[Channel][Pattern])
-		return NULL;
-
-	return m_pPatternData[Channel][Pattern] + Row;
-}
-
-stChanNote *CPatternData::GetPatternData(unsigned int Channel, unsigned int Pattern, unsigned int Row)
-{
-	if (!m_pPatternData[Channel][Pattern])		// Allocate pattern if accessed for the first time
-		AllocatePattern(Channel, Pattern);
-
-	return m_pPatternData[Channel][Pattern] + Row;
-}
-
-void CPatternData::AllocatePattern(unsigned int Channel, unsigned int Pattern)
-{
-	// Allocate memory
-	m_pPatternData[Channel][Pattern] = new stChanNote[MAX_PATTERN_LENGTH];
-
-	// Clear memory
-	for (int i = 0; i < MAX_PATTERN_LENGTH; ++i) {
-		stChanNote *pNote = m_pPatternData[Channel][Pattern] + i;
-		pNote->Note		  = 0;
-		pNote->Octave	  = 0;
-		pNote->Instrument = MAX_INSTRUMENTS;
-		pNote->Vol		  = MAX_VOLUME;
-
-		for (int n = 0; n < MAX_EFFECT_COLUMNS; ++n) {
-			pNote->EffNumber[n] = 0;
-			pNote->EffParam[n] = 0;
-		}
-	}
-}
-
-void CPatternData::ClearEverything()
-{
-	// Release all patterns and clear frame list
-
-	// Frame list
-	memset(m_iFrameList, 0, sizeof(char) * MAX_FRAMES * MAX_CHANNELS);
-	m_iFrameCount = 1;
-	
-	// Patterns, deallocate everything
-	for (int i = 0; i < MAX_CHANNELS; ++i) {
-		for (int j = 0; j < MAX_PATTERN; ++j) {
-			ClearPattern(i, j);
-		}
-	}
-}
-
-void CPatternData::ClearPattern(unsigned int Channel, unsigned int Pattern)
-{
-	// Deletes a specified pattern in a channel
-	if (m_pPatternData[Channel][Pattern] != NULL) {
-		SAFE_RELEASE_ARRAY(m_pPatternData[Channel][Pattern]);
-	}
-}
-
-unsigned int CPatternData::GetPatternLength() const		// // //
-{
-	return m_iPatternLength;
-}
-
-unsigned int CPatternData::GetFrameCount() const
-{
-	return m_iFrameCount;
-}
-
-unsigned int CPatternData::GetSongSpeed() const
-{
-	return m_iSongSpeed;
-}
-
-unsigned int CPatternData::GetSongTempo() const
-{
-	return m_iSongTempo;
-}
-
-int CPatternData::GetEffectColumnCount(int Channel) const
-{
-	return m_iEffectColumns[Channel];
-}
-
-unsigned int CPatternData::GetFramePattern(unsigned int Frame, unsigned int Channel) const
-{ 
-	return m_iFrameList[Frame][Channel]; 
-}
-
-unsigned int CPatternData::GetSecondRowHighlight() const
-{
-	return m_iRowHighlight1;
-}
-
-unsigned int CPatternData::GetFirstRowHighlight() const
-{
-	return m_iRowHighlight2;
-}
-
-void CPatternData::SetPatternLength(unsigned int Length)
-{
-	m_iPatternLength = Length;
-}
-
-void CPatternData::SetFrameCount(unsigned int Count)
-{
-	m_iFrameCount = Count;
-}
-
-void CPatternData::SetSongSpeed(unsigned int Speed)
-{
-	m_iSongSpeed = Speed;
-}
-
-void CPatternData::SetSongTempo(unsigned int Tempo)
-{
-	m_iSongTempo = Tempo;
-}
-
-void CPatternData::SetEffectColumnCount(int Channel, int Count)
-{
-	m_iEffectColumns[Channel] = Count;
-}
-
-void CPatternData::SetFramePattern(unsigned int Frame, unsigned int Channel, unsigned int Pattern)
-{
-	m_iFrameList[Frame][Channel] = Pattern;
-}
-
-void CPatternData::SetHighlight(unsigned int First, unsigned int Second)
-{
-	m_iRowHighlight1 = First;
-	m_iRowHighlight2 = Second;
-}
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include <algorithm>		// // //
+#include "PatternData.h"
+
+const stChanNote stChanNote::BLANK = {0, 0, MAX_VOLUME, MAX_INSTRUMENTS, {EF_NONE, EF_NONE, EF_NONE, EF_NONE}, {0, 0, 0, 0}};		// // //
+
+// This class contains pattern data
+// A list of these objects exists inside the document one for each song
+
+CPatternData::CPatternData(unsigned int PatternLength, unsigned int Speed, unsigned int Tempo) :
+	m_iPatternLength(PatternLength),
+	m_iFrameCount(1),
+	m_iSongSpeed(Speed),
+	m_iSongTempo(Tempo),
+	m_iRowHighlight1(DEFAULT_FIRST_HIGHLIGHT),		// // //
+	m_iRowHighlight2(DEFAULT_SECOND_HIGHLIGHT)
+{
+	// // // Frame list and effect columns are cleared by FTExt::CTrackData
+}
+
+CPatternData::~CPatternData()
+{
+	// // //
+}
+
+bool CPatternData::IsCellFree(unsigned int Channel, unsigned int Pattern, unsigned int Row) const
+{
+	const FTExt::CPatternData *pPattern = GetPattern(Channel, Pattern);		// // //
+	return pPattern == nullptr || pPattern->IsRowBlank(Row) || !pPattern->GetNote(Row);
+}
+
+bool CPatternData::IsPatternEmpty(unsigned int Channel, unsigned int Pattern) const
+{
+	// Unallocated pattern means empty
+	const FTExt::CPatternData *pPattern = GetPattern(Channel, Pattern);		// // //
+	return pPattern == nullptr || pPattern->IsEmpty();
+}
+
+bool CPatternData::IsPatternInUse(unsigned int Channel, unsigned int Pattern) const
+{
+	// Check if pattern is addressed in frame list
+	for (unsigned i = 0; i < m_iFrameCount; ++i) {
+		if (GetFramePattern(i, Channel) == Pattern)		// // //
+			return true;
+	}
+
+	return false;
+}
+
+stChanNote CPatternData::GetNote(unsigned int Channel, unsigned int Pattern, unsigned int Row) const		// // //
+{
+	const FTExt::CPatternData *pPattern = GetPattern(Channel, Pattern);
+	return pPattern != nullptr ? ToChanNote(pPattern->GetNote(Row)) : stChanNote::BLANK;
+}
+
+void CPatternData::SetNote(unsigned int Channel, unsigned int Pattern, unsigned int Row, const stChanNote &Note)		// // //
+{
+	// Allocate pattern if accessed for the first time
+	FTExt::CTrackData &Track = m_Tracks[Channel];
+	FTExt::CPatternData *pPattern = IsPatternAllocated(Channel, Pattern) ?
+		Track.GetPattern(Pattern) : Track.NewPattern(Pattern, m_iPatternLength);
+	pPattern->SetNote(Row, ToPatternNote(Note));
+}
+
+const FTExt::CPatternData *CPatternData::GetPattern(unsigned int Channel, unsigned int Pattern) const		// // //
+{
+	return m_Tracks[Channel].GetPattern(Pattern);
+}
+
+bool CPatternData::IsPatternAllocated(unsigned int Channel, unsigned int Pattern) const		// // //
+{
+	return GetPattern(Channel, Pattern) != nullptr;
+}
+
+unsigned int CPatternData::FindNextNote(unsigned int Channel, unsigned int Pattern, unsigned int Row) const		// // //
+{
+	// Rows beyond the pattern length are included, the caller has to stop at the length
+	const FTExt::CPatternData *pPattern = GetPattern(Channel, Pattern);
+	return pPattern != nullptr ? static_cast<unsigned int>(pPattern->FindNextNote(Row)) : MAX_PATTERN_LENGTH;
+}
+
+void CPatternData::CopyPattern(unsigned int Channel, unsigned int Target, unsigned int Source)		// // //
+{
+	m_Tracks[Channel].CopyPattern(Target, Source);
+}
+
+FTExt::CPatternData *CPatternData::ReleasePattern(unsigned int Channel, unsigned int Pattern)		// // //
+{
+	return m_Tracks[Channel].ReleasePattern(Pattern);
+}
+
+void CPatternData::ReplacePattern(unsigned int Channel, unsigned int Pattern, FTExt::CPatternData *pPattern)		// // //
+{
+	// Takes ownership of the pattern
+	if (pPattern != nullptr)
+		pPattern->SetSize(m_iPatternLength);
+	m_Tracks[Channel].ReplacePattern(Pattern, pPattern);
+}
+
+size_t CPatternData::GetPatternHash(unsigned int Channel, unsigned int Pattern) const		// // //
+{
+	const FTExt::CPatternData *pPattern = GetPattern(Channel, Pattern);
+	return pPattern != nullptr ? pPattern->GetHash() : FTExt::CPatternData::GetBlankHash(m_iPatternLength);
+}
+
+bool CPatternData::IsPatternEqual(unsigned int Channel, unsigned int First, unsigned int Second) const		// // //
+{
+	const FTExt::CPatternData *a = GetPattern(Channel, First);
+	const FTExt::CPatternData *b = GetPattern(Channel, Second);
+	if (a != nullptr && b != nullptr)
+		return *a == *b;
+	if (a != nullptr)
+		return a->IsEmpty();
+	return b == nullptr || b->IsEmpty();
+}
+
+void CPatternData::SharePatterns(pattern_table_t &Table)		// // //
+{
+	for (int i = 0; i < MAX_CHANNELS; ++i)
+		for (int j = 0; j < MAX_PATTERN; ++j) {
+			if (!IsPatternAllocated(i, j))
+				continue;
+			FTExt::CPatternData *pPattern = m_Tracks[i].GetPattern(j);
+			const size_t Hash = pPattern->GetHash();
+			auto Range = Table.equal_range(Hash);
+			if (std::none_of(Range.first, Range.second, [pPattern] (const pattern_table_t::value_type &x) {
+				return pPattern->ShareData(*x.second);
+			}))
+				Table.emplace(Hash, pPattern);
+		}
+}
+
+void CPatternData::CompactPatterns()		// // //
+{
+	for (int i = 0; i < MAX_CHANNELS; ++i)
+		for (int j = 0; j < MAX_PATTERN; ++j) {
+			if (!IsPatternAllocated(i, j))
+				continue;
+			FTExt::CPatternData *pPattern = m_Tracks[i].GetPattern(j);
+			if (pPattern->FindNextNote(0) == FTExt::CPatternData::MAX_SIZE)
+				ClearPattern(i, j);
+			else
+				pPattern->ShrinkToFit();
+		}
+}
+
+void CPatternData::ClearEverything()
+{
+	// Release all patterns and clear frame list
+
+	// Frame list
+	for (int i = 0; i < MAX_CHANNELS; ++i)		// // //
+		for (int j = 0; j < MAX_FRAMES; ++j)
+			SetFramePattern(j, i, 0);
+	m_iFrameCount = 1;
+	
+	// Patterns, deallocate everything
+	for (int i = 0; i < MAX_CHANNELS; ++i)		// // //
+		for (int j = 0; j < MAX_PATTERN; ++j)
+			ClearPattern(i, j);
+}
+
+void CPatternData::ClearPattern(unsigned int Channel, unsigned int Pattern)
+{
+	// Deletes a specified pattern in a channel
+	m_Tracks[Channel].ClearPattern(Pattern);		// // //
+}
+
+unsigned int CPatternData::GetPatternLength() const		// // //
+{
+	return m_iPatternLength;
+}
+
+unsigned int CPatternData::GetFrameCount() const
+{
+	return m_iFrameCount;
+}
+
+unsigned int CPatternData::GetSongSpeed() const
+{
+	return m_iSongSpeed;
+}
+
+unsigned int CPatternData::GetSongTempo() const
+{
+	return m_iSongTempo;
+}
+
+int CPatternData::GetEffectColumnCount(int Channel) const
+{
+	return m_Tracks[Channel].GetEffectColumnCount() - 1;		// // // stored as the column count
+}
+
+unsigned int CPatternData::GetFramePattern(unsigned int Frame, unsigned int Channel) const
+{ 
+	return m_Tracks[Channel].GetPatternIndex(Frame);		// // //
+}
+
+unsigned int CPatternData::GetSecondRowHighlight() const
+{
+	return m_iRowHighlight1;
+}
+
+unsigned int CPatternData::GetFirstRowHighlight() const
+{
+	return m_iRowHighlight2;
+}
+
+void CPatternData::SetPatternLength(unsigned int Length)
+{
+	m_iPatternLength = Length;
+	for (int i = 0; i < MAX_CHANNELS; ++i)		// // // rows beyond the pattern length are kept
+		for (int j = 0; j < MAX_PATTERN; ++j)
+			if (IsPatternAllocated(i, j))
+				m_Tracks[i].GetPattern(j)->SetSize(Length);
+}
+
+void CPatternData::SetFrameCount(unsigned int Count)
+{
+	m_iFrameCount = Count;
+}
+
+void CPatternData::SetSongSpeed(unsigned int Speed)
+{
+	m_iSongSpeed = Speed;
+}
+
+void CPatternData::SetSongTempo(unsigned int Tempo)
+{
+	m_iSongTempo = Tempo;
+}
+
+void CPatternData::SetEffectColumnCount(int Channel, int Count)
+{
+	m_Tracks[Channel].SetEffectColumnCount(Count + 1);		// // //
+}
+
+void CPatternData::SetFramePattern(unsigned int Frame, unsigned int Channel, unsigned int Pattern)
+{
+	m_Tracks[Channel].SetPatternIndex(Frame, Pattern);		// // //
+}
+
+void CPatternData::SetHighlight(unsigned int First, unsigned int Second)
+{
+	m_iRowHighlight1 = First;
+	m_iRowHighlight2 = Second;
+}
+
+FTExt::CPatternNote CPatternData::ToPatternNote(const stChanNote &Note)		// // //
+{
+	FTExt::CPatternNote Cell;
+	Cell.Note = Note.Note;
+	Cell.Octave = Note.Octave;
+	Cell.Inst = Note.Instrument;
+	Cell.Vol = Note.Vol;
+	for (int i = 0; i < MAX_EFFECT_COLUMNS; ++i) {
+		Cell.Effect[i].Index = Note.EffNumber[i];
+		Cell.Effect[i].Param = Note.EffParam[i];
+	}
+	return Cell;
+}
+
+stChanNote CPatternData::ToChanNote(const FTExt::CPatternNote &Cell)		// // //
+{
+	stChanNote Note;
+	Note.Note = Cell.Note;
+	Note.Octave = Cell.Octave;
+	Note.Instrument = Cell.Inst;
+	Note.Vol = Cell.Vol;
+	for (int i = 0; i < MAX_EFFECT_COLUMNS; ++i) {
+		Note.EffNumber[i] = Cell.Effect[i].Index;
+		Note.EffParam[i] = Cell.Effect[i].Param;
+	}
+	return Note;
+}
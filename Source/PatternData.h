@@ -1,97 +1,125 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#pragma once
-
-
-// Channel note struct, holds the data for each row in patterns
-struct stChanNote {
-	unsigned char Note;
-	unsigned char Octave;
-	unsigned char Vol;
-	unsigned char Instrument;
-	unsigned char EffNumber[MAX_EFFECT_COLUMNS];
-	unsigned char EffParam[MAX_EFFECT_COLUMNS];
-
-	static const stChanNote BLANK;
-};
-
-const stChanNote stChanNote::BLANK = {0, 0, MAX_VOLUME, MAX_INSTRUMENTS, {EF_NONE, EF_NONE, EF_NONE, EF_NONE}, {0, 0, 0, 0}};
-
-// TODO rename to CTrack perhaps?
-
-// CPatternData holds all notes in the patterns
-class CPatternData {
-public:
-	CPatternData(unsigned int PatternLength, unsigned int Speed, unsigned int Tempo);
-	~CPatternData();
-
-	bool IsCellFree(unsigned int Channel, unsigned int Pattern, unsigned int Row) const;
-	bool IsPatternEmpty(unsigned int Channel, unsigned int Pattern) const;
-	bool IsPatternInUse(unsigned int Channel, unsigned int Pattern) const;
-
-	void ClearEverything();
-	void ClearPattern(unsigned int Channel, unsigned int Pattern);
-
-	stChanNote *GetPatternData(unsigned int Channel, unsigned int Pattern, unsigned int Row);
-
-	unsigned int GetPatternLength() const;		// // //
-	unsigned int GetFrameCount() const;
-	unsigned int GetSongSpeed() const;
-	unsigned int GetSongTempo() const;
-	int GetEffectColumnCount(int Channel) const;
-	unsigned int GetFramePattern(unsigned int Frame, unsigned int Channel) const;
-	unsigned int GetFirstRowHighlight() const;
-	unsigned int GetSecondRowHighlight() const;
-
-	void SetPatternLength(unsigned int Length);
-	void SetFrameCount(unsigned int Count);
-	void SetSongSpeed(unsigned int Speed);
-	void SetSongTempo(unsigned int Tempo);
-	void SetEffectColumnCount(int Channel, int Count);
-	void SetFramePattern(unsigned int Frame, unsigned int Channel, unsigned int Pattern);
-	void SetHighlight(unsigned int First, unsigned int Second);
-
-private:
-	stChanNote *GetPatternData(unsigned int Channel, unsigned int Pattern, unsigned int Row) const;
-	void AllocatePattern(unsigned int Channel, unsigned int Patterns);
-
-	// Pattern data
-private:
-
-	// Track parameters
-	unsigned int m_iPatternLength;			// Amount of rows in one pattern
-	unsigned int m_iFrameCount;				// Number of frames
-	unsigned int m_iSongSpeed;				// Song speed
-	unsigned int m_iSongTempo;				// Song tempo
-
-	// Row highlight settings
-	unsigned int m_iRowHighlight1;
-	unsigned int m_iRowHighlight2;
-
-	// Number of visible effect columns for each channel
-	unsigned char m_iEffectColumns[MAX_CHANNELS];
-
-	// List of the patterns assigned to frames
-	unsigned char m_iFrameList[MAX_FRAMES][MAX_CHANNELS];		
-
-	// All accesses to m_pPatternData must go through GetPatternData()
-	stChanNote *m_pPatternData[MAX_CHANNELS][MAX_PATTERN];
-};
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include "Document/TrackData.h"		// // //
+#include "Document/PatternData_new.h"
+#include <unordered_map>
+
+// Channel note struct, holds the data for each row in patterns
+struct stChanNote {
+	unsigned char Note;
+	unsigned char Octave;
+	unsigned char Vol;
+	unsigned char Instrument;
+	unsigned char EffNumber[MAX_EFFECT_COLUMNS];
+	unsigned char EffParam[MAX_EFFECT_COLUMNS];
+
+	static const stChanNote BLANK;
+};
+
+// TODO rename to CTrack perhaps?
+
+// CPatternData holds all notes in the patterns
+class CPatternData {
+public:
+	CPatternData(unsigned int PatternLength, unsigned int Speed, unsigned int Tempo);
+	~CPatternData();
+
+	bool IsCellFree(unsigned int Channel, unsigned int Pattern, unsigned int Row) const;
+	bool IsPatternEmpty(unsigned int Channel, unsigned int Pattern) const;
+	bool IsPatternInUse(unsigned int Channel, unsigned int Pattern) const;
+
+	void ClearEverything();
+	void ClearPattern(unsigned int Channel, unsigned int Pattern);
+
+	// // // Unallocated patterns read as blank, writing a note allocates the pattern
+	stChanNote GetNote(unsigned int Channel, unsigned int Pattern, unsigned int Row) const;
+	void SetNote(unsigned int Channel, unsigned int Pattern, unsigned int Row, const stChanNote &Note);
+	const FTExt::CPatternData *GetPattern(unsigned int Channel, unsigned int Pattern) const;
+	bool IsPatternAllocated(unsigned int Channel, unsigned int Pattern) const;
+	// // // Returns the first row at or after Row that is not blank, or MAX_PATTERN_LENGTH
+	unsigned int FindNextNote(unsigned int Channel, unsigned int Pattern, unsigned int Row) const;
+
+	// // // Whole-pattern operations, these replace pattern objects and free the old
+	// ones; like SetPatternLength, the document has to be locked while the player runs
+	void CopyPattern(unsigned int Channel, unsigned int Target, unsigned int Source);
+	FTExt::CPatternData *ReleasePattern(unsigned int Channel, unsigned int Pattern);
+	void ReplacePattern(unsigned int Channel, unsigned int Pattern, FTExt::CPatternData *pPattern);
+
+	// // // Unallocated patterns hash and compare like empty patterns
+	size_t GetPatternHash(unsigned int Channel, unsigned int Pattern) const;
+	bool IsPatternEqual(unsigned int Channel, unsigned int First, unsigned int Second) const;
+
+	// // // Lets identical patterns share their rows, the table holds the patterns
+	// visited so far and may be reused for other tracks. Rows of patterns in use
+	// are freed, the document has to be locked while the player runs
+	typedef std::unordered_multimap<size_t, const FTExt::CPatternData*> pattern_table_t;
+	void SharePatterns(pattern_table_t &Table);
+
+	// // // Releases patterns without any notes and the storage of blank rows at the end,
+	// notes beyond the pattern length are kept. Rows of patterns in use are moved, the
+	// document has to be locked while the player runs
+	void CompactPatterns();
+
+	unsigned int GetPatternLength() const;		// // //
+	unsigned int GetFrameCount() const;
+	unsigned int GetSongSpeed() const;
+	unsigned int GetSongTempo() const;
+	int GetEffectColumnCount(int Channel) const;
+	unsigned int GetFramePattern(unsigned int Frame, unsigned int Channel) const;
+	unsigned int GetFirstRowHighlight() const;
+	unsigned int GetSecondRowHighlight() const;
+
+	void SetPatternLength(unsigned int Length);
+	void SetFrameCount(unsigned int Count);
+	void SetSongSpeed(unsigned int Speed);
+	void SetSongTempo(unsigned int Tempo);
+	void SetEffectColumnCount(int Channel, int Count);
+	void SetFramePattern(unsigned int Frame, unsigned int Channel, unsigned int Pattern);
+	void SetHighlight(unsigned int First, unsigned int Second);
+
+	// // //
+	static FTExt::CPatternNote ToPatternNote(const stChanNote &Note);
+	static stChanNote ToChanNote(const FTExt::CPatternNote &Note);
+
+	// // // Row highlight of new tracks
+	static const unsigned int DEFAULT_FIRST_HIGHLIGHT = 4;
+	static const unsigned int DEFAULT_SECOND_HIGHLIGHT = 16;
+
+	// Pattern data
+private:
+
+	// Track parameters
+	unsigned int m_iPatternLength;			// Amount of rows in one pattern
+	unsigned int m_iFrameCount;				// Number of frames
+	unsigned int m_iSongSpeed;				// Song speed
+	unsigned int m_iSongTempo;				// Song tempo
+
+	// Row highlight settings
+	unsigned int m_iRowHighlight1;
+	unsigned int m_iRowHighlight2;
+
+	// // // Patterns, frame list and effect column count of each channel. There is
+	// no pool for the rows of a track, each pattern owns a block sized to the pattern
+	// length and identical patterns share theirs (see SharePatterns)
+	FTExt::CTrackData m_Tracks[MAX_CHANNELS];
+};
@@ -0,0 +1,697 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "stdafx.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "FamiTracker.h"
+#include "FamiTrackerDoc.h"
+#include "APU/APU.h"
+#include "ChannelHandler.h"
+#include "ChannelsSN7.h"
+#include "PlayerEngine.h"
+#include "VGM/Logger.h"
+#include "VGM/Writer/SN76489.h"
+#include <sstream>
+
+// The depth of each vibrato level
+const double CPlayerEngine::NEW_VIBRATO_DEPTH[] = {
+	1.0, 1.5, 2.5, 4.0, 5.0, 7.0, 10.0, 12.0, 14.0, 17.0, 22.0, 30.0, 44.0, 64.0, 96.0, 128.0
+};
+
+const double CPlayerEngine::OLD_VIBRATO_DEPTH[] = {
+	1.0, 1.0, 2.0, 3.0, 4.0, 7.0, 8.0, 15.0, 16.0, 31.0, 32.0, 63.0, 64.0, 127.0, 128.0, 255.0
+};
+
+CPlayerEngine::CPlayerEngine() :
+	m_pDocument(nullptr),
+	m_pAPU(new CAPU(this)),
+	m_iPendingPos(0),
+	m_iTempo(0),
+	m_iSpeed(0),
+	m_iTempoAccum(0),
+	m_iTempoDecrement(0),
+	m_iTempoRemainder(0),
+	m_iSpeedSplitPoint(DEFAULT_SPEED_SPLIT_POINT),
+	m_iFrameRate(CAPU::FRAME_RATE_NTSC),
+	m_iUpdateCycles(0),
+	m_iConsumedCycles(0),
+	m_iPlayTrack(0),
+	m_iPlayFrame(0),
+	m_iPlayRow(0),
+	m_iJumpToPattern(-1),
+	m_iSkipToRow(-1),
+	m_iStepRows(0),
+	m_bUpdateRow(false),
+	m_bPlaying(false),
+	m_bHaltRequest(false),
+	m_iTailFrames(0),
+	m_iPlayTicks(0),
+	m_iFramesPlayed(0),
+	m_iRowsPlayed(0),
+	m_iEndWhen(SONG_LOOP_LIMIT),
+	m_iEndParam(0),
+	m_iRowCount(0)
+{
+	CreateChannels();
+}
+
+CPlayerEngine::~CPlayerEngine()
+{
+	for (auto &x : m_pChannels)
+		SAFE_RELEASE(x);
+	for (auto &x : m_pSN7Chip)
+		SAFE_RELEASE(x);
+	SAFE_RELEASE(m_pAPU);
+}
+
+void CPlayerEngine::CreateChannels()
+{
+	for (auto &x : m_pChannels)
+		x = nullptr;
+
+	// Each engine has its own chip state, so that engines can run side by side
+	for (unsigned i = 0; i < sizeof(m_pSN7Chip) / sizeof(*m_pSN7Chip); ++i)
+		m_pSN7Chip[i] = new CChipHandlerSN7(i);
+	m_pChannels[CHANID_SQUARE1] = new CSquareChan(m_pSN7Chip[0]);
+	m_pChannels[CHANID_SQUARE2] = new CSquareChan(m_pSN7Chip[0]);
+	m_pChannels[CHANID_SQUARE3] = new CSquareChan(m_pSN7Chip[0]);
+	m_pChannels[CHANID_NOISE] = new CNoiseChan(m_pSN7Chip[0]);
+	m_pChannels[CHANID_SQUARE1_2] = new CSquareChan(m_pSN7Chip[1]);
+	m_pChannels[CHANID_SQUARE2_2] = new CSquareChan(m_pSN7Chip[1]);
+	m_pChannels[CHANID_SQUARE3_2] = new CSquareChan(m_pSN7Chip[1]);
+	m_pChannels[CHANID_NOISE_2] = new CNoiseChan(m_pSN7Chip[1]);
+
+	for (int i = 0; i < CHANNELS; ++i)
+		if (m_pChannels[i] != nullptr)
+			m_pChannels[i]->SetChannelID(i);
+}
+
+//
+// Setup
+//
+
+bool CPlayerEngine::Initialize(CFamiTrackerDoc *pDoc, int SampleRate, bool HighQuality)
+{
+	ASSERT(pDoc != nullptr);
+
+	m_pDocument = pDoc;
+
+	const int Machine = pDoc->GetMachine();
+	m_iFrameRate = pDoc->GetFrameRate();
+	m_iUpdateCycles = ((Machine == NTSC) ? CAPU::BASE_FREQ_NTSC : CAPU::BASE_FREQ_PAL) / m_iFrameRate;
+	m_iSpeedSplitPoint = pDoc->GetSpeedSplitPoint();
+
+	GenerateVibratoTable(m_iVibratoTable, pDoc->GetVibratoStyle());
+	GenerateNoteTable(m_iNoteLookupTable, Machine);
+
+	if (!m_pAPU->SetupSound(SampleRate, 2, (Machine == NTSC) ? MACHINE_NTSC : MACHINE_PAL, HighQuality))
+		return false;
+	m_pAPU->SetExternalSound(pDoc->GetExpansionChip());		// the number of SN76489 chips
+
+	// Same as the default sound settings
+	SetupMixer(30, 12000, 24, 100);
+	m_pAPU->SetMetering(false);		// nothing displays the volume meters
+
+	m_fPendingSamples.reserve((SampleRate / CAPU::FRAME_RATE_PAL + 1) * 4);
+	m_fPendingSamples.clear();
+	m_iPendingPos = 0;
+
+	if (!SetStemCount(GetStemCount()))		// stems set up earlier follow the new rate
+		return false;
+
+	for (int i = 0; i < CHANNELS; ++i) {
+		if (m_pChannels[i] != nullptr) {
+			m_pChannels[i]->InitChannel(m_pAPU, m_iVibratoTable, this);
+			m_pChannels[i]->SetNoteTable(m_iNoteLookupTable);
+		}
+	}
+
+	MakeSilent();
+
+	return true;
+}
+
+void CPlayerEngine::SetupMixer(int LowCut, int HighCut, int HighDamp, int Volume) const
+{
+	m_pAPU->SetupMixer(LowCut, HighCut, HighDamp, Volume);
+}
+
+void CPlayerEngine::SetChipLevel(chip_level_t Chip, float Level) const
+{
+	m_pAPU->SetChipLevel(Chip, Level);
+}
+
+void CPlayerEngine::SetStereoSeparation(float Sep) const
+{
+	m_pAPU->SetStereoSeparation(Sep);
+}
+
+bool CPlayerEngine::SetStemCount(int Count)
+{
+	// Every channel below Count is also rendered to a stem of its own, in the same
+	// pass as the master mix
+
+	if (!m_pAPU->SetStemCount(Count))
+		return false;
+	m_fPendingStems.resize(m_pAPU->GetStemCount());
+	for (auto &x : m_fPendingStems) {
+		x.reserve(m_fPendingSamples.capacity());
+		x.clear();
+	}
+	return true;
+}
+
+int CPlayerEngine::GetStemCount() const
+{
+	return m_pAPU->GetStemCount();
+}
+
+//
+// Playback
+//
+
+void CPlayerEngine::StartTrack(unsigned int Track, render_end_t SongEndType, unsigned int SongEndParam)
+{
+	ASSERT(m_pDocument != nullptr);
+
+	m_iPlayTrack		= Track;
+	m_iPlayFrame		= 0;
+	m_iPlayRow			= 0;
+	m_iJumpToPattern	= -1;
+	m_iSkipToRow		= -1;
+	m_iPlayTicks		= 0;
+	m_iFramesPlayed		= 0;
+	m_iRowsPlayed		= 0;
+	m_bUpdateRow		= false;
+	m_bHaltRequest		= false;
+	m_bPlaying			= true;
+	m_iTailFrames		= TAIL_FRAMES;
+
+	m_iEndWhen = SongEndType;
+	m_iEndParam = SongEndParam;
+	m_iRowCount = 0;
+	if (m_iEndWhen == SONG_TIME_LIMIT)		// Stored in seconds, convert to frames
+		m_iEndParam *= m_iFrameRate;
+	else if (m_iEndWhen == SONG_LOOP_LIMIT)
+		m_iEndParam = m_pDocument->ScanActualLength(Track, m_iEndParam, m_iRowCount);
+
+	m_iSpeed = m_pDocument->GetSongSpeed(Track);
+	m_iTempo = m_pDocument->GetSongTempo(Track);
+	SetupSpeed();
+	m_iTempoAccum = 0;
+
+	m_fPendingSamples.clear();
+	for (auto &x : m_fPendingStems)
+		x.clear();
+	m_iPendingPos = 0;
+
+	MakeSilent();
+}
+
+void CPlayerEngine::RunFrame()
+{
+	// Runs one player tick and one APU frame, the audio output is collected by FlushBuffer
+
+	ASSERT(m_pDocument != nullptr);
+
+	if (m_bPlaying) {
+		++m_iPlayTicks;
+
+		if (m_iEndWhen == SONG_TIME_LIMIT) {
+			if (m_iPlayTicks >= m_iEndParam)
+				m_bHaltRequest = true;
+		}
+		else if (m_iEndWhen == SONG_LOOP_LIMIT) {
+			// Let the last row finish before stopping
+			if (m_iFramesPlayed >= m_iEndParam && m_iTempoAccum <= 0)
+				m_bHaltRequest = true;
+		}
+
+		// Fetch next row
+		m_iStepRows = 0;
+		if (m_iTempoAccum <= 0) {
+			++m_iStepRows;
+			m_bUpdateRow = true;
+			ReadPatternRow();
+			++m_iRowsPlayed;
+		}
+		else
+			m_bUpdateRow = false;
+
+		// Update player
+		if (m_bUpdateRow && !m_bHaltRequest)
+			CheckControl();
+
+		if (m_iTempoAccum <= 0)
+			m_iTempoAccum += (60 * m_iFrameRate) - m_iTempoRemainder;
+		m_iTempoAccum -= m_iTempoDecrement;
+
+		UpdateChannels();
+	}
+	else if (m_iTailFrames > 0)
+		--m_iTailFrames;
+
+	UpdateAPU();
+
+	if (m_bHaltRequest) {
+		m_bPlaying = false;
+		m_bHaltRequest = false;
+		MakeSilent();
+	}
+}
+
+unsigned int CPlayerEngine::Render(float *pBuffer, unsigned int Samples)		// // //
+{
+	// Fills the buffer with up to Samples interleaved stereo samples, returns the
+	// number of samples written, which is less than requested only at the end
+
+	return Render(pBuffer, nullptr, Samples);
+}
+
+unsigned int CPlayerEngine::Render(int16 *pBuffer, unsigned int Samples)
+{
+	// Same as above, converted to 16-bit samples
+
+	return Render(pBuffer, nullptr, Samples);
+}
+
+unsigned int CPlayerEngine::Render(float *pBuffer, float *const *ppStems, unsigned int Samples)
+{
+	// Stems are produced by the same frames as the master mix, so they always have
+	// as many samples pending; ppStems may be null to discard them
+
+	unsigned int Written = 0;
+
+	while (Written < Samples) {
+		if (m_iPendingPos >= m_fPendingSamples.size()) {
+			if (IsFinished())
+				break;
+			m_fPendingSamples.clear();
+			for (auto &x : m_fPendingStems)
+				x.clear();
+			m_iPendingPos = 0;
+			RunFrame();
+			continue;
+		}
+		size_t Count = std::min<size_t>((Samples - Written) * 2, m_fPendingSamples.size() - m_iPendingPos);
+		memcpy(pBuffer + Written * 2, &m_fPendingSamples[m_iPendingPos], Count * sizeof(float));
+		if (ppStems != nullptr)
+			for (size_t i = 0; i < m_fPendingStems.size(); ++i) {
+				ASSERT(m_fPendingStems[i].size() == m_fPendingSamples.size());
+				memcpy(ppStems[i] + Written * 2, &m_fPendingStems[i][m_iPendingPos], Count * sizeof(float));
+			}
+		m_iPendingPos += Count;
+		Written += Count / 2;
+	}
+
+	return Written;
+}
+
+unsigned int CPlayerEngine::Render(int16 *pBuffer, int16 *const *ppStems, unsigned int Samples)
+{
+	// Same as above, converted to 16-bit samples
+
+	const size_t Stems = ppStems != nullptr ? m_fPendingStems.size() : 0;
+	if (m_fConvertSamples.size() < Samples * 2 * (Stems + 1))
+		m_fConvertSamples.resize(Samples * 2 * (Stems + 1));
+
+	std::vector<float*> pStemSamples(Stems);
+	for (size_t i = 0; i < Stems; ++i)
+		pStemSamples[i] = m_fConvertSamples.data() + Samples * 2 * (i + 1);
+
+	unsigned int Written = Render(m_fConvertSamples.data(), Stems ? pStemSamples.data() : nullptr, Samples);
+	m_SampleConverter.ToInt16(m_fConvertSamples.data(), pBuffer, Written * 2, false);
+	for (size_t i = 0; i < Stems; ++i)
+		m_SampleConverter.ToInt16(pStemSamples[i], ppStems[i], Written * 2, false);
+	return Written;
+}
+
+bool CPlayerEngine::IsFinished() const
+{
+	return !m_bPlaying && !m_iTailFrames;
+}
+
+bool CPlayerEngine::ExportVGM(const char *Filename, unsigned int Track)
+{
+	// Plays the track once without waiting for the audio device, the loop point
+	// is placed where the looped frame is first entered
+
+	ASSERT(m_pDocument != nullptr);
+
+	const int LoopFrame = m_pDocument->ScanLoopFrame(Track);
+	bool bLooped = false;
+	bool Status = false;
+
+	StartTrack(Track, SONG_LOOP_LIMIT, 1);
+
+	try {
+		CVGMLogger Logger {Filename};
+		Logger.SetFrequency(m_iFrameRate);
+		Logger.SetGD3Tag(MakeGD3Tag(m_pDocument, Track));
+		CVGMWriterSN76489 Writer {Logger};
+		m_pAPU->SetVGMWriter(VGMChip::SN76489, &Writer);
+		std::unique_ptr<CVGMWriterSN76489> pWriter2;
+		if (m_pDocument->ExpansionEnabled(SNDCHIP_SN76489_2)) {		// dual chip file, registered after the first chip
+			pWriter2.reset(new CVGMWriterSN76489 {Logger});
+			pWriter2->SetSecondChip(true);
+			m_pAPU->SetVGMWriter(VGMChip::SN76489, pWriter2.get(), 1);
+		}
+
+		while (m_bPlaying) {
+			if (m_iTempoAccum <= 0) {		// A new row is read on this tick
+				if (LoopFrame != -1 && m_iFramesPlayed >= m_iEndParam)
+					break;
+				if (m_iPlayFrame == LoopFrame && !bLooped) {
+					Logger.Loop();
+					bLooped = true;
+				}
+			}
+			RunFrame();
+			Logger.DelayTicks(1);
+		}
+
+		m_pAPU->SetVGMWriter(VGMChip::SN76489, nullptr);
+		m_pAPU->SetVGMWriter(VGMChip::SN76489, nullptr, 1);
+		Status = Logger.Commit();
+	}
+	catch (std::exception &) {
+		m_pAPU->SetVGMWriter(VGMChip::SN76489, nullptr);
+		m_pAPU->SetVGMWriter(VGMChip::SN76489, nullptr, 1);
+		Status = false;
+	}
+
+	m_bPlaying = false;
+	m_iTailFrames = 0;
+	MakeSilent();
+
+	return Status;
+}
+
+void CPlayerEngine::FlushBuffer(float *pBuffer, uint32 Size)		// // //
+{
+	m_fPendingSamples.insert(m_fPendingSamples.end(), pBuffer, pBuffer + Size);
+}
+
+void CPlayerEngine::FlushStem(int Stem, float *pBuffer, uint32 Size)		// // //
+{
+	m_fPendingStems[Stem].insert(m_fPendingStems[Stem].end(), pBuffer, pBuffer + Size);
+}
+
+//
+// Player
+//
+
+void CPlayerEngine::MakeSilent()
+{
+	m_pAPU->Reset();
+
+	for (auto &x : m_pChannels)
+		if (x != nullptr)
+			x->ResetChannel();
+}
+
+void CPlayerEngine::SetupSpeed()
+{
+	m_iTempoDecrement = (m_iTempo * 24) / m_iSpeed;
+	m_iTempoRemainder = (m_iTempo * 24) % m_iSpeed;
+}
+
+void CPlayerEngine::ReadPatternRow()
+{
+	const int Channels = m_pDocument->GetChannelCount();
+	stChanNote NoteData;
+
+	for (int i = 0; i < Channels; ++i) {
+		m_pDocument->GetNoteData(m_iPlayTrack, m_iPlayFrame, i, m_iPlayRow, &NoteData);
+		m_pChannels[m_pDocument->GetChannelType(i)]->PlayNote(&NoteData, m_pDocument->GetEffColumns(m_iPlayTrack, i) + 1);
+	}
+}
+
+void CPlayerEngine::CheckControl()
+{
+	// Jump
+	if (m_iJumpToPattern != -1)
+		PlayerJumpTo(m_iJumpToPattern);
+	// Skip
+	else if (m_iSkipToRow != -1)
+		PlayerSkipTo(m_iSkipToRow);
+	// or just move on
+	else
+		while (m_iStepRows--)
+			PlayerStepRow();
+
+	m_iJumpToPattern = -1;
+	m_iSkipToRow = -1;
+}
+
+void CPlayerEngine::UpdateChannels()
+{
+	for (auto &x : m_pChannels) {
+		if (x != nullptr) {
+			if (m_bHaltRequest)
+				x->ResetChannel();
+			else
+				x->ProcessChannel();
+		}
+	}
+}
+
+void CPlayerEngine::UpdateAPU()
+{
+	m_iConsumedCycles = 0;
+
+	// Register writes are queued by the APU and applied while the frame is synthesized
+	for (auto &x : m_pChannels)
+		if (x != nullptr)
+			x->RefreshChannel();
+
+	// Finish the audio frame
+	m_pAPU->AddTime(m_iUpdateCycles - m_iConsumedCycles);
+	m_pAPU->Process();
+}
+
+void CPlayerEngine::PlayerStepRow()
+{
+	if (++m_iPlayRow >= (int)m_pDocument->GetPatternLength(m_iPlayTrack)) {
+		m_iPlayRow = 0;
+		PlayerStepFrame();
+	}
+}
+
+void CPlayerEngine::PlayerStepFrame()
+{
+	if (++m_iPlayFrame >= (int)m_pDocument->GetFrameCount(m_iPlayTrack))
+		m_iPlayFrame = 0;
+	++m_iFramesPlayed;
+}
+
+void CPlayerEngine::PlayerJumpTo(int Frame)
+{
+	const int Frames = m_pDocument->GetFrameCount(m_iPlayTrack);
+
+	m_iPlayFrame = std::min(Frame, Frames - 1);
+	m_iPlayRow = 0;
+	++m_iFramesPlayed;
+}
+
+void CPlayerEngine::PlayerSkipTo(int Row)
+{
+	const int Rows = m_pDocument->GetPatternLength(m_iPlayTrack);
+
+	if (++m_iPlayFrame >= (int)m_pDocument->GetFrameCount(m_iPlayTrack))
+		m_iPlayFrame = 0;
+	m_iPlayRow = std::min(Row, Rows - 1);
+	++m_iFramesPlayed;
+}
+
+//
+// Stats
+//
+
+unsigned int CPlayerEngine::GetPlayTicks() const
+{
+	return m_iPlayTicks;
+}
+
+unsigned int CPlayerEngine::GetFramesPlayed() const
+{
+	return m_iFramesPlayed;
+}
+
+unsigned int CPlayerEngine::GetFramesToRender() const
+{
+	return m_iEndParam;
+}
+
+unsigned int CPlayerEngine::GetRowsPlayed() const
+{
+	return m_iRowsPlayed;
+}
+
+unsigned int CPlayerEngine::GetRowCount() const
+{
+	return m_iRowCount;
+}
+
+//
+// CSoundGenBase
+//
+
+CFamiTrackerDoc *CPlayerEngine::GetDocument() const
+{
+	return m_pDocument;
+}
+
+int CPlayerEngine::GetDefaultInstrument() const
+{
+	return 0;
+}
+
+void CPlayerEngine::EvaluateGlobalEffects(stChanNote *NoteData, int EffColumns)
+{
+	for (int i = 0; i < EffColumns; ++i) {
+		unsigned char EffNum   = NoteData->EffNumber[i];
+		unsigned char EffParam = NoteData->EffParam[i];
+
+		switch (EffNum) {
+			// Fxx: Sets speed to xx
+			case EF_SPEED:
+				if (!EffParam)
+					++EffParam;
+				if (EffParam >= m_iSpeedSplitPoint)
+					m_iTempo = EffParam;
+				else
+					m_iSpeed = EffParam;
+				SetupSpeed();
+				break;
+
+			// Bxx: Jump to pattern xx
+			case EF_JUMP:
+				SetJumpPattern(EffParam);
+				break;
+
+			// Dxx: Skip to next track and start at row xx
+			case EF_SKIP:
+				SetSkipRow(EffParam);
+				break;
+
+			// Cxx: Halt playback, unconditional stop
+			case EF_HALT:
+				m_bHaltRequest = true;
+				++m_iFramesPlayed;
+				break;
+
+			// NCx: SN76489 channel swap is handled by the channels of each chip
+		}
+	}
+}
+
+void CPlayerEngine::SetJumpPattern(int Pattern)
+{
+	m_iJumpToPattern = Pattern;
+}
+
+void CPlayerEngine::SetSkipRow(int Row)
+{
+	m_iSkipToRow = Row;
+}
+
+void CPlayerEngine::AddCycles(int Count)
+{
+	m_iConsumedCycles += Count;
+	m_pAPU->AddTime(Count);
+}
+
+void CPlayerEngine::WriteRegister(uint16 Reg, uint8 Value)
+{
+}
+
+void CPlayerEngine::WriteExternalRegister(uint16 Reg, uint8 Value)
+{
+}
+
+void CPlayerEngine::RegisterKeyState(int Channel, int Note)
+{
+}
+
+void CPlayerEngine::SetSequencePlayPos(const CSequence *pSequence, int Pos)
+{
+}
+
+//
+// Tables
+//
+
+void CPlayerEngine::GenerateVibratoTable(int *pTable, int Type)
+{
+	for (int i = 0; i < 16; ++i) {	// depth 
+		for (int j = 0; j < 16; ++j) {	// phase
+			int value = 0;
+			double angle = (double(j) / 16.0) * (3.1415 / 2.0);
+
+			if (Type == VIBRATO_NEW)
+				value = int(sin(angle) * NEW_VIBRATO_DEPTH[i] /*+ 0.5f*/);
+			else {
+				value = (int)((double(j * OLD_VIBRATO_DEPTH[i]) / 16.0) + 1);
+			}
+
+			pTable[i * 16 + j] = value;
+		}
+	}
+}
+
+void CPlayerEngine::GenerateNoteTable(unsigned int *pTable, int Machine)
+{
+	const double BASE_FREQ = 32.7032;
+	const double Clock = ((Machine == NTSC) ? CAPU::BASE_FREQ_NTSC : CAPU::BASE_FREQ_PAL) / 32.0;
+
+	for (int i = 0; i < 96; ++i) {
+		// Frequency (in Hz)
+		double Freq = BASE_FREQ * pow(2.0, double(i) / 12.0);
+		pTable[i] = (unsigned int)((Clock / Freq) + 0.5);
+	}
+}
+
+std::vector<char> CPlayerEngine::MakeGD3Tag(const CFamiTrackerDoc *pDoc, unsigned int Track)
+{
+	std::wstringstream Gd3 { };
+	Gd3 << CT2W {pDoc->GetTrackTitle(Track)}.m_psz; Gd3.put(0x0000); Gd3.put(0x0000);
+	Gd3 << CT2W {pDoc->GetSongName()}.m_psz; Gd3.put(0x0000); Gd3.put(0x0000);
+	Gd3 << CT2W {_T("Sega Master System / Game Gear")}.m_psz; Gd3.put(0x0000); Gd3.put(0x0000);
+	Gd3 << CT2W {pDoc->GetSongArtist()}.m_psz; Gd3.put(0x0000); Gd3.put(0x0000);
+	Gd3 << CT2W {CTime::GetCurrentTime().Format(_T("%Y/%m/%d"))}.m_psz; Gd3.put(0x0000);
+	Gd3 << L"SnevenTracker"; Gd3.put(0x0000);
+	Gd3 << CT2W {pDoc->GetSongCopyright()}.m_psz; Gd3.put(0x0000);
+
+	uint32_t Temp;
+	std::vector<char> Tag;
+	auto gd3str = Gd3.str();
+	auto b = reinterpret_cast<const char*>(gd3str.data());
+	auto e = reinterpret_cast<const char*>(gd3str.data() + gd3str.size());
+	Temp = 0x20336447; Tag.insert(Tag.end(), (const char*)&Temp, (const char*)(&Temp + 1));
+	Temp = 0x00000100; Tag.insert(Tag.end(), (const char*)&Temp, (const char*)(&Temp + 1));
+	Temp = e - b;      Tag.insert(Tag.end(), (const char*)&Temp, (const char*)(&Temp + 1));
+	Tag.insert(Tag.end(), b, e);
+	return Tag;
+}
@@ -0,0 +1,166 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+// // // Headless player engine
+//
+// Owns an APU and a full set of channel handlers, and plays a track of a
+// document without any view, message loop or audio device. Used for offline
+// rendering, where frames are produced as fast as the CPU allows.
+
+#include <vector>
+#include "Common.h"
+#include "SoundGenBase.h"
+#include "APU/Types.h"
+#include "APU/Mixer.h"
+#include "APU/SampleConverter.h"
+
+class CFamiTrackerDoc;
+class CAPU;
+class CChannelHandler;
+class CChipHandlerSN7;
+
+class CPlayerEngine : public CSoundGenBase, public IAudioCallback
+{
+public:
+	CPlayerEngine();
+	virtual ~CPlayerEngine();
+
+	// Setup, must be called before anything else
+	// High quality synthesizes at a fixed rate and resamples it to SampleRate
+	bool		Initialize(CFamiTrackerDoc *pDoc, int SampleRate, bool HighQuality = false);
+	void		SetupMixer(int LowCut, int HighCut, int HighDamp, int Volume) const;
+	void		SetChipLevel(chip_level_t Chip, float Level) const;
+	void		SetStereoSeparation(float Sep) const;
+	bool		SetStemCount(int Count);
+	int			GetStemCount() const;
+
+	// Playback
+	void		StartTrack(unsigned int Track, render_end_t SongEndType, unsigned int SongEndParam);
+	void		RunFrame();
+	unsigned int Render(float *pBuffer, unsigned int Samples);
+	unsigned int Render(int16 *pBuffer, unsigned int Samples);
+	// Also fills one buffer per stem with the same number of samples
+	unsigned int Render(float *pBuffer, float *const *ppStems, unsigned int Samples);
+	unsigned int Render(int16 *pBuffer, int16 *const *ppStems, unsigned int Samples);
+	bool		IsFinished() const;
+
+	// VGM export, register writes are logged until the track loops
+	bool		ExportVGM(const char *Filename, unsigned int Track);
+
+	// Stats
+	unsigned int GetPlayTicks() const;
+	unsigned int GetFramesPlayed() const;
+	unsigned int GetFramesToRender() const;
+	unsigned int GetRowsPlayed() const;
+	unsigned int GetRowCount() const;
+
+	// CSoundGenBase
+	CFamiTrackerDoc *GetDocument() const override;
+	int			GetDefaultInstrument() const override;
+	void		EvaluateGlobalEffects(stChanNote *NoteData, int EffColumns) override;
+	void		SetJumpPattern(int Pattern) override;
+	void		SetSkipRow(int Row) override;
+	void		AddCycles(int Count) override;
+	void		WriteRegister(uint16 Reg, uint8 Value) override;
+	void		WriteExternalRegister(uint16 Reg, uint8 Value) override;
+	void		RegisterKeyState(int Channel, int Note) override;
+	void		SetSequencePlayPos(const CSequence *pSequence, int Pos) override;
+
+	// IAudioCallback
+	void		FlushBuffer(float *pBuffer, uint32 Size) override;
+	void		FlushStem(int Stem, float *pBuffer, uint32 Size) override;
+
+public:
+	// Shared with the sound thread
+	static void GenerateVibratoTable(int *pTable, int Type);
+	static void GenerateNoteTable(unsigned int *pTable, int Machine);
+	static std::vector<char> MakeGD3Tag(const CFamiTrackerDoc *pDoc, unsigned int Track);
+
+	static const double NEW_VIBRATO_DEPTH[];
+	static const double OLD_VIBRATO_DEPTH[];
+
+	static const int TAIL_FRAMES = 5;		// Frames rendered after the song has ended
+
+private:
+	void		CreateChannels();
+	void		MakeSilent();
+	void		SetupSpeed();
+	void		ReadPatternRow();
+	void		CheckControl();
+	void		UpdateChannels();
+	void		UpdateAPU();
+	void		PlayerStepRow();
+	void		PlayerStepFrame();
+	void		PlayerJumpTo(int Frame);
+	void		PlayerSkipTo(int Row);
+
+private:
+	CFamiTrackerDoc		*m_pDocument;
+	CAPU				*m_pAPU;
+	CChannelHandler		*m_pChannels[CHANNELS];
+	CChipHandlerSN7		*m_pSN7Chip[CHANNELS / SN76489_CHANNELS];	// State shared by the channels of each SN76489
+
+	int					m_iVibratoTable[256];
+	unsigned int		m_iNoteLookupTable[96];
+
+	// Output
+	std::vector<float>	m_fPendingSamples;				// Interleaved stereo samples from the last frame
+	std::vector<std::vector<float>> m_fPendingStems;	// Same for each stem, read at the same position
+	size_t				m_iPendingPos;
+	std::vector<float>	m_fConvertSamples;				// Samples rendered for 16-bit output
+	CSampleConverter	m_SampleConverter;
+
+	// Tempo
+	unsigned int		m_iTempo;
+	unsigned int		m_iSpeed;
+	int					m_iTempoAccum;
+	int					m_iTempoDecrement;
+	int					m_iTempoRemainder;
+	unsigned int		m_iSpeedSplitPoint;
+	unsigned int		m_iFrameRate;
+	int					m_iUpdateCycles;				// Number of cycles/APU update
+	int					m_iConsumedCycles;				// Cycles consumed by the update registers functions
+
+	// Player state
+	unsigned int		m_iPlayTrack;
+	int					m_iPlayFrame;
+	int					m_iPlayRow;
+	int					m_iJumpToPattern;
+	int					m_iSkipToRow;
+	int					m_iStepRows;
+	bool				m_bUpdateRow;
+	bool				m_bPlaying;
+	bool				m_bHaltRequest;
+	int					m_iTailFrames;
+
+	unsigned int		m_iPlayTicks;
+	unsigned int		m_iFramesPlayed;
+	unsigned int		m_iRowsPlayed;
+
+	// End condition
+	render_end_t		m_iEndWhen;
+	unsigned int		m_iEndParam;
+	unsigned int		m_iRowCount;
+};
@@ -0,0 +1,247 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include "ScopeRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SCOPE_RENDERER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Sample value per pixel of height
+const int SAMPLE_SCALING = 1200;
+
+// Subtracted from the red, green and blue channels by each blur pass
+const unsigned int BLUR_DECAY = 0x0C0C03;
+
+inline unsigned int MixChannel(unsigned int Dst, unsigned int Src, int Alpha, int Shift)
+{
+	const int d = (Dst >> Shift) & 0xFF;
+	const int s = (Src >> Shift) & 0xFF;
+	return (unsigned int)(d + (((s - d) * Alpha) >> 8)) << Shift;
+}
+
+inline unsigned int BlurPixel(const unsigned int *pUp, const unsigned int *pMid, const unsigned int *pDown, int x)
+{
+	// Red and blue are summed in one word, the sums are at most 11 bits wide
+	const unsigned int Pixels[] = {
+		pUp[x - 1], pUp[x], pUp[x + 1], pMid[x - 1], pMid[x + 1], pDown[x - 1], pDown[x], pDown[x + 1],
+	};
+	unsigned int RB = 0, G = 0;
+	for (int i = 0; i < 8; ++i) {
+		RB += Pixels[i] & 0xFF00FF;
+		G += Pixels[i] & 0x00FF00;
+	}
+	RB = (RB >> 3) & 0xFF00FF;
+	G = (G >> 3) & 0x00FF00;
+
+	const int r = (int)(RB & 0xFF) - (int)(BLUR_DECAY & 0xFF);
+	const int g = (int)(G >> 8) - (int)((BLUR_DECAY >> 8) & 0xFF);
+	const int b = (int)(RB >> 16) - (int)(BLUR_DECAY >> 16);
+	return (r > 0 ? r : 0) | (g > 0 ? g << 8 : 0) | (b > 0 ? b << 16 : 0);
+}
+
+#ifdef SCOPE_RENDERER_SSE2
+inline __m128i Load(const unsigned int *p)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+#endif
+
+}
+
+CScopeRenderer::CScopeRenderer() :
+	m_iWidth(0),
+	m_iHeight(0)
+{
+}
+
+void CScopeRenderer::Create(int Width, int Height)
+{
+	m_iWidth = Width;
+	m_iHeight = Height;
+
+	m_Buffer.assign(Width * Height, 0);
+	m_BlurBuffer.assign(Width * Height, 0);
+
+	// Background gradient, brightest in the middle
+	m_Background.resize(Height);
+	for (int y = 0; y < Height; ++y) {
+		unsigned int Level = (unsigned int)(sinf((float(y) * 3.14f) / float(Height)) * 40.0f);
+		m_Background[y] = Level * 0x010101;
+	}
+}
+
+void CScopeRenderer::Render(const short *pSamples, bool bBlur)
+{
+	if (m_iWidth == 0 || m_iHeight < 3)
+		return;
+
+	if (bBlur)
+		Blur();
+	else
+		ClearBackground();
+
+	int Last = ToRow(pSamples[0]);
+	for (int x = 0; x < m_iWidth; ++x) {
+		const int Row = ToRow(pSamples[x]);
+		DrawSegment(x, Last, Row);
+		Last = Row;
+	}
+}
+
+const unsigned int *CScopeRenderer::GetBuffer() const
+{
+	return m_Buffer.empty() ? NULL : &m_Buffer[0];
+}
+
+int CScopeRenderer::GetWidth() const
+{
+	return m_iWidth;
+}
+
+int CScopeRenderer::GetHeight() const
+{
+	return m_iHeight;
+}
+
+void CScopeRenderer::ClearBackground()
+{
+	for (int y = 0; y < m_iHeight; ++y)
+		std::fill_n(m_Buffer.begin() + y * m_iWidth, m_iWidth, m_Background[y]);
+}
+
+void CScopeRenderer::Blur()
+{
+	// Each pixel becomes the average of its eight neighbours in the previous
+	// frame, faded by BLUR_DECAY. The border stays black.
+
+	const unsigned int *pSrc = &m_Buffer[0];
+	unsigned int *pDst = &m_BlurBuffer[0];
+	const int Width = m_iWidth;
+
+	std::fill_n(pDst, Width, 0);
+	std::fill_n(pDst + (m_iHeight - 1) * Width, Width, 0);
+
+	for (int y = 1; y < m_iHeight - 1; ++y) {
+		const unsigned int *pUp = pSrc + (y - 1) * Width;
+		const unsigned int *pMid = pSrc + y * Width;
+		const unsigned int *pDown = pSrc + (y + 1) * Width;
+		unsigned int *pOut = pDst + y * Width;
+
+		pOut[0] = 0;
+		pOut[Width - 1] = 0;
+
+		int x = 1;
+#ifdef SCOPE_RENDERER_SSE2
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i Decay = _mm_set1_epi32(BLUR_DECAY);
+		for (; x + 4 < Width; x += 4) {
+			const __m128i In[8] = {
+				Load(pUp + x - 1), Load(pUp + x), Load(pUp + x + 1),
+				Load(pMid + x - 1), Load(pMid + x + 1),
+				Load(pDown + x - 1), Load(pDown + x), Load(pDown + x + 1),
+			};
+			__m128i Lo = Zero, Hi = Zero;
+			for (int i = 0; i < 8; ++i) {
+				Lo = _mm_add_epi16(Lo, _mm_unpacklo_epi8(In[i], Zero));
+				Hi = _mm_add_epi16(Hi, _mm_unpackhi_epi8(In[i], Zero));
+			}
+			const __m128i Avg = _mm_packus_epi16(_mm_srli_epi16(Lo, 3), _mm_srli_epi16(Hi, 3));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + x), _mm_subs_epu8(Avg, Decay));
+		}
+#endif
+		for (; x < Width - 1; ++x)
+			pOut[x] = BlurPixel(pUp, pMid, pDown, x);
+	}
+
+	m_Buffer.swap(m_BlurBuffer);
+}
+
+void CScopeRenderer::DrawSegment(int x, int From, int To)
+{
+	// Connects the previous column at row From to column x at row To
+
+	const int Delta = To - From;
+
+	if (Delta > 256 || Delta < -256) {
+		// Steep, step through the rows while x moves over one column
+		int Top, Bottom, Pos, Step;
+		if (Delta > 0) {
+			Top = From;
+			Bottom = To;
+			Pos = (x - 1) * 65536;
+			Step = (256 << 16) / Delta;
+		}
+		else {
+			Top = To;
+			Bottom = From;
+			Pos = x * 65536;
+			Step = -((256 << 16) / -Delta);
+		}
+		int Row = (Top + 255) >> 8;
+		Pos += (int)(((long long)(Row * 256 - Top) * Step) >> 8);
+		for (; Row * 256 <= Bottom; ++Row, Pos += Step)
+			PlotH(Pos >> 8, Row, LINE_COL1);
+	}
+
+	PlotV(x, To - 128, LINE_COL2);
+	PlotV(x, To + 128, LINE_COL2);
+	PlotV(x, To, LINE_COL1);
+}
+
+int CScopeRenderer::ToRow(short Sample) const
+{
+	// Row of a sample in 24.8 fixed point, keeping one pixel off the edges
+	const int Half = m_iHeight << 7;
+	const int Offset = std::max(-Half + 256, std::min(Half - 256, -Sample * 256 / SAMPLE_SCALING));
+	return Half + Offset;
+}
+
+void CScopeRenderer::Blend(int x, int y, unsigned int Color, int Alpha)
+{
+	if (x < 0 || x >= m_iWidth || y < 0 || y >= m_iHeight)
+		return;
+
+	unsigned int &Pixel = m_Buffer[y * m_iWidth + x];
+	Pixel = MixChannel(Pixel, Color, Alpha, 0) | MixChannel(Pixel, Color, Alpha, 8) | MixChannel(Pixel, Color, Alpha, 16);
+}
+
+void CScopeRenderer::PlotV(int x, int y, unsigned int Color)
+{
+	// Covers two vertically adjacent pixels by the fraction of y
+	const int Frac = y & 0xFF;
+	Blend(x, y >> 8, Color, 256 - Frac);
+	Blend(x, (y >> 8) + 1, Color, Frac);
+}
+
+void CScopeRenderer::PlotH(int x, int y, unsigned int Color)
+{
+	// Covers two horizontally adjacent pixels by the fraction of x
+	const int Frac = x & 0xFF;
+	Blend(x >> 8, y, Color, 256 - Frac);
+	Blend((x >> 8) + 1, y, Color, Frac);
+}
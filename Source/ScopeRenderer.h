@@ -0,0 +1,67 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include <vector>
+
+// // // Renders the sample scope into a 32-bit pixel buffer
+//
+// This holds the drawing code of CVisualizerScope without any dependency on
+// the Windows GDI. Lines are drawn with integer Wu style antialiasing, rows are
+// in 24.8 fixed point. Pixels use the COLORREF layout (0x00BBGGRR).
+
+class CScopeRenderer
+{
+public:
+	CScopeRenderer();
+
+	void	Create(int Width, int Height);
+
+	// Draws one sample per column, Width samples in total
+	void	Render(const short *pSamples, bool bBlur);
+
+	const unsigned int *GetBuffer() const;
+	int		GetWidth() const;
+	int		GetHeight() const;
+
+	// Parts of Render
+	void	ClearBackground();
+	void	Blur();
+	void	DrawSegment(int x, int From, int To);
+
+	static const unsigned int LINE_COL1 = 0xFFFFFF;
+	static const unsigned int LINE_COL2 = 0x808080;
+
+private:
+	int		ToRow(short Sample) const;
+	void	Blend(int x, int y, unsigned int Color, int Alpha);
+	void	PlotV(int x, int y, unsigned int Color);
+	void	PlotH(int x, int y, unsigned int Color);
+
+private:
+	int		m_iWidth;
+	int		m_iHeight;
+	std::vector<unsigned int> m_Buffer;
+	std::vector<unsigned int> m_BlurBuffer;			// Output of Blur, swapped with m_Buffer
+	std::vector<unsigned int> m_Background;			// Color of each row
+};
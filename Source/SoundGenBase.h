@@ -0,0 +1,59 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+
+#pragma once
+
+// // // Interface used by the channel handlers to communicate with the player
+// that drives them; implemented by both the sound thread and the headless engine
+
+#include "Common.h"
+
+class CFamiTrackerDoc;
+class CSequence;
+struct stChanNote;
+
+enum render_end_t { 
+	SONG_TIME_LIMIT, 
+	SONG_LOOP_LIMIT 
+};
+
+class CSoundGenBase
+{
+public:
+	virtual ~CSoundGenBase() { }
+
+	virtual CFamiTrackerDoc *GetDocument() const = 0;
+	virtual int		GetDefaultInstrument() const = 0;
+
+	// Tracker playing
+	virtual void	EvaluateGlobalEffects(stChanNote *NoteData, int EffColumns) = 0;
+	virtual void	SetJumpPattern(int Pattern) = 0;
+	virtual void	SetSkipRow(int Row) = 0;
+
+	// Used by channels
+	virtual void	AddCycles(int Count) = 0;
+	virtual void	WriteRegister(uint16 Reg, uint8 Value) = 0;
+	virtual void	WriteExternalRegister(uint16 Reg, uint8 Value) = 0;
+	virtual void	RegisterKeyState(int Channel, int Note) = 0;
+	virtual void	SetSequencePlayPos(const CSequence *pSequence, int Pos) = 0;
+};
@@ -0,0 +1,71 @@
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** SnevenTracker is (C) HertzDevil 2016
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+// // // Lock-free triple buffer, hands the latest complete block of data from
+// one writer thread to one reader thread
+//
+// Each side owns one of the three buffers, the third one sits in the middle and
+// holds the most recently published block. Publishing and acquiring swap the
+// own buffer with the middle one, so neither side ever waits for the other and
+// the reader always gets the newest block, skipping older ones.
+
+template <class T>
+class CTripleBuffer
+{
+public:
+	CTripleBuffer() : m_iMiddle(1), m_iWrite(0), m_iRead(2) {}
+
+	// Writer side, the buffer may be resized freely before it is published
+	std::vector<T> &GetWriteBuffer() {
+		return m_Buffer[m_iWrite];
+	}
+
+	void Publish() {
+		m_iWrite = m_iMiddle.exchange(m_iWrite | FRESH, std::memory_order_acq_rel) & INDEX;
+	}
+
+	// Reader side, returns false if nothing was published since the last call
+	bool Acquire() {
+		if (!(m_iMiddle.load(std::memory_order_relaxed) & FRESH))
+			return false;
+		m_iRead = m_iMiddle.exchange(m_iRead, std::memory_order_acq_rel) & INDEX;
+		return true;
+	}
+
+	std::vector<T> &GetReadBuffer() {
+		return m_Buffer[m_iRead];
+	}
+
+private:
+	static const unsigned int INDEX = 0x03;
+	static const unsigned int FRESH = 0x04;		// The middle buffer has not been read
+
+	std::vector<T> m_Buffer[3];
+	std::atomic<unsigned int> m_iMiddle;
+	unsigned int m_iWrite;
+	unsigned int m_iRead;
+};
@@ -1,106 +1,131 @@
-/*
-** FamiTracker - NES/Famicom sound tracker
-** Copyright (C) 2005-2014  Jonathan Liss
-**
-** This program is free software; you can redistribute it and/or modify
-** it under the terms of the GNU General Public License as published by
-** the Free Software Foundation; either version 2 of the License, or
-** (at your option) any later version.
-**
-** This program is distributed in the hope that it will be useful, 
-** but WITHOUT ANY WARRANTY; without even the implied warranty of
-** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
-** Library General Public License for more details.  To obtain a 
-** copy of the GNU Library General Public License, write to the Free 
-** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
-**
-** Any permitted reproduction of these routines, in whole or in part,
-** must bear this legend.
-*/
-
-#include <windows.h>
-#include "WaveFile.h"
-
-bool CWaveFile::OpenFile(LPTSTR Filename, int SampleRate, int SampleSize, int Channels)
-{
-	// Open a wave file for streaming
-	//
-
-	int nError;
-
-	WaveFormat.wf.wFormatTag	  = WAVE_FORMAT_PCM;
-	WaveFormat.wf.nChannels		  = Channels;
-	WaveFormat.wf.nSamplesPerSec  = SampleRate;
-	WaveFormat.wf.nBlockAlign	  = (SampleSize / 8) * Channels;
-	WaveFormat.wf.nAvgBytesPerSec = SampleRate * (SampleSize / 8) * Channels;
-	WaveFormat.wBitsPerSample	  = SampleSize;
-
-	hmmioOut = mmioOpen(Filename, NULL, MMIO_ALLOCBUF | MMIO_READWRITE | MMIO_CREATE);
-
-	ckOutRIFF.fccType = mmioFOURCC('W', 'A', 'V', 'E');
-	ckOutRIFF.cksize  = 0;
-
-	nError = mmioCreateChunk(hmmioOut, &ckOutRIFF, MMIO_CREATERIFF);
-
-	if (nError != MMSYSERR_NOERROR)
-		return false;
-
-	ckOut.ckid	 = mmioFOURCC('f', 'm', 't', ' ');     
-	ckOut.cksize = sizeof(PCMWAVEFORMAT);
-
-	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
-
-	if (nError != MMSYSERR_NOERROR)
-		return false;
-
-	mmioWrite(hmmioOut, (HPSTR)&WaveFormat, sizeof(PCMWAVEFORMAT));
-	mmioAscend(hmmioOut, &ckOut, 0);
-
-	ckOut.ckid	 = mmioFOURCC('d', 'a', 't', 'a');
-	ckOut.cksize = 0;
-
-	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
-
-	if (nError != MMSYSERR_NOERROR)
-		return false;
-
-	mmioGetInfo(hmmioOut, &mmioinfoOut, 0);	
-
-	return true;
-}
-
-void CWaveFile::CloseFile()
-{
-	// Close the file
-	//
-
-	mmioinfoOut.dwFlags |= MMIO_DIRTY;
-	mmioSetInfo(hmmioOut, &mmioinfoOut, 0);
-
-	mmioAscend(hmmioOut, &ckOut, 0);
-	mmioAscend(hmmioOut, &ckOutRIFF, 0);
-
-	mmioSeek(hmmioOut, 0, SEEK_SET); 
-	mmioDescend(hmmioOut, &ckOutRIFF, NULL, 0);
-
-	mmioClose(hmmioOut, 0);
-}
-
-void CWaveFile::WriteWave(char *Data, int Size)
-{
-	// Save data to the file
-	//
-
-	int cT;
-	
-	for (cT = 0; cT < Size; cT++) {
-        if (mmioinfoOut.pchNext == mmioinfoOut.pchEndWrite) { 
-			mmioinfoOut.dwFlags |= MMIO_DIRTY; 
-			mmioAdvance(hmmioOut, &mmioinfoOut, MMIO_WRITE);
-		}
-
-		*((BYTE*)mmioinfoOut.pchNext) = *((BYTE*)Data + cT); 
-		mmioinfoOut.pchNext++;
-	}
-}
-
+/*
+** FamiTracker - NES/Famicom sound tracker
+** Copyright (C) 2005-2014  Jonathan Liss
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful, 
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+** Library General Public License for more details.  To obtain a 
+** copy of the GNU Library General Public License, write to the Free 
+** Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** Any permitted reproduction of these routines, in whole or in part,
+** must bear this legend.
+*/
+
+#include <windows.h>
+#include "WaveFile.h"
+
+bool CWaveFile::OpenFile(LPTSTR Filename, int SampleRate, int SampleSize, int Channels)
+{
+	// Open a wave file for streaming
+	//
+
+	int nError;
+
+	m_bFloat = (SampleSize == FLOAT_SAMPLE_SIZE);		// // //
+
+	WaveFormat.wFormatTag	   = m_bFloat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+	WaveFormat.nChannels	   = Channels;
+	WaveFormat.nSamplesPerSec  = SampleRate;
+	WaveFormat.nBlockAlign	   = (SampleSize / 8) * Channels;
+	WaveFormat.nAvgBytesPerSec = SampleRate * (SampleSize / 8) * Channels;
+	WaveFormat.wBitsPerSample  = SampleSize;
+	WaveFormat.cbSize		   = 0;
+
+	hmmioOut = mmioOpen(Filename, NULL, MMIO_ALLOCBUF | MMIO_READWRITE | MMIO_CREATE);
+
+	ckOutRIFF.fccType = mmioFOURCC('W', 'A', 'V', 'E');
+	ckOutRIFF.cksize  = 0;
+
+	nError = mmioCreateChunk(hmmioOut, &ckOutRIFF, MMIO_CREATERIFF);
+
+	if (nError != MMSYSERR_NOERROR)
+		return false;
+
+	ckOut.ckid	 = mmioFOURCC('f', 'm', 't', ' ');     
+	ckOut.cksize = m_bFloat ? sizeof(WAVEFORMATEX) : sizeof(PCMWAVEFORMAT);		// // // PCMWAVEFORMAT is a prefix
+
+	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
+
+	if (nError != MMSYSERR_NOERROR)
+		return false;
+
+	mmioWrite(hmmioOut, (HPSTR)&WaveFormat, ckOut.cksize);
+	mmioAscend(hmmioOut, &ckOut, 0);
+
+	// // // Non-PCM files store the number of sample frames, which is updated on closing
+	if (m_bFloat) {
+		ckOut.ckid	 = mmioFOURCC('f', 'a', 'c', 't');
+		ckOut.cksize = sizeof(DWORD);
+
+		nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
+
+		if (nError != MMSYSERR_NOERROR)
+			return false;
+
+		DWORD Frames = 0;
+		m_iFactOffset = mmioSeek(hmmioOut, 0, SEEK_CUR);
+		mmioWrite(hmmioOut, (HPSTR)&Frames, sizeof(Frames));
+		mmioAscend(hmmioOut, &ckOut, 0);
+	}
+
+	ckOut.ckid	 = mmioFOURCC('d', 'a', 't', 'a');
+	ckOut.cksize = 0;
+
+	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
+
+	if (nError != MMSYSERR_NOERROR)
+		return false;
+
+	mmioGetInfo(hmmioOut, &mmioinfoOut, 0);	
+
+	return true;
+}
+
+void CWaveFile::CloseFile()
+{
+	// Close the file
+	//
+
+	mmioinfoOut.dwFlags |= MMIO_DIRTY;
+	mmioSetInfo(hmmioOut, &mmioinfoOut, 0);
+
+	mmioAscend(hmmioOut, &ckOut, 0);
+	mmioAscend(hmmioOut, &ckOutRIFF, 0);
+
+	if (m_bFloat) {		// // //
+		DWORD Frames = ckOut.cksize / WaveFormat.nBlockAlign;
+		mmioSeek(hmmioOut, m_iFactOffset, SEEK_SET);
+		mmioWrite(hmmioOut, (HPSTR)&Frames, sizeof(Frames));
+	}
+
+	mmioSeek(hmmioOut, 0, SEEK_SET); 
+	mmioDescend(hmmioOut, &ckOutRIFF, NULL, 0);
+
+	mmioClose(hmmioOut, 0);
+}
+
+void CWaveFile::WriteWave(char *Data, int Size)
+{
+	// Save data to the file
+	//
+
+	int cT;
+	
+	for (cT = 0; cT < Size; cT++) {
+        if (mmioinfoOut.pchNext == mmioinfoOut.pchEndWrite) { 
+			mmioinfoOut.dwFlags |= MMIO_DIRTY; 
+			mmioAdvance(hmmioOut, &mmioinfoOut, MMIO_WRITE);
+		}
+
+		*((BYTE*)mmioinfoOut.pchNext) = *((BYTE*)Data + cT); 
+		mmioinfoOut.pchNext++;
+	}
+}
+
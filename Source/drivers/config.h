@@ -1,2 +1,2 @@
-const unsigned int VIBRATO_TABLE_LOCATION_NONE = 0x156d;
-// // //
+const unsigned int VIBRATO_TABLE_LOCATION_NONE = 0x156d;
+// // //
@@ -1,302 +1,302 @@
-const unsigned char DRIVER_2A03[] = {
-	0x46, 0x54, 0x44, 0x52, 0x56, 0x20, 0x02, 0x0A, 0x4C, 0x0E, 0x00, 0x4C, 0x94, 0x02, 0x0A, 0x20, 0x88, 0x00, 0xA9, 0x00, 0xA2, 
-	0x0B, 0x9D, 0x00, 0x40, 0xCA, 0xD0, 0xFA, 0xA2, 0x06, 0x9D, 0x0D, 0x40, 0xCA, 0xD0, 0xFA, 0xA9, 0x30, 0x8D, 0x0C, 0x40, 0xA9, 
-	0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x08, 0x8D, 0x01, 0x40, 0x8D, 0x05, 0x40, 0xA9, 0xC0, 0x8D, 0x17, 0x40, 0xA9, 0x40, 0x8D, 0x17, 
-	0x40, 0xA9, 0xFF, 0x8D, 0x09, 0x02, 0x8D, 0xF5, 0x02, 0x8D, 0xF1, 0x02, 0xA9, 0x00, 0xAA, 0x9D, 0x43, 0x02, 0x9D, 0xBD, 0x02, 
-	0x9D, 0xC1, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0xE8, 0xE0, 0x04, 0xD0, 0xE6, 0xAD, 
-	0x08, 0x02, 0x29, 0x02, 0xF0, 0x0E, 0xA9, 0x30, 0xA2, 0x00, 0x9D, 0xD1, 0x02, 0xE8, 0xE0, 0x04, 0xD0, 0xF8, 0xA9, 0x00, 0x8D, 
-	0x47, 0x02, 0xA2, 0x04, 0xA9, 0x80, 0x9D, 0x34, 0x02, 0x60, 0x48, 0xAD, 0x6D, 0x16, 0x85, 0x06, 0xAD, 0x6E, 0x16, 0x85, 0x07, 
-	0xA0, 0x00, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x99, 0x00, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x99, 0x00, 0x02, 0xC8, 
-	0xC0, 0x08, 0xD0, 0xE9, 0xB1, 0x06, 0x8D, 0x08, 0x02, 0xC8, 0xE0, 0x01, 0xF0, 0x17, 0xB1, 0x06, 0xC8, 0x8D, 0x19, 0x02, 0xB1, 
-	0x06, 0xC8, 0x8D, 0x1A, 0x02, 0xA9, 0x00, 0x85, 0x0C, 0xA9, 0x00, 0x85, 0x0D, 0x4C, 0xE3, 0x00, 0xC8, 0xC8, 0xB1, 0x06, 0xC8, 
-	0x8D, 0x19, 0x02, 0xB1, 0x06, 0xC8, 0x8D, 0x1A, 0x02, 0xA9, 0x00, 0x85, 0x0C, 0xA9, 0x00, 0x85, 0x0D, 0x68, 0xA8, 0x20, 0x34, 
-	0x01, 0xA2, 0x01, 0x8E, 0x11, 0x02, 0xCA, 0xA9, 0x7F, 0x9D, 0x39, 0x02, 0xA9, 0x80, 0x9D, 0x4D, 0x02, 0xA9, 0x00, 0x9D, 0xD9, 
-	0x02, 0x9D, 0xE5, 0x02, 0x9D, 0xBD, 0x02, 0x9D, 0x6C, 0x02, 0x9D, 0x52, 0x02, 0x9D, 0xCD, 0x02, 0x9D, 0x34, 0x02, 0xE8, 0xE0, 
-	0x04, 0xD0, 0xDA, 0xA2, 0xFF, 0x8E, 0x73, 0x02, 0x8E, 0x74, 0x02, 0xA9, 0x00, 0x8D, 0xF2, 0x02, 0xE8, 0x8E, 0x13, 0x02, 0x20, 
-	0x71, 0x01, 0x20, 0xFC, 0x07, 0xA9, 0x00, 0x8D, 0x15, 0x02, 0x8D, 0x16, 0x02, 0x60, 0xAD, 0x00, 0x02, 0x85, 0x04, 0xAD, 0x01, 
-	0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 0xA9, 0x00, 
-	0xAA, 0xA8, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x8D, 0x0A, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x8D, 0x0B, 0x02, 0xC8, 
-	0xB1, 0x06, 0x9D, 0x0C, 0x02, 0xC8, 0xE8, 0xE0, 0x06, 0xD0, 0xF5, 0x60, 0x48, 0xAD, 0x10, 0x02, 0xF0, 0x03, 0x20, 0xD0, 0x13, 
-	0x68, 0x0A, 0x18, 0x6D, 0x0A, 0x02, 0x85, 0x04, 0xA9, 0x00, 0xA8, 0xAA, 0x6D, 0x0B, 0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 
-	0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 0xA0, 0x00, 0x8E, 0x12, 0x02, 0x18, 0xB1, 0x06, 0x6D, 
-	0x6D, 0x16, 0x9D, 0x25, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x9D, 0x2A, 0x02, 0xC8, 0xA9, 0x00, 0x9D, 0x52, 0x02, 0x9D, 
-	0x3E, 0x02, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xDB, 0xAD, 0x08, 0x02, 0x29, 0x01, 0xF0, 0x0D, 0xA2, 0x00, 
-	0xB1, 0x06, 0x9D, 0x2F, 0x02, 0xC8, 0xE8, 0xE0, 0x05, 0xD0, 0xF5, 0xA9, 0x00, 0x8D, 0x20, 0x02, 0x8D, 0x21, 0x02, 0xAD, 0x22, 
-	0x02, 0xD0, 0x01, 0x60, 0x8D, 0x12, 0x02, 0xA2, 0x00, 0xAD, 0x12, 0x02, 0x85, 0x01, 0xA9, 0x00, 0x9D, 0x52, 0x02, 0xA0, 0x00, 
-	0xBD, 0x25, 0x02, 0x85, 0x0A, 0xBD, 0x2A, 0x02, 0x85, 0x0B, 0xBD, 0x52, 0x02, 0xF0, 0x06, 0xDE, 0x52, 0x02, 0x4C, 0x26, 0x02, 
-	0xB1, 0x0A, 0x30, 0x32, 0xBD, 0x57, 0x02, 0xC9, 0xFF, 0xD0, 0x0A, 0xC8, 0xB1, 0x0A, 0xC8, 0x9D, 0x52, 0x02, 0x4C, 0x26, 0x02, 
-	0xC8, 0x9D, 0x52, 0x02, 0x18, 0x98, 0x65, 0x0A, 0x9D, 0x25, 0x02, 0xA9, 0x00, 0x65, 0x0B, 0x9D, 0x2A, 0x02, 0xC6, 0x01, 0xD0, 
-	0xBE, 0xE8, 0xE0, 0x05, 0xD0, 0xAF, 0xA9, 0x00, 0x8D, 0x22, 0x02, 0x60, 0xC9, 0x80, 0xF0, 0x38, 0xC9, 0x82, 0xF0, 0x21, 0xC9, 
-	0x84, 0xF0, 0x27, 0x48, 0xC9, 0x8E, 0xF0, 0x13, 0xC9, 0x92, 0xF0, 0x0F, 0xC9, 0xA2, 0xF0, 0x0B, 0x29, 0xF0, 0xC9, 0xF0, 0xF0, 
-	0x05, 0xC9, 0xE0, 0xF0, 0x23, 0xC8, 0xC8, 0x68, 0x4C, 0x02, 0x02, 0xC8, 0xB1, 0x0A, 0xC8, 0x9D, 0x57, 0x02, 0x4C, 0x02, 0x02, 
-	0xC8, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0x4C, 0x02, 0x02, 0xC8, 0xB1, 0x0A, 0xC8, 0x20, 0x4E, 0x0E, 0x4C, 0x02, 0x02, 0xC8, 0x68, 
-	0x29, 0x0F, 0x0A, 0x20, 0x4E, 0x0E, 0x4C, 0x02, 0x02, 0xAD, 0x11, 0x02, 0xD0, 0x01, 0x60, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 
-	0x13, 0x38, 0xE9, 0x01, 0x9D, 0x3E, 0x02, 0xD0, 0x0B, 0x20, 0xCF, 0x03, 0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 
-	0xE0, 0x05, 0xD0, 0xE3, 0xAD, 0x16, 0x02, 0x30, 0x08, 0x0D, 0x15, 0x02, 0xF0, 0x03, 0x4C, 0x77, 0x03, 0xA9, 0x00, 0x8D, 0xF3, 
-	0x02, 0xAD, 0x14, 0x02, 0xF0, 0x27, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 0x10, 0xA9, 0x00, 0x9D, 0x3E, 0x02, 0x20, 0xCF, 0x03, 
-	0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xE6, 0xA9, 0x00, 0x8D, 0x14, 0x02, 0xAD, 0x13, 0x02, 
-	0x20, 0x71, 0x01, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 0x08, 0xA9, 0x00, 0x9D, 0x3E, 0x02, 0x20, 0xCF, 0x03, 0x20, 0xCF, 0x03, 
-	0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xE3, 0xAD, 0x20, 0x02, 0xF0, 0x0E, 0x38, 0xE9, 0x01, 
-	0x8D, 0x13, 0x02, 0xA9, 0x01, 0x8D, 0x14, 0x02, 0x4C, 0x74, 0x03, 0xAD, 0x21, 0x02, 0xF0, 0x21, 0x38, 0xE9, 0x01, 0x8D, 0x22, 
-	0x02, 0xA9, 0x01, 0x8D, 0x14, 0x02, 0xEE, 0x13, 0x02, 0xAD, 0x13, 0x02, 0xCD, 0x0C, 0x02, 0xF0, 0x03, 0x4C, 0x74, 0x03, 0xA9, 
-	0x00, 0x8D, 0x13, 0x02, 0x4C, 0x74, 0x03, 0xEE, 0x12, 0x02, 0xAD, 0x12, 0x02, 0xCD, 0x0D, 0x02, 0xD0, 0x1A, 0xEE, 0x13, 0x02, 
-	0xAD, 0x13, 0x02, 0xCD, 0x0C, 0x02, 0xF0, 0x06, 0x8D, 0x14, 0x02, 0x4C, 0x74, 0x03, 0xA2, 0x00, 0x8E, 0x13, 0x02, 0xE8, 0x8E, 
-	0x14, 0x02, 0x20, 0xD5, 0x07, 0x38, 0xAD, 0x15, 0x02, 0xED, 0x17, 0x02, 0x8D, 0x15, 0x02, 0xAD, 0x16, 0x02, 0xED, 0x18, 0x02, 
-	0x8D, 0x16, 0x02, 0xA2, 0x00, 0xBD, 0x43, 0x02, 0xF0, 0x20, 0x38, 0xE9, 0x01, 0x9D, 0x43, 0x02, 0xD0, 0x18, 0x9D, 0x34, 0x02, 
-	0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xF0, 0x0E, 0xA9, 0x00, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 
-	0xE8, 0xE0, 0x05, 0xD0, 0xD6, 0xA2, 0x00, 0x20, 0x6F, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x03, 0x20, 0x25, 0x0C, 0x20, 0x4E, 0x09, 
-	0xE8, 0xE0, 0x04, 0xD0, 0xED, 0x20, 0x36, 0x10, 0x60, 0xBC, 0x52, 0x02, 0xF0, 0x06, 0x88, 0x98, 0x9D, 0x52, 0x02, 0x60, 0x8C, 
-	0x1E, 0x02, 0xBD, 0x2F, 0x02, 0xF0, 0x03, 0x20, 0xD0, 0x13, 0xA9, 0x0F, 0x8D, 0x1D, 0x02, 0xBD, 0x25, 0x02, 0x85, 0x0A, 0xBD, 
-	0x2A, 0x02, 0x85, 0x0B, 0xB1, 0x0A, 0x10, 0x03, 0x4C, 0xCE, 0x04, 0xF0, 0x69, 0xC9, 0x7F, 0xD0, 0x03, 0x4C, 0x8A, 0x04, 0xC9, 
-	0x7E, 0xD0, 0x03, 0x4C, 0x69, 0x04, 0x9D, 0x34, 0x02, 0x20, 0x05, 0x07, 0xBD, 0x43, 0x02, 0x30, 0x05, 0xA9, 0x00, 0x9D, 0x43, 
-	0x02, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xD0, 0x03, 0x4C, 0xF6, 0x04, 0x20, 0x3C, 0x0E, 0xA9, 0x00, 0x9D, 0x48, 0x02, 0xAD, 0x1D, 
-	0x02, 0x9D, 0x9D, 0x02, 0xA9, 0x00, 0x9D, 0xCD, 0x02, 0xBD, 0xA1, 0x02, 0x29, 0xF0, 0x9D, 0xA1, 0x02, 0x4A, 0x4A, 0x4A, 0x4A, 
-	0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0xBD, 0xBD, 0x02, 0xC9, 0x06, 0xF0, 0x04, 0xC9, 0x08, 0xD0, 0x05, 0xA9, 0x00, 0x9D, 0xBD, 
-	0x02, 0xE0, 0x02, 0x90, 0x03, 0x4C, 0xF6, 0x04, 0xA9, 0x00, 0x9D, 0x71, 0x02, 0x4C, 0xF6, 0x04, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 
-	0xD0, 0x08, 0xA9, 0xFF, 0x9D, 0x34, 0x02, 0x4C, 0xF6, 0x04, 0xBD, 0x48, 0x02, 0xC9, 0x01, 0xF0, 0xE7, 0xA9, 0x01, 0x9D, 0x48, 
-	0x02, 0x20, 0xBF, 0x0D, 0x4C, 0xF6, 0x04, 0xA9, 0x00, 0x9D, 0x34, 0x02, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xD0, 0x03, 0x4C, 0xF6, 
-	0x04, 0xA9, 0x00, 0x9D, 0x9D, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0xE0, 0x02, 0xB0, 
-	0x05, 0xA9, 0xFF, 0x9D, 0x73, 0x02, 0x4C, 0xF6, 0x04, 0x68, 0x0A, 0x0A, 0x0A, 0x29, 0x78, 0x9D, 0x39, 0x02, 0xC8, 0x4C, 0xF4, 
-	0x03, 0x68, 0x29, 0x0F, 0x0A, 0x20, 0x4E, 0x0E, 0xC8, 0x4C, 0xF4, 0x03, 0x48, 0x29, 0xF0, 0xC9, 0xF0, 0xF0, 0xE1, 0xC9, 0xE0, 
-	0xF0, 0xEA, 0x68, 0x29, 0x7F, 0x84, 0x00, 0xA8, 0xB9, 0x29, 0x05, 0x85, 0x06, 0xC8, 0xB9, 0x29, 0x05, 0x85, 0x07, 0xA4, 0x00, 
-	0xC8, 0x6C, 0x06, 0x00, 0x9D, 0x52, 0x02, 0x4C, 0x03, 0x05, 0xBD, 0x57, 0x02, 0xC9, 0xFF, 0xD0, 0xF3, 0xC8, 0xB1, 0x0A, 0x9D, 
-	0x52, 0x02, 0x18, 0xC8, 0x98, 0x65, 0x0A, 0x9D, 0x25, 0x02, 0xA9, 0x00, 0x65, 0x0B, 0x9D, 0x2A, 0x02, 0xAD, 0x1E, 0x02, 0xF0, 
-	0x0B, 0x9D, 0x71, 0x02, 0xA9, 0x00, 0x8D, 0x1E, 0x02, 0x9D, 0x73, 0x02, 0x60, 0xB1, 0x0A, 0x48, 0xC8, 0x68, 0x60, 0x63, 0x05, 
-	0x6C, 0x05, 0x75, 0x05, 0x7D, 0x05, 0x89, 0x05, 0x95, 0x05, 0x9E, 0x05, 0xA7, 0x05, 0xB2, 0x05, 0xF6, 0x05, 0xCC, 0x05, 0xDA, 
-	0x05, 0xBE, 0x05, 0xE8, 0x05, 0x10, 0x06, 0x35, 0x06, 0x51, 0x06, 0x5A, 0x06, 0x75, 0x06, 0x62, 0x06, 0x07, 0x06, 0x6C, 0x06, 
-	0x89, 0x06, 0x92, 0x06, 0xA0, 0x06, 0xAE, 0x06, 0xB7, 0x06, 0xC2, 0x06, 0xD6, 0x06, 0x20, 0x23, 0x05, 0x20, 0x4E, 0x0E, 0x4C, 
-	0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0x57, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
-	0x05, 0x8D, 0x0E, 0x02, 0x20, 0xFC, 0x07, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x0F, 0x02, 0x20, 0xFC, 0x07, 0x4C, 0xF4, 
-	0x03, 0x20, 0x23, 0x05, 0x8D, 0x20, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x21, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
-	0x05, 0xA9, 0x00, 0x8D, 0x11, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x1D, 0x02, 0x9D, 0x9D, 0x02, 0x4C, 0xF4, 0x03, 
-	0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x02, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 
-	0x03, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x04, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 
-	0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x01, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0x00, 0x9D, 0xC1, 0x02, 0x9D, 0xBD, 
-	0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x1E, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
-	0x05, 0x48, 0xBD, 0xD9, 0x02, 0xD0, 0x0C, 0xAD, 0x08, 0x02, 0x29, 0x02, 0xF0, 0x02, 0xA9, 0x30, 0x9D, 0xD1, 0x02, 0x68, 0x48, 
-	0x29, 0xF0, 0x9D, 0xD5, 0x02, 0x68, 0x29, 0x0F, 0x9D, 0xD9, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x48, 0x29, 0xF0, 0x9D, 
-	0xE1, 0x02, 0x68, 0x29, 0x0F, 0x9D, 0xE5, 0x02, 0xC9, 0x00, 0xF0, 0x03, 0x4C, 0xF4, 0x03, 0x9D, 0xDD, 0x02, 0x4C, 0xF4, 0x03, 
-	0x20, 0x23, 0x05, 0x9D, 0x4D, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0x80, 0x9D, 0x4D, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 
-	0x3E, 0x02, 0x88, 0x4C, 0x03, 0x05, 0x20, 0x23, 0x05, 0x8D, 0xF1, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xA1, 0x02, 
-	0x18, 0x0A, 0x0A, 0x0A, 0x0A, 0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF2, 0x02, 0x4C, 
-	0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x05, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 
-	0x02, 0xA9, 0x07, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0x6C, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 
-	0x09, 0x80, 0x9D, 0x43, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF3, 0x02, 0xAD, 0xF4, 0x02, 0xD0, 0x06, 0xAD, 0xF3, 
-	0x02, 0x8D, 0xF4, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF5, 0x02, 0x4C, 0xF4, 0x03, 0x38, 0xE9, 0x01, 0xE0, 0x03, 
-	0xF0, 0x12, 0x0A, 0x84, 0x00, 0xA8, 0xB1, 0x0C, 0x9D, 0x60, 0x02, 0xC8, 0xB1, 0x0C, 0x9D, 0x5C, 0x02, 0xA4, 0x00, 0x60, 0x29, 
-	0x0F, 0x09, 0x10, 0x9D, 0x60, 0x02, 0xA9, 0x00, 0x9D, 0x5C, 0x02, 0x60, 0x38, 0xE9, 0x01, 0x48, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 
-	0xD0, 0x03, 0x4C, 0x7B, 0x07, 0x68, 0xE0, 0x03, 0xF0, 0x31, 0x0A, 0x84, 0x00, 0xA8, 0xBD, 0xBD, 0x02, 0xC9, 0x02, 0xD0, 0x22, 
-	0xB1, 0x0C, 0x9D, 0xC9, 0x02, 0xC8, 0xB1, 0x0C, 0x9D, 0xC5, 0x02, 0xA4, 0x00, 0xBD, 0x60, 0x02, 0x1D, 0x5C, 0x02, 0xD0, 0x0C, 
-	0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x4C, 0xEA, 0x06, 0x60, 0x09, 0x10, 0x48, 0xBD, 
-	0xBD, 0x02, 0xC9, 0x02, 0xD0, 0x1E, 0x68, 0x9D, 0xC9, 0x02, 0xA9, 0x00, 0x9D, 0xC5, 0x02, 0xBD, 0x60, 0x02, 0x1D, 0x5C, 0x02, 
-	0xD0, 0x0C, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x68, 0x9D, 0x60, 0x02, 0xA9, 0x00, 
-	0x9D, 0x5C, 0x02, 0x60, 0x18, 0x68, 0x48, 0x0A, 0x6D, 0x04, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x6D, 0x05, 0x02, 0x85, 0x05, 0x18, 
-	0x68, 0x65, 0x04, 0x85, 0x04, 0xA9, 0x00, 0x65, 0x05, 0x85, 0x05, 0x84, 0x00, 0xA0, 0x00, 0xB1, 0x04, 0x8D, 0xF0, 0x02, 0xC8, 
-	0xAD, 0xF1, 0x02, 0x10, 0x07, 0xB1, 0x04, 0x30, 0x03, 0x8D, 0xF1, 0x02, 0xC8, 0xB1, 0x04, 0xA8, 0xAD, 0x06, 0x02, 0x85, 0x04, 
-	0xAD, 0x07, 0x02, 0x85, 0x05, 0xB1, 0x04, 0x8D, 0xED, 0x02, 0xC8, 0xB1, 0x04, 0x8D, 0xEE, 0x02, 0xC8, 0xB1, 0x04, 0x8D, 0xEF, 
-	0x02, 0xA4, 0x00, 0xAD, 0xF3, 0x02, 0x8D, 0xF4, 0x02, 0x60, 0x18, 0xAD, 0x15, 0x02, 0x6D, 0x19, 0x02, 0x8D, 0x15, 0x02, 0xAD, 
-	0x16, 0x02, 0x6D, 0x1A, 0x02, 0x8D, 0x16, 0x02, 0x38, 0xAD, 0x15, 0x02, 0xED, 0x1B, 0x02, 0x8D, 0x15, 0x02, 0xAD, 0x16, 0x02, 
-	0xED, 0x1C, 0x02, 0x8D, 0x16, 0x02, 0x60, 0x98, 0x48, 0xAD, 0x0F, 0x02, 0x85, 0x10, 0xA9, 0x00, 0x85, 0x11, 0xA0, 0x03, 0x06, 
-	0x10, 0x26, 0x11, 0x88, 0xD0, 0xF9, 0xA5, 0x10, 0x85, 0x0E, 0xA5, 0x11, 0xA8, 0x06, 0x10, 0x26, 0x11, 0x18, 0xA5, 0x0E, 0x65, 
-	0x10, 0x85, 0x0E, 0x98, 0x65, 0x11, 0x85, 0x0F, 0xAD, 0x0E, 0x02, 0x85, 0x10, 0xA9, 0x00, 0x85, 0x11, 0x20, 0x4A, 0x08, 0xA5, 
-	0x0E, 0x8D, 0x17, 0x02, 0xA5, 0x0F, 0x8D, 0x18, 0x02, 0xA5, 0x12, 0x8D, 0x1B, 0x02, 0xA5, 0x13, 0x8D, 0x1C, 0x02, 0x68, 0xA8, 
-	0x60, 0xA9, 0x00, 0x85, 0x13, 0xA0, 0x10, 0x06, 0x0E, 0x26, 0x0F, 0x2A, 0x26, 0x13, 0x48, 0xC5, 0x10, 0xA5, 0x13, 0xE5, 0x11, 
-	0x90, 0x08, 0x85, 0x13, 0x68, 0xE5, 0x10, 0x48, 0xE6, 0x0E, 0x68, 0x88, 0xD0, 0xE4, 0x85, 0x12, 0x60, 0xBD, 0x6C, 0x02, 0xF0, 
-	0x2A, 0xBD, 0x6C, 0x02, 0x29, 0x0F, 0x85, 0x00, 0x38, 0xBD, 0x39, 0x02, 0xE5, 0x00, 0x10, 0x02, 0xA9, 0x00, 0x9D, 0x39, 0x02, 
-	0xBD, 0x6C, 0x02, 0x4A, 0x4A, 0x4A, 0x4A, 0x85, 0x00, 0x18, 0xBD, 0x39, 0x02, 0x65, 0x00, 0x10, 0x02, 0xA9, 0x7F, 0x9D, 0x39, 
-	0x02, 0xBD, 0xBD, 0x02, 0xF0, 0x31, 0xC9, 0x01, 0xF0, 0x1B, 0xC9, 0x02, 0xF0, 0x1A, 0xC9, 0x03, 0xF0, 0x19, 0xC9, 0x06, 0xF0, 
-	0x18, 0xC9, 0x08, 0xF0, 0x17, 0xC9, 0x05, 0xF0, 0x16, 0xC9, 0x07, 0xF0, 0x12, 0x4C, 0x1B, 0x0A, 0x4C, 0xCE, 0x0A, 0x4C, 0x90, 
-	0x09, 0x4C, 0x04, 0x0A, 0x4C, 0x6A, 0x0A, 0x4C, 0x90, 0x0A, 0x4C, 0xD5, 0x08, 0x60, 0xBD, 0x60, 0x02, 0x48, 0xBD, 0x5C, 0x02, 
-	0x48, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0x85, 0x00, 0xBD, 0xBD, 0x02, 0xC9, 0x05, 0xF0, 0x11, 0xBD, 0x34, 0x02, 0x38, 0xE5, 0x00, 
-	0x10, 0x02, 0xA9, 0x01, 0xD0, 0x02, 0xA9, 0x01, 0x4C, 0x08, 0x09, 0xBD, 0x34, 0x02, 0x18, 0x65, 0x00, 0xC9, 0x60, 0x90, 0x02, 
-	0xA9, 0x60, 0x9D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xBD, 0x60, 0x02, 0x9D, 0xC9, 0x02, 0xBD, 0x5C, 0x02, 0x9D, 0xC5, 0x02, 0xBD, 
-	0xC1, 0x02, 0x4A, 0x4A, 0x4A, 0x09, 0x01, 0x9D, 0xC1, 0x02, 0x68, 0x9D, 0x5C, 0x02, 0x68, 0x9D, 0x60, 0x02, 0x18, 0xBD, 0xBD, 
-	0x02, 0x69, 0x01, 0x9D, 0xBD, 0x02, 0xE0, 0x03, 0xD0, 0x11, 0xC9, 0x06, 0xF0, 0x08, 0xA9, 0x06, 0x9D, 0xBD, 0x02, 0x4C, 0x9E, 
-	0x08, 0xA9, 0x08, 0x9D, 0xBD, 0x02, 0x4C, 0x9E, 0x08, 0xBD, 0x60, 0x02, 0x9D, 0x64, 0x02, 0xBD, 0x5C, 0x02, 0x9D, 0x68, 0x02, 
-	0xBD, 0x4D, 0x02, 0xC9, 0x80, 0xF0, 0x28, 0xBD, 0x34, 0x02, 0xF0, 0x23, 0x18, 0xBD, 0x64, 0x02, 0x69, 0x80, 0x9D, 0x64, 0x02, 
-	0xBD, 0x68, 0x02, 0x69, 0x00, 0x9D, 0x68, 0x02, 0x38, 0xBD, 0x64, 0x02, 0xFD, 0x4D, 0x02, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 
-	0xE9, 0x00, 0x9D, 0x68, 0x02, 0x20, 0x1A, 0x0B, 0x20, 0xE7, 0x0B, 0x60, 0xBD, 0xC1, 0x02, 0xF0, 0x6C, 0xBD, 0xC9, 0x02, 0x1D, 
-	0xC5, 0x02, 0xF0, 0x64, 0xBD, 0x5C, 0x02, 0xDD, 0xC5, 0x02, 0x90, 0x2F, 0xD0, 0x0D, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 
-	0x25, 0xD0, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x4E, 0x0A, 0xDD, 0xC5, 0x02, 
-	0x90, 0x30, 0x30, 0x2E, 0xD0, 0x38, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 0x24, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x85, 
-	0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x32, 0x0A, 0xBD, 0xC5, 0x02, 0xDD, 0x5C, 0x02, 0x90, 0x0D, 0xD0, 0x17, 0xBD, 0xC9, 0x02, 
-	0xDD, 0x60, 0x02, 0x90, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x4C, 
-	0xD4, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x0F, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x4E, 0x0A, 0x20, 0xDB, 
-	0x0F, 0x4C, 0xD4, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x0F, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x32, 0x0A, 
-	0x20, 0xDB, 0x0F, 0x4C, 0xD4, 0x08, 0x18, 0xBD, 0x60, 0x02, 0x65, 0x04, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0x65, 0x05, 0x9D, 
-	0x5C, 0x02, 0x90, 0x08, 0xA9, 0xFF, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x38, 0xBD, 0x60, 0x02, 0xE5, 0x04, 0x9D, 0x60, 
-	0x02, 0xBD, 0x5C, 0x02, 0xE5, 0x05, 0x9D, 0x5C, 0x02, 0xB0, 0x08, 0xA9, 0x00, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x38, 
-	0xBD, 0x60, 0x02, 0xFD, 0xC1, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0xE9, 0x00, 0x9D, 0x5C, 0x02, 0x30, 0x36, 0xDD, 0xC5, 
-	0x02, 0x90, 0x31, 0xD0, 0x46, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 0x27, 0x4C, 0xD4, 0x08, 0x18, 0xBD, 0x60, 0x02, 0x7D, 
-	0xC1, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0x69, 0x00, 0x9D, 0x5C, 0x02, 0xDD, 0xC5, 0x02, 0x90, 0x24, 0xD0, 0x0B, 0xBD, 
-	0x60, 0x02, 0xDD, 0xC9, 0x02, 0xB0, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 
-	0x02, 0xA9, 0x00, 0x9D, 0xBD, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xCD, 0x02, 0xC9, 0x01, 0xF0, 
-	0x10, 0xC9, 0x02, 0xF0, 0x2D, 0xBD, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xFE, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x4A, 
-	0x4A, 0x4A, 0x4A, 0x18, 0x7D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0xD0, 0x06, 0x9D, 0xCD, 0x02, 0x4C, 
-	0xD4, 0x08, 0xFE, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0x18, 0x7D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xA9, 
-	0x00, 0x9D, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xD9, 0x02, 0xD0, 0x01, 0x60, 0x18, 0x7D, 0xD1, 0x02, 0x29, 0x3F, 0x9D, 0xD1, 
-	0x02, 0xC9, 0x10, 0x90, 0x1C, 0xC9, 0x20, 0x90, 0x28, 0xC9, 0x30, 0x90, 0x3E, 0x38, 0xE9, 0x30, 0x85, 0x00, 0x38, 0xA9, 0x0F, 
-	0xE5, 0x00, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x4C, 0x7D, 0x0B, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x85, 0x04, 
-	0xA9, 0x00, 0x85, 0x05, 0x4C, 0x92, 0x0B, 0x38, 0xE9, 0x10, 0x85, 0x00, 0x38, 0xA9, 0x0F, 0xE5, 0x00, 0x1D, 0xD5, 0x02, 0xA8, 
-	0xB9, 0x6D, 0x15, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x4C, 0x92, 0x0B, 0x38, 0xE9, 0x20, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 
-	0x15, 0x49, 0xFF, 0x85, 0x04, 0xA9, 0xFF, 0x85, 0x05, 0x18, 0xA5, 0x04, 0x69, 0x01, 0x85, 0x04, 0xA5, 0x05, 0x69, 0x00, 0x85, 
-	0x05, 0xAD, 0x08, 0x02, 0x29, 0x02, 0xF0, 0x1B, 0xA9, 0x0F, 0x18, 0x7D, 0xD5, 0x02, 0xA8, 0x18, 0xB9, 0x6D, 0x15, 0x69, 0x01, 
-	0x65, 0x04, 0x85, 0x04, 0xA5, 0x05, 0x69, 0x00, 0x85, 0x05, 0x46, 0x05, 0x66, 0x04, 0xBD, 0xE8, 0x13, 0xC9, 0x0A, 0xF0, 0x1A, 
-	0xC9, 0x04, 0xF0, 0x16, 0xC9, 0x06, 0xF0, 0x12, 0x38, 0xBD, 0x64, 0x02, 0xE5, 0x04, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 0xE5, 
-	0x05, 0x9D, 0x68, 0x02, 0x60, 0x18, 0xBD, 0x64, 0x02, 0x65, 0x04, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 0x65, 0x05, 0x9D, 0x68, 
-	0x02, 0x60, 0xBD, 0xE5, 0x02, 0xD0, 0x06, 0xA9, 0x00, 0x9D, 0xE9, 0x02, 0x60, 0x18, 0x7D, 0xDD, 0x02, 0x29, 0x3F, 0x9D, 0xDD, 
-	0x02, 0x4A, 0xC9, 0x10, 0x90, 0x17, 0x38, 0xE9, 0x10, 0x85, 0x00, 0x38, 0xA9, 0x0F, 0xE5, 0x00, 0x1D, 0xE1, 0x02, 0xA8, 0xB9, 
-	0x6D, 0x15, 0x4A, 0x85, 0x00, 0x4C, 0x21, 0x0C, 0x1D, 0xE1, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x4A, 0x85, 0x00, 0x9D, 0xE9, 0x02, 
-	0x60, 0xBD, 0x79, 0x02, 0xF0, 0x1A, 0x85, 0x07, 0xBD, 0x75, 0x02, 0x85, 0x06, 0xBD, 0xA5, 0x02, 0xC9, 0xFF, 0xF0, 0x0C, 0x20, 
-	0x72, 0x0D, 0x9D, 0xA5, 0x02, 0xAD, 0x24, 0x02, 0x9D, 0x9D, 0x02, 0xBD, 0x81, 0x02, 0xF0, 0x7B, 0x85, 0x07, 0xBD, 0x7D, 0x02, 
-	0x85, 0x06, 0xBD, 0xA9, 0x02, 0xC9, 0xFF, 0xF0, 0x57, 0x20, 0x72, 0x0D, 0x9D, 0xA9, 0x02, 0xBD, 0x34, 0x02, 0xF0, 0x62, 0xA0, 
-	0x03, 0xB1, 0x06, 0xF0, 0x28, 0xC9, 0x01, 0xF0, 0x1B, 0x18, 0xBD, 0x34, 0x02, 0x6D, 0x24, 0x02, 0xC9, 0x01, 0x90, 0x08, 0xC9, 
-	0x5F, 0x90, 0x06, 0xA9, 0x5F, 0xD0, 0x02, 0xA9, 0x01, 0x9D, 0x34, 0x02, 0x4C, 0xA3, 0x0C, 0xAD, 0x24, 0x02, 0x18, 0x69, 0x01, 
-	0x4C, 0xA3, 0x0C, 0x18, 0xBD, 0x34, 0x02, 0x6D, 0x24, 0x02, 0xF0, 0x02, 0x10, 0x02, 0xA9, 0x01, 0xC9, 0x60, 0x90, 0x02, 0xA9, 
-	0x60, 0x20, 0xDF, 0x06, 0xA9, 0x01, 0x9D, 0xB9, 0x02, 0x4C, 0xC4, 0x0C, 0xA0, 0x03, 0xB1, 0x06, 0xF0, 0x10, 0xBD, 0xB9, 0x02, 
-	0xF0, 0x0B, 0xBD, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xA9, 0x00, 0x9D, 0xB9, 0x02, 0xBD, 0x89, 0x02, 0xF0, 0x32, 0x85, 0x07, 0xBD, 
-	0x85, 0x02, 0x85, 0x06, 0xBD, 0xAD, 0x02, 0xC9, 0xFF, 0xF0, 0x24, 0x20, 0x72, 0x0D, 0x9D, 0xAD, 0x02, 0x18, 0xAD, 0x24, 0x02, 
-	0x7D, 0x60, 0x02, 0x9D, 0x60, 0x02, 0xAD, 0x24, 0x02, 0x10, 0x04, 0xA9, 0xFF, 0x30, 0x02, 0xA9, 0x00, 0x7D, 0x5C, 0x02, 0x9D, 
-	0x5C, 0x02, 0x20, 0xDB, 0x0F, 0xBD, 0x91, 0x02, 0xF0, 0x45, 0x85, 0x07, 0xBD, 0x8D, 0x02, 0x85, 0x06, 0xBD, 0xB1, 0x02, 0xC9, 
-	0xFF, 0xF0, 0x37, 0x20, 0x72, 0x0D, 0x9D, 0xB1, 0x02, 0xAD, 0x24, 0x02, 0x85, 0x04, 0x2A, 0x90, 0x07, 0xA9, 0xFF, 0x85, 0x05, 
-	0x4C, 0x27, 0x0D, 0xA9, 0x00, 0x85, 0x05, 0xA0, 0x04, 0x18, 0x26, 0x04, 0x26, 0x05, 0x88, 0xD0, 0xF8, 0x18, 0xA5, 0x04, 0x7D, 
-	0x60, 0x02, 0x9D, 0x60, 0x02, 0xA5, 0x05, 0x7D, 0x5C, 0x02, 0x9D, 0x5C, 0x02, 0x20, 0xDB, 0x0F, 0xBD, 0x99, 0x02, 0xF0, 0x27, 
-	0x85, 0x07, 0xBD, 0x95, 0x02, 0x85, 0x06, 0xBD, 0xB5, 0x02, 0xC9, 0xFF, 0xF0, 0x19, 0x20, 0x72, 0x0D, 0x9D, 0xB5, 0x02, 0xAD, 
-	0x24, 0x02, 0x48, 0xBD, 0xA1, 0x02, 0x29, 0xF0, 0x9D, 0xA1, 0x02, 0x68, 0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0x60, 0x18, 0x69, 
-	0x04, 0xA8, 0xB1, 0x06, 0x8D, 0x24, 0x02, 0x88, 0x88, 0x88, 0x98, 0xA0, 0x00, 0xD1, 0x06, 0xF0, 0x07, 0xA0, 0x02, 0xD1, 0x06, 
-	0xF0, 0x1D, 0x60, 0xC8, 0xB1, 0x06, 0xC9, 0xFF, 0xD0, 0x01, 0x60, 0x48, 0xBD, 0x48, 0x02, 0xD0, 0x02, 0x68, 0x60, 0xA0, 0x02, 
-	0xB1, 0x06, 0xD0, 0x02, 0x68, 0x60, 0x68, 0xA9, 0xFF, 0x60, 0x85, 0x00, 0xBD, 0x48, 0x02, 0xD0, 0x0D, 0x88, 0xB1, 0x06, 0xC9, 
-	0xFF, 0xD0, 0xDE, 0xA5, 0x00, 0x38, 0xE9, 0x01, 0x60, 0xA5, 0x00, 0x60, 0x98, 0x48, 0xBD, 0x79, 0x02, 0xF0, 0x13, 0x85, 0x07, 
-	0xBD, 0x75, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xA5, 0x02, 0xBD, 0x81, 0x02, 0xF0, 
-	0x13, 0x85, 0x07, 0xBD, 0x7D, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xA9, 0x02, 0xBD, 
-	0x89, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x85, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 
-	0xAD, 0x02, 0xBD, 0x91, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x8D, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 
-	0xE9, 0x01, 0x9D, 0xB1, 0x02, 0xBD, 0x99, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x95, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 
-	0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xB5, 0x02, 0x68, 0xA8, 0x60, 0xA9, 0x00, 0x9D, 0xA5, 0x02, 0x9D, 0xA9, 0x02, 0x9D, 0xAD, 
-	0x02, 0x9D, 0xB1, 0x02, 0x9D, 0xB5, 0x02, 0x60, 0x85, 0x02, 0x84, 0x00, 0xA0, 0x00, 0x18, 0x6D, 0x02, 0x02, 0x85, 0x04, 0x98, 
-	0x6D, 0x03, 0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 
-	0xBD, 0xE8, 0x13, 0xA8, 0xB9, 0x84, 0x0E, 0x85, 0x04, 0xC8, 0xB9, 0x84, 0x0E, 0x85, 0x05, 0xA0, 0x00, 0x6C, 0x04, 0x00, 0x90, 
-	0x0E, 0x90, 0x0E, 0xD9, 0x0F, 0xD8, 0x0F, 0x90, 0x0E, 0xDA, 0x0F, 0xB1, 0x06, 0x85, 0x02, 0xC8, 0x66, 0x02, 0x90, 0x34, 0x18, 
-	0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 0x75, 0x02, 
-	0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x79, 0x02, 0xD0, 0x03, 0x4C, 0xD5, 0x0E, 0xA5, 0x04, 0x9D, 0x75, 0x02, 0xA5, 0x05, 0x9D, 0x79, 
-	0x02, 0xA9, 0x00, 0x9D, 0xA5, 0x02, 0x4C, 0xD5, 0x0E, 0xA9, 0x00, 0x9D, 0x75, 0x02, 0x9D, 0x79, 0x02, 0x66, 0x02, 0x90, 0x34, 
-	0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 0x7D, 
-	0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x81, 0x02, 0xD0, 0x03, 0x4C, 0x15, 0x0F, 0xA5, 0x04, 0x9D, 0x7D, 0x02, 0xA5, 0x05, 0x9D, 
-	0x81, 0x02, 0xA9, 0x00, 0x9D, 0xA9, 0x02, 0x4C, 0x15, 0x0F, 0xA9, 0x00, 0x9D, 0x7D, 0x02, 0x9D, 0x81, 0x02, 0x66, 0x02, 0x90, 
-	0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 
-	0x85, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x89, 0x02, 0xD0, 0x03, 0x4C, 0x55, 0x0F, 0xA5, 0x04, 0x9D, 0x85, 0x02, 0xA5, 0x05, 
-	0x9D, 0x89, 0x02, 0xA9, 0x00, 0x9D, 0xAD, 0x02, 0x4C, 0x55, 0x0F, 0xA9, 0x00, 0x9D, 0x85, 0x02, 0x9D, 0x89, 0x02, 0x66, 0x02, 
-	0x90, 0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 
-	0xDD, 0x8D, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x91, 0x02, 0xD0, 0x03, 0x4C, 0x95, 0x0F, 0xA5, 0x04, 0x9D, 0x8D, 0x02, 0xA5, 
-	0x05, 0x9D, 0x91, 0x02, 0xA9, 0x00, 0x9D, 0xB1, 0x02, 0x4C, 0x95, 0x0F, 0xA9, 0x00, 0x9D, 0x8D, 0x02, 0x9D, 0x91, 0x02, 0x66, 
-	0x02, 0x90, 0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 
-	0x04, 0xDD, 0x95, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x99, 0x02, 0xD0, 0x03, 0x4C, 0xD5, 0x0F, 0xA5, 0x04, 0x9D, 0x95, 0x02, 
-	0xA5, 0x05, 0x9D, 0x99, 0x02, 0xA9, 0x00, 0x9D, 0xB5, 0x02, 0x4C, 0xD5, 0x0F, 0xA9, 0x00, 0x9D, 0x95, 0x02, 0x9D, 0x99, 0x02, 
-	0xA4, 0x00, 0x60, 0x60, 0x60, 0x60, 0xBD, 0xE8, 0x13, 0xA8, 0xB9, 0xEF, 0x0F, 0x85, 0x04, 0xC8, 0xB9, 0xEF, 0x0F, 0x85, 0x05, 
-	0xA0, 0x00, 0x6C, 0x04, 0x00, 0xFC, 0x0F, 0x19, 0x10, 0xFB, 0x0F, 0x19, 0x10, 0xFC, 0x0F, 0xFB, 0x0F, 0x60, 0xBD, 0x5C, 0x02, 
-	0x30, 0x0F, 0xC9, 0x08, 0x90, 0x0A, 0xA9, 0x07, 0x9D, 0x5C, 0x02, 0xA9, 0xFF, 0x9D, 0x60, 0x02, 0x60, 0xA9, 0x00, 0x9D, 0x60, 
-	0x02, 0x9D, 0x5C, 0x02, 0x60, 0xBD, 0x5C, 0x02, 0x30, 0x0F, 0xC9, 0x10, 0x90, 0x0A, 0xA9, 0x0F, 0x9D, 0x5C, 0x02, 0xA9, 0xFF, 
-	0x9D, 0x60, 0x02, 0x60, 0xA9, 0x00, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0xAD, 0x11, 0x02, 0xD0, 0x11, 0xA9, 0x00, 0x8D, 
-	0x15, 0x40, 0x60, 0xA9, 0xC0, 0x8D, 0x17, 0x40, 0xA9, 0x40, 0x8D, 0x17, 0x40, 0x60, 0xAD, 0x09, 0x02, 0x29, 0x01, 0xD0, 0x03, 
-	0x4C, 0xF1, 0x10, 0xAD, 0x34, 0x02, 0xF0, 0x72, 0xAD, 0x39, 0x02, 0x0A, 0xF0, 0x6C, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0x9D, 0x02, 
-	0xF0, 0x63, 0x05, 0x00, 0xAA, 0xBD, 0xD0, 0x12, 0x38, 0xED, 0xE9, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x39, 0x02, 
-	0xF0, 0x02, 0xA9, 0x01, 0x48, 0xAD, 0xA1, 0x02, 0x29, 0x03, 0xAA, 0x68, 0x1D, 0xCC, 0x12, 0x09, 0x30, 0x8D, 0x00, 0x40, 0xAD, 
-	0x68, 0x02, 0x29, 0xF8, 0xF0, 0x0A, 0xA9, 0x07, 0x8D, 0x68, 0x02, 0xA9, 0xFF, 0x8D, 0x64, 0x02, 0xAD, 0x71, 0x02, 0xF0, 0x2E, 
-	0x29, 0x80, 0xF0, 0x46, 0xAD, 0x71, 0x02, 0x8D, 0x01, 0x40, 0x29, 0x7F, 0x8D, 0x71, 0x02, 0x20, 0x41, 0x10, 0xAD, 0x64, 0x02, 
-	0x8D, 0x02, 0x40, 0xAD, 0x68, 0x02, 0x8D, 0x03, 0x40, 0xA9, 0xFF, 0x8D, 0x73, 0x02, 0x4C, 0xF1, 0x10, 0xA9, 0x30, 0x8D, 0x00, 
-	0x40, 0x4C, 0xF1, 0x10, 0xA9, 0x08, 0x8D, 0x01, 0x40, 0x20, 0x41, 0x10, 0xAD, 0x64, 0x02, 0x8D, 0x02, 0x40, 0xAD, 0x68, 0x02, 
-	0xCD, 0x73, 0x02, 0xF0, 0x06, 0x8D, 0x03, 0x40, 0x8D, 0x73, 0x02, 0xAD, 0x09, 0x02, 0x29, 0x02, 0xD0, 0x03, 0x4C, 0x96, 0x11, 
-	0xAD, 0x35, 0x02, 0xF0, 0x72, 0xAD, 0x3A, 0x02, 0x0A, 0xF0, 0x6C, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0x9E, 0x02, 0xF0, 0x63, 0x05, 
-	0x00, 0xAA, 0xBD, 0xD0, 0x12, 0x38, 0xED, 0xEA, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x3A, 0x02, 0xF0, 0x02, 0xA9, 
-	0x01, 0x48, 0xAD, 0xA2, 0x02, 0x29, 0x03, 0xAA, 0x68, 0x1D, 0xCC, 0x12, 0x09, 0x30, 0x8D, 0x04, 0x40, 0xAD, 0x69, 0x02, 0x29, 
-	0xF8, 0xF0, 0x0A, 0xA9, 0x07, 0x8D, 0x69, 0x02, 0xA9, 0xFF, 0x8D, 0x65, 0x02, 0xAD, 0x72, 0x02, 0xF0, 0x2E, 0x29, 0x80, 0xF0, 
-	0x46, 0xAD, 0x72, 0x02, 0x8D, 0x05, 0x40, 0x29, 0x7F, 0x8D, 0x72, 0x02, 0x20, 0x41, 0x10, 0xAD, 0x65, 0x02, 0x8D, 0x06, 0x40, 
-	0xAD, 0x69, 0x02, 0x8D, 0x07, 0x40, 0xA9, 0xFF, 0x8D, 0x74, 0x02, 0x4C, 0x96, 0x11, 0xA9, 0x30, 0x8D, 0x04, 0x40, 0x4C, 0x96, 
-	0x11, 0xA9, 0x08, 0x8D, 0x05, 0x40, 0x20, 0x41, 0x10, 0xAD, 0x65, 0x02, 0x8D, 0x06, 0x40, 0xAD, 0x69, 0x02, 0xCD, 0x74, 0x02, 
-	0xF0, 0x06, 0x8D, 0x07, 0x40, 0x8D, 0x74, 0x02, 0xAD, 0x09, 0x02, 0x29, 0x04, 0xF0, 0x39, 0xAD, 0x9F, 0x02, 0xF0, 0x2F, 0xAD, 
-	0x3B, 0x02, 0xF0, 0x2A, 0xAD, 0x36, 0x02, 0xF0, 0x25, 0xA9, 0x81, 0x8D, 0x08, 0x40, 0xAD, 0x6A, 0x02, 0x29, 0xF8, 0xF0, 0x0A, 
-	0xA9, 0x07, 0x8D, 0x6A, 0x02, 0xA9, 0xFF, 0x8D, 0x66, 0x02, 0xAD, 0x66, 0x02, 0x8D, 0x0A, 0x40, 0xAD, 0x6A, 0x02, 0x8D, 0x0B, 
-	0x40, 0x4C, 0xD6, 0x11, 0xA9, 0x00, 0x8D, 0x08, 0x40, 0xAD, 0x09, 0x02, 0x29, 0x08, 0xF0, 0x56, 0xAD, 0x37, 0x02, 0xF0, 0x4C, 
-	0xAD, 0x3C, 0x02, 0x0A, 0xF0, 0x46, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0xA0, 0x02, 0xF0, 0x3D, 0x05, 0x00, 0xAA, 0xBD, 0xD0, 0x12, 
-	0x38, 0xED, 0xEC, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x3C, 0x02, 0xF0, 0x02, 0xA9, 0x01, 0x09, 0x30, 0x8D, 0x0C, 
-	0x40, 0xA9, 0x00, 0x8D, 0x0D, 0x40, 0xAD, 0xA4, 0x02, 0x6A, 0x6A, 0x29, 0x80, 0x85, 0x00, 0xAD, 0x67, 0x02, 0x29, 0x0F, 0x49, 
-	0x0F, 0x05, 0x00, 0x8D, 0x0E, 0x40, 0xA9, 0x00, 0x8D, 0x0F, 0x40, 0xF0, 0x05, 0xA9, 0x30, 0x8D, 0x0C, 0x40, 0xAD, 0x09, 0x02, 
-	0x29, 0x10, 0xD0, 0x01, 0x60, 0xA2, 0x04, 0xAD, 0xF3, 0x02, 0xF0, 0x0D, 0xCE, 0xF4, 0x02, 0xD0, 0x08, 0x8D, 0xF4, 0x02, 0xA9, 
-	0x01, 0x9D, 0x34, 0x02, 0xAD, 0xF1, 0x02, 0x30, 0x03, 0x8D, 0x11, 0x40, 0xA9, 0x80, 0x8D, 0xF1, 0x02, 0xBD, 0x34, 0x02, 0xF0, 
-	0x5D, 0x30, 0x4B, 0xAD, 0xF0, 0x02, 0x29, 0x40, 0x85, 0x00, 0xAD, 0xF5, 0x02, 0x10, 0x03, 0xAD, 0xF0, 0x02, 0x05, 0x00, 0x8D, 
-	0x10, 0x40, 0xA9, 0x80, 0x8D, 0xF5, 0x02, 0xAD, 0xEF, 0x02, 0xF0, 0x03, 0x20, 0xD4, 0x13, 0x18, 0xAD, 0xED, 0x02, 0x6D, 0xF2, 
-	0x02, 0x8D, 0x12, 0x40, 0xAD, 0xF2, 0x02, 0x0A, 0x0A, 0x85, 0x00, 0x38, 0xAD, 0xEE, 0x02, 0xE5, 0x00, 0x8D, 0x13, 0x40, 0xA9, 
-	0x80, 0x9D, 0x34, 0x02, 0xA9, 0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x1F, 0x8D, 0x15, 0x40, 0x60, 0xC9, 0xFF, 0xF0, 0x01, 0x60, 0xA9, 
-	0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x80, 0x9D, 0x34, 0x02, 0x60, 0xA9, 0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x80, 0x8D, 0x11, 0x40, 0x9D, 
-	0x34, 0x02, 0x60, 0x00, 0x40, 0x80, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 
-	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 
-	0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x03, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x03, 
-	0x03, 0x03, 0x04, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x05, 0x00, 0x01, 
-	0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x04, 0x05, 0x05, 0x06, 0x00, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 
-	0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 0x06, 0x06, 0x07, 0x00, 0x01, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 
-	0x06, 0x06, 0x07, 0x08, 0x00, 0x01, 0x01, 0x01, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x06, 0x06, 0x07, 0x07, 0x08, 0x09, 0x00, 
-	0x01, 0x01, 0x02, 0x02, 0x03, 0x04, 0x04, 0x05, 0x06, 0x06, 0x07, 0x08, 0x08, 0x09, 0x0A, 0x00, 0x01, 0x01, 0x02, 0x02, 0x03, 
-	0x04, 0x05, 0x05, 0x06, 0x07, 0x08, 0x08, 0x09, 0x0A, 0x0B, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x04, 0x05, 0x06, 0x07, 0x08, 
-	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 
-	0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x00, 0x01, 0x02, 0x03, 0x04, 
-	0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x8D, 0xFB, 0x5F, 0x60, 0x18, 0x8D, 0xFC, 0x5F, 0x69, 0x01, 
-	0x8D, 0xFD, 0x5F, 0x69, 0x01, 0x8D, 0xFE, 0x5F, 0x60, 0x01, 0x02, 0x03, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5B, 0x0D, 
-	0x9C, 0x0C, 0xE6, 0x0B, 0x3B, 0x0B, 0x9A, 0x0A, 0x01, 0x0A, 0x72, 0x09, 0xEA, 0x08, 0x6A, 0x08, 0xF1, 0x07, 0x7F, 0x07, 0x13, 
-	0x07, 0xAD, 0x06, 0x4D, 0x06, 0xF3, 0x05, 0x9D, 0x05, 0x4C, 0x05, 0x00, 0x05, 0xB8, 0x04, 0x74, 0x04, 0x34, 0x04, 0xF8, 0x03, 
-	0xBF, 0x03, 0x89, 0x03, 0x56, 0x03, 0x26, 0x03, 0xF9, 0x02, 0xCE, 0x02, 0xA6, 0x02, 0x80, 0x02, 0x5C, 0x02, 0x3A, 0x02, 0x1A, 
-	0x02, 0xFB, 0x01, 0xDF, 0x01, 0xC4, 0x01, 0xAB, 0x01, 0x93, 0x01, 0x7C, 0x01, 0x67, 0x01, 0x52, 0x01, 0x3F, 0x01, 0x2D, 0x01, 
-	0x1C, 0x01, 0x0C, 0x01, 0xFD, 0x00, 0xEF, 0x00, 0xE1, 0x00, 0xD5, 0x00, 0xC9, 0x00, 0xBD, 0x00, 0xB3, 0x00, 0xA9, 0x00, 0x9F, 
-	0x00, 0x96, 0x00, 0x8E, 0x00, 0x86, 0x00, 0x7E, 0x00, 0x77, 0x00, 0x70, 0x00, 0x6A, 0x00, 0x64, 0x00, 0x5E, 0x00, 0x59, 0x00, 
-	0x54, 0x00, 0x4F, 0x00, 0x4B, 0x00, 0x46, 0x00, 0x42, 0x00, 0x3F, 0x00, 0x3B, 0x00, 0x38, 0x00, 0x34, 0x00, 0x31, 0x00, 0x2F, 
-	0x00, 0x2C, 0x00, 0x29, 0x00, 0x27, 0x00, 0x25, 0x00, 0x23, 0x00, 0x21, 0x00, 0x1F, 0x00, 0x1D, 0x00, 0x1B, 0x00, 0x1A, 0x00, 
-	0x18, 0x00, 0x17, 0x00, 0x15, 0x00, 0x14, 0x00, 0x13, 0x00, 0x12, 0x00, 0x11, 0x00, 0x10, 0x00, 0x0F, 0x00, 0x0E, 0x00, 0x0D, 
-	0x00, 0x68, 0x0C, 0xB6, 0x0B, 0x0E, 0x0B, 0x6F, 0x0A, 0xD9, 0x09, 0x4B, 0x09, 0xC6, 0x08, 0x48, 0x08, 0xD1, 0x07, 0x60, 0x07, 
-	0xF6, 0x06, 0x92, 0x06, 0x34, 0x06, 0xDB, 0x05, 0x86, 0x05, 0x37, 0x05, 0xEC, 0x04, 0xA5, 0x04, 0x62, 0x04, 0x23, 0x04, 0xE8, 
-	0x03, 0xB0, 0x03, 0x7B, 0x03, 0x49, 0x03, 0x19, 0x03, 0xED, 0x02, 0xC3, 0x02, 0x9B, 0x02, 0x75, 0x02, 0x52, 0x02, 0x31, 0x02, 
-	0x11, 0x02, 0xF3, 0x01, 0xD7, 0x01, 0xBD, 0x01, 0xA4, 0x01, 0x8C, 0x01, 0x76, 0x01, 0x61, 0x01, 0x4D, 0x01, 0x3A, 0x01, 0x29, 
-	0x01, 0x18, 0x01, 0x08, 0x01, 0xF9, 0x00, 0xEB, 0x00, 0xDE, 0x00, 0xD1, 0x00, 0xC6, 0x00, 0xBA, 0x00, 0xB0, 0x00, 0xA6, 0x00, 
-	0x9D, 0x00, 0x94, 0x00, 0x8B, 0x00, 0x84, 0x00, 0x7C, 0x00, 0x75, 0x00, 0x6E, 0x00, 0x68, 0x00, 0x62, 0x00, 0x5D, 0x00, 0x57, 
-	0x00, 0x52, 0x00, 0x4E, 0x00, 0x49, 0x00, 0x45, 0x00, 0x41, 0x00, 0x3E, 0x00, 0x3A, 0x00, 0x37, 0x00, 0x34, 0x00, 0x31, 0x00, 
-	0x2E, 0x00, 0x2B, 0x00, 0x29, 0x00, 0x26, 0x00, 0x24, 0x00, 0x22, 0x00, 0x20, 0x00, 0x1E, 0x00, 0x1D, 0x00, 0x1B, 0x00, 0x19, 
-	0x00, 0x18, 0x00, 0x16, 0x00, 0x15, 0x00, 0x14, 0x00, 0x13, 0x00, 0x12, 0x00, 0x11, 0x00, 0x10, 0x00, 0x0F, 0x00, 0x0E, 0x00, 
-	0x0D, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 
-	0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 
-	0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 
-	0x00, 0x00, 0x01, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 0x06, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x01, 0x02, 0x03, 
-	0x04, 0x05, 0x06, 0x07, 0x07, 0x08, 0x08, 0x09, 0x09, 0x09, 0x09, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 
-	0x09, 0x0A, 0x0B, 0x0B, 0x0B, 0x0B, 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0C, 0x0D, 0x0D, 
-	0x0D, 0x00, 0x01, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x00, 0x02, 0x04, 0x06, 
-	0x08, 0x0A, 0x0C, 0x0D, 0x0F, 0x11, 0x12, 0x13, 0x14, 0x15, 0x15, 0x15, 0x00, 0x02, 0x05, 0x08, 0x0B, 0x0E, 0x10, 0x13, 0x15, 
-	0x17, 0x18, 0x1A, 0x1B, 0x1C, 0x1D, 0x1D, 0x00, 0x04, 0x08, 0x0C, 0x10, 0x14, 0x18, 0x1B, 0x1F, 0x22, 0x24, 0x26, 0x28, 0x2A, 
-	0x2B, 0x2B, 0x00, 0x06, 0x0C, 0x12, 0x18, 0x1E, 0x23, 0x28, 0x2D, 0x31, 0x35, 0x38, 0x3B, 0x3D, 0x3E, 0x3F, 0x00, 0x09, 0x12, 
-	0x1B, 0x24, 0x2D, 0x35, 0x3C, 0x43, 0x4A, 0x4F, 0x54, 0x58, 0x5B, 0x5E, 0x5F, 0x00, 0x0C, 0x18, 0x25, 0x30, 0x3C, 0x47, 0x51, 
-	0x5A, 0x62, 0x6A, 0x70, 0x76, 0x7A, 0x7D, 0x7F, 0x6F, 0x16, 
-};
-
-const int DRIVER_RELOC_WORD_2A03[] = {
-	9, 12, 16, 138, 143, 153, 162, 203, 230, 294, 297, 322, 330, 342, 351, 376, 399, 407, 420, 429, 
-	523, 544, 618, 628, 637, 644, 647, 655, 658, 682, 708, 733, 757, 772, 775, 807, 837, 845, 873, 885, 
-	925, 953, 961, 964, 972, 995, 1017, 1026, 1033, 1039, 1052, 1059, 1062, 1119, 1127, 1130, 1142, 1157, 1160, 1168, 
-	1175, 1204, 1217, 1224, 1228, 1248, 1254, 1268, 1321, 1323, 1325, 1327, 1329, 1331, 1333, 1335, 1337, 1339, 1341, 1343, 
-	1345, 1347, 1349, 1351, 1353, 1355, 1357, 1359, 1361, 1363, 1365, 1367, 1369, 1371, 1373, 1375, 1377, 1380, 1383, 1386, 
-	1389, 1395, 1403, 1406, 1412, 1415, 1418, 1424, 1427, 1430, 1436, 1439, 1445, 1448, 1456, 1459, 1468, 1471, 1482, 1485, 
-	1496, 1499, 1510, 1513, 1524, 1541, 1544, 1550, 1553, 1587, 1590, 1609, 1615, 1618, 1624, 1632, 1635, 1642, 1645, 1651, 
-	1654, 1671, 1674, 1680, 1683, 1694, 1697, 1708, 1711, 1717, 1720, 1728, 1731, 1748, 1751, 1757, 1802, 1809, 1862, 2097, 
-	2240, 2243, 2246, 2249, 2252, 2255, 2258, 2298, 2316, 2372, 2380, 2442, 2445, 2482, 2494, 2514, 2526, 2547, 2562, 2579, 
-	2582, 2585, 2602, 2605, 2608, 2702, 2738, 2764, 2781, 2787, 2801, 2814, 2820, 2832, 2840, 2884, 2887, 2894, 2903, 2920, 
-	2929, 2939, 2978, 2997, 3087, 3093, 3100, 3129, 3160, 3205, 3214, 3236, 3244, 3261, 3288, 3321, 3343, 3361, 3395, 3417, 
-	3684, 3692, 3697, 3701, 3707, 3716, 3718, 3720, 3722, 3724, 3726, 3741, 3749, 3769, 3787, 3805, 3813, 3833, 3851, 3869, 
-	3877, 3897, 3915, 3933, 3941, 3961, 3979, 3997, 4005, 4025, 4043, 4060, 4064, 4070, 4079, 4081, 4083, 4085, 4087, 4089, 
-	4180, 4206, 4234, 4279, 4299, 4307, 4315, 4345, 4371, 4399, 4444, 4464, 4472, 4480, 4559, 4597, 4738, 5741, 
-};
-
-const int DRIVER_RELOC_LOW_2A03[] = {
-	195, -32531, 220, -32595, 
-};
-
-const int DRIVER_RELOC_HIGH_2A03[] = {
-	199, 5101, 224, 5293, 
-};
-
+const unsigned char DRIVER_2A03[] = {
+	0x46, 0x54, 0x44, 0x52, 0x56, 0x20, 0x02, 0x0A, 0x4C, 0x0E, 0x00, 0x4C, 0x94, 0x02, 0x0A, 0x20, 0x88, 0x00, 0xA9, 0x00, 0xA2, 
+	0x0B, 0x9D, 0x00, 0x40, 0xCA, 0xD0, 0xFA, 0xA2, 0x06, 0x9D, 0x0D, 0x40, 0xCA, 0xD0, 0xFA, 0xA9, 0x30, 0x8D, 0x0C, 0x40, 0xA9, 
+	0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x08, 0x8D, 0x01, 0x40, 0x8D, 0x05, 0x40, 0xA9, 0xC0, 0x8D, 0x17, 0x40, 0xA9, 0x40, 0x8D, 0x17, 
+	0x40, 0xA9, 0xFF, 0x8D, 0x09, 0x02, 0x8D, 0xF5, 0x02, 0x8D, 0xF1, 0x02, 0xA9, 0x00, 0xAA, 0x9D, 0x43, 0x02, 0x9D, 0xBD, 0x02, 
+	0x9D, 0xC1, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0xE8, 0xE0, 0x04, 0xD0, 0xE6, 0xAD, 
+	0x08, 0x02, 0x29, 0x02, 0xF0, 0x0E, 0xA9, 0x30, 0xA2, 0x00, 0x9D, 0xD1, 0x02, 0xE8, 0xE0, 0x04, 0xD0, 0xF8, 0xA9, 0x00, 0x8D, 
+	0x47, 0x02, 0xA2, 0x04, 0xA9, 0x80, 0x9D, 0x34, 0x02, 0x60, 0x48, 0xAD, 0x6D, 0x16, 0x85, 0x06, 0xAD, 0x6E, 0x16, 0x85, 0x07, 
+	0xA0, 0x00, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x99, 0x00, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x99, 0x00, 0x02, 0xC8, 
+	0xC0, 0x08, 0xD0, 0xE9, 0xB1, 0x06, 0x8D, 0x08, 0x02, 0xC8, 0xE0, 0x01, 0xF0, 0x17, 0xB1, 0x06, 0xC8, 0x8D, 0x19, 0x02, 0xB1, 
+	0x06, 0xC8, 0x8D, 0x1A, 0x02, 0xA9, 0x00, 0x85, 0x0C, 0xA9, 0x00, 0x85, 0x0D, 0x4C, 0xE3, 0x00, 0xC8, 0xC8, 0xB1, 0x06, 0xC8, 
+	0x8D, 0x19, 0x02, 0xB1, 0x06, 0xC8, 0x8D, 0x1A, 0x02, 0xA9, 0x00, 0x85, 0x0C, 0xA9, 0x00, 0x85, 0x0D, 0x68, 0xA8, 0x20, 0x34, 
+	0x01, 0xA2, 0x01, 0x8E, 0x11, 0x02, 0xCA, 0xA9, 0x7F, 0x9D, 0x39, 0x02, 0xA9, 0x80, 0x9D, 0x4D, 0x02, 0xA9, 0x00, 0x9D, 0xD9, 
+	0x02, 0x9D, 0xE5, 0x02, 0x9D, 0xBD, 0x02, 0x9D, 0x6C, 0x02, 0x9D, 0x52, 0x02, 0x9D, 0xCD, 0x02, 0x9D, 0x34, 0x02, 0xE8, 0xE0, 
+	0x04, 0xD0, 0xDA, 0xA2, 0xFF, 0x8E, 0x73, 0x02, 0x8E, 0x74, 0x02, 0xA9, 0x00, 0x8D, 0xF2, 0x02, 0xE8, 0x8E, 0x13, 0x02, 0x20, 
+	0x71, 0x01, 0x20, 0xFC, 0x07, 0xA9, 0x00, 0x8D, 0x15, 0x02, 0x8D, 0x16, 0x02, 0x60, 0xAD, 0x00, 0x02, 0x85, 0x04, 0xAD, 0x01, 
+	0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 0xA9, 0x00, 
+	0xAA, 0xA8, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x8D, 0x0A, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x8D, 0x0B, 0x02, 0xC8, 
+	0xB1, 0x06, 0x9D, 0x0C, 0x02, 0xC8, 0xE8, 0xE0, 0x06, 0xD0, 0xF5, 0x60, 0x48, 0xAD, 0x10, 0x02, 0xF0, 0x03, 0x20, 0xD0, 0x13, 
+	0x68, 0x0A, 0x18, 0x6D, 0x0A, 0x02, 0x85, 0x04, 0xA9, 0x00, 0xA8, 0xAA, 0x6D, 0x0B, 0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 
+	0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 0xA0, 0x00, 0x8E, 0x12, 0x02, 0x18, 0xB1, 0x06, 0x6D, 
+	0x6D, 0x16, 0x9D, 0x25, 0x02, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x9D, 0x2A, 0x02, 0xC8, 0xA9, 0x00, 0x9D, 0x52, 0x02, 0x9D, 
+	0x3E, 0x02, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xDB, 0xAD, 0x08, 0x02, 0x29, 0x01, 0xF0, 0x0D, 0xA2, 0x00, 
+	0xB1, 0x06, 0x9D, 0x2F, 0x02, 0xC8, 0xE8, 0xE0, 0x05, 0xD0, 0xF5, 0xA9, 0x00, 0x8D, 0x20, 0x02, 0x8D, 0x21, 0x02, 0xAD, 0x22, 
+	0x02, 0xD0, 0x01, 0x60, 0x8D, 0x12, 0x02, 0xA2, 0x00, 0xAD, 0x12, 0x02, 0x85, 0x01, 0xA9, 0x00, 0x9D, 0x52, 0x02, 0xA0, 0x00, 
+	0xBD, 0x25, 0x02, 0x85, 0x0A, 0xBD, 0x2A, 0x02, 0x85, 0x0B, 0xBD, 0x52, 0x02, 0xF0, 0x06, 0xDE, 0x52, 0x02, 0x4C, 0x26, 0x02, 
+	0xB1, 0x0A, 0x30, 0x32, 0xBD, 0x57, 0x02, 0xC9, 0xFF, 0xD0, 0x0A, 0xC8, 0xB1, 0x0A, 0xC8, 0x9D, 0x52, 0x02, 0x4C, 0x26, 0x02, 
+	0xC8, 0x9D, 0x52, 0x02, 0x18, 0x98, 0x65, 0x0A, 0x9D, 0x25, 0x02, 0xA9, 0x00, 0x65, 0x0B, 0x9D, 0x2A, 0x02, 0xC6, 0x01, 0xD0, 
+	0xBE, 0xE8, 0xE0, 0x05, 0xD0, 0xAF, 0xA9, 0x00, 0x8D, 0x22, 0x02, 0x60, 0xC9, 0x80, 0xF0, 0x38, 0xC9, 0x82, 0xF0, 0x21, 0xC9, 
+	0x84, 0xF0, 0x27, 0x48, 0xC9, 0x8E, 0xF0, 0x13, 0xC9, 0x92, 0xF0, 0x0F, 0xC9, 0xA2, 0xF0, 0x0B, 0x29, 0xF0, 0xC9, 0xF0, 0xF0, 
+	0x05, 0xC9, 0xE0, 0xF0, 0x23, 0xC8, 0xC8, 0x68, 0x4C, 0x02, 0x02, 0xC8, 0xB1, 0x0A, 0xC8, 0x9D, 0x57, 0x02, 0x4C, 0x02, 0x02, 
+	0xC8, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0x4C, 0x02, 0x02, 0xC8, 0xB1, 0x0A, 0xC8, 0x20, 0x4E, 0x0E, 0x4C, 0x02, 0x02, 0xC8, 0x68, 
+	0x29, 0x0F, 0x0A, 0x20, 0x4E, 0x0E, 0x4C, 0x02, 0x02, 0xAD, 0x11, 0x02, 0xD0, 0x01, 0x60, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 
+	0x13, 0x38, 0xE9, 0x01, 0x9D, 0x3E, 0x02, 0xD0, 0x0B, 0x20, 0xCF, 0x03, 0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 
+	0xE0, 0x05, 0xD0, 0xE3, 0xAD, 0x16, 0x02, 0x30, 0x08, 0x0D, 0x15, 0x02, 0xF0, 0x03, 0x4C, 0x77, 0x03, 0xA9, 0x00, 0x8D, 0xF3, 
+	0x02, 0xAD, 0x14, 0x02, 0xF0, 0x27, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 0x10, 0xA9, 0x00, 0x9D, 0x3E, 0x02, 0x20, 0xCF, 0x03, 
+	0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xE6, 0xA9, 0x00, 0x8D, 0x14, 0x02, 0xAD, 0x13, 0x02, 
+	0x20, 0x71, 0x01, 0xA2, 0x00, 0xBD, 0x3E, 0x02, 0xF0, 0x08, 0xA9, 0x00, 0x9D, 0x3E, 0x02, 0x20, 0xCF, 0x03, 0x20, 0xCF, 0x03, 
+	0xBD, 0x43, 0x02, 0x29, 0x7F, 0x9D, 0x43, 0x02, 0xE8, 0xE0, 0x05, 0xD0, 0xE3, 0xAD, 0x20, 0x02, 0xF0, 0x0E, 0x38, 0xE9, 0x01, 
+	0x8D, 0x13, 0x02, 0xA9, 0x01, 0x8D, 0x14, 0x02, 0x4C, 0x74, 0x03, 0xAD, 0x21, 0x02, 0xF0, 0x21, 0x38, 0xE9, 0x01, 0x8D, 0x22, 
+	0x02, 0xA9, 0x01, 0x8D, 0x14, 0x02, 0xEE, 0x13, 0x02, 0xAD, 0x13, 0x02, 0xCD, 0x0C, 0x02, 0xF0, 0x03, 0x4C, 0x74, 0x03, 0xA9, 
+	0x00, 0x8D, 0x13, 0x02, 0x4C, 0x74, 0x03, 0xEE, 0x12, 0x02, 0xAD, 0x12, 0x02, 0xCD, 0x0D, 0x02, 0xD0, 0x1A, 0xEE, 0x13, 0x02, 
+	0xAD, 0x13, 0x02, 0xCD, 0x0C, 0x02, 0xF0, 0x06, 0x8D, 0x14, 0x02, 0x4C, 0x74, 0x03, 0xA2, 0x00, 0x8E, 0x13, 0x02, 0xE8, 0x8E, 
+	0x14, 0x02, 0x20, 0xD5, 0x07, 0x38, 0xAD, 0x15, 0x02, 0xED, 0x17, 0x02, 0x8D, 0x15, 0x02, 0xAD, 0x16, 0x02, 0xED, 0x18, 0x02, 
+	0x8D, 0x16, 0x02, 0xA2, 0x00, 0xBD, 0x43, 0x02, 0xF0, 0x20, 0x38, 0xE9, 0x01, 0x9D, 0x43, 0x02, 0xD0, 0x18, 0x9D, 0x34, 0x02, 
+	0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xF0, 0x0E, 0xA9, 0x00, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 
+	0xE8, 0xE0, 0x05, 0xD0, 0xD6, 0xA2, 0x00, 0x20, 0x6F, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x03, 0x20, 0x25, 0x0C, 0x20, 0x4E, 0x09, 
+	0xE8, 0xE0, 0x04, 0xD0, 0xED, 0x20, 0x36, 0x10, 0x60, 0xBC, 0x52, 0x02, 0xF0, 0x06, 0x88, 0x98, 0x9D, 0x52, 0x02, 0x60, 0x8C, 
+	0x1E, 0x02, 0xBD, 0x2F, 0x02, 0xF0, 0x03, 0x20, 0xD0, 0x13, 0xA9, 0x0F, 0x8D, 0x1D, 0x02, 0xBD, 0x25, 0x02, 0x85, 0x0A, 0xBD, 
+	0x2A, 0x02, 0x85, 0x0B, 0xB1, 0x0A, 0x10, 0x03, 0x4C, 0xCE, 0x04, 0xF0, 0x69, 0xC9, 0x7F, 0xD0, 0x03, 0x4C, 0x8A, 0x04, 0xC9, 
+	0x7E, 0xD0, 0x03, 0x4C, 0x69, 0x04, 0x9D, 0x34, 0x02, 0x20, 0x05, 0x07, 0xBD, 0x43, 0x02, 0x30, 0x05, 0xA9, 0x00, 0x9D, 0x43, 
+	0x02, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xD0, 0x03, 0x4C, 0xF6, 0x04, 0x20, 0x3C, 0x0E, 0xA9, 0x00, 0x9D, 0x48, 0x02, 0xAD, 0x1D, 
+	0x02, 0x9D, 0x9D, 0x02, 0xA9, 0x00, 0x9D, 0xCD, 0x02, 0xBD, 0xA1, 0x02, 0x29, 0xF0, 0x9D, 0xA1, 0x02, 0x4A, 0x4A, 0x4A, 0x4A, 
+	0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0xBD, 0xBD, 0x02, 0xC9, 0x06, 0xF0, 0x04, 0xC9, 0x08, 0xD0, 0x05, 0xA9, 0x00, 0x9D, 0xBD, 
+	0x02, 0xE0, 0x02, 0x90, 0x03, 0x4C, 0xF6, 0x04, 0xA9, 0x00, 0x9D, 0x71, 0x02, 0x4C, 0xF6, 0x04, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 
+	0xD0, 0x08, 0xA9, 0xFF, 0x9D, 0x34, 0x02, 0x4C, 0xF6, 0x04, 0xBD, 0x48, 0x02, 0xC9, 0x01, 0xF0, 0xE7, 0xA9, 0x01, 0x9D, 0x48, 
+	0x02, 0x20, 0xBF, 0x0D, 0x4C, 0xF6, 0x04, 0xA9, 0x00, 0x9D, 0x34, 0x02, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 0xD0, 0x03, 0x4C, 0xF6, 
+	0x04, 0xA9, 0x00, 0x9D, 0x9D, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0xE0, 0x02, 0xB0, 
+	0x05, 0xA9, 0xFF, 0x9D, 0x73, 0x02, 0x4C, 0xF6, 0x04, 0x68, 0x0A, 0x0A, 0x0A, 0x29, 0x78, 0x9D, 0x39, 0x02, 0xC8, 0x4C, 0xF4, 
+	0x03, 0x68, 0x29, 0x0F, 0x0A, 0x20, 0x4E, 0x0E, 0xC8, 0x4C, 0xF4, 0x03, 0x48, 0x29, 0xF0, 0xC9, 0xF0, 0xF0, 0xE1, 0xC9, 0xE0, 
+	0xF0, 0xEA, 0x68, 0x29, 0x7F, 0x84, 0x00, 0xA8, 0xB9, 0x29, 0x05, 0x85, 0x06, 0xC8, 0xB9, 0x29, 0x05, 0x85, 0x07, 0xA4, 0x00, 
+	0xC8, 0x6C, 0x06, 0x00, 0x9D, 0x52, 0x02, 0x4C, 0x03, 0x05, 0xBD, 0x57, 0x02, 0xC9, 0xFF, 0xD0, 0xF3, 0xC8, 0xB1, 0x0A, 0x9D, 
+	0x52, 0x02, 0x18, 0xC8, 0x98, 0x65, 0x0A, 0x9D, 0x25, 0x02, 0xA9, 0x00, 0x65, 0x0B, 0x9D, 0x2A, 0x02, 0xAD, 0x1E, 0x02, 0xF0, 
+	0x0B, 0x9D, 0x71, 0x02, 0xA9, 0x00, 0x8D, 0x1E, 0x02, 0x9D, 0x73, 0x02, 0x60, 0xB1, 0x0A, 0x48, 0xC8, 0x68, 0x60, 0x63, 0x05, 
+	0x6C, 0x05, 0x75, 0x05, 0x7D, 0x05, 0x89, 0x05, 0x95, 0x05, 0x9E, 0x05, 0xA7, 0x05, 0xB2, 0x05, 0xF6, 0x05, 0xCC, 0x05, 0xDA, 
+	0x05, 0xBE, 0x05, 0xE8, 0x05, 0x10, 0x06, 0x35, 0x06, 0x51, 0x06, 0x5A, 0x06, 0x75, 0x06, 0x62, 0x06, 0x07, 0x06, 0x6C, 0x06, 
+	0x89, 0x06, 0x92, 0x06, 0xA0, 0x06, 0xAE, 0x06, 0xB7, 0x06, 0xC2, 0x06, 0xD6, 0x06, 0x20, 0x23, 0x05, 0x20, 0x4E, 0x0E, 0x4C, 
+	0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0x57, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0xFF, 0x9D, 0x57, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
+	0x05, 0x8D, 0x0E, 0x02, 0x20, 0xFC, 0x07, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x0F, 0x02, 0x20, 0xFC, 0x07, 0x4C, 0xF4, 
+	0x03, 0x20, 0x23, 0x05, 0x8D, 0x20, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x21, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
+	0x05, 0xA9, 0x00, 0x8D, 0x11, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x1D, 0x02, 0x9D, 0x9D, 0x02, 0x4C, 0xF4, 0x03, 
+	0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x02, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 
+	0x03, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x04, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 
+	0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x01, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0x00, 0x9D, 0xC1, 0x02, 0x9D, 0xBD, 
+	0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0x1E, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 
+	0x05, 0x48, 0xBD, 0xD9, 0x02, 0xD0, 0x0C, 0xAD, 0x08, 0x02, 0x29, 0x02, 0xF0, 0x02, 0xA9, 0x30, 0x9D, 0xD1, 0x02, 0x68, 0x48, 
+	0x29, 0xF0, 0x9D, 0xD5, 0x02, 0x68, 0x29, 0x0F, 0x9D, 0xD9, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x48, 0x29, 0xF0, 0x9D, 
+	0xE1, 0x02, 0x68, 0x29, 0x0F, 0x9D, 0xE5, 0x02, 0xC9, 0x00, 0xF0, 0x03, 0x4C, 0xF4, 0x03, 0x9D, 0xDD, 0x02, 0x4C, 0xF4, 0x03, 
+	0x20, 0x23, 0x05, 0x9D, 0x4D, 0x02, 0x4C, 0xF4, 0x03, 0xA9, 0x80, 0x9D, 0x4D, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 
+	0x3E, 0x02, 0x88, 0x4C, 0x03, 0x05, 0x20, 0x23, 0x05, 0x8D, 0xF1, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xA1, 0x02, 
+	0x18, 0x0A, 0x0A, 0x0A, 0x0A, 0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF2, 0x02, 0x4C, 
+	0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 0x02, 0xA9, 0x05, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0xC1, 
+	0x02, 0xA9, 0x07, 0x9D, 0xBD, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x9D, 0x6C, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 
+	0x09, 0x80, 0x9D, 0x43, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF3, 0x02, 0xAD, 0xF4, 0x02, 0xD0, 0x06, 0xAD, 0xF3, 
+	0x02, 0x8D, 0xF4, 0x02, 0x4C, 0xF4, 0x03, 0x20, 0x23, 0x05, 0x8D, 0xF5, 0x02, 0x4C, 0xF4, 0x03, 0x38, 0xE9, 0x01, 0xE0, 0x03, 
+	0xF0, 0x12, 0x0A, 0x84, 0x00, 0xA8, 0xB1, 0x0C, 0x9D, 0x60, 0x02, 0xC8, 0xB1, 0x0C, 0x9D, 0x5C, 0x02, 0xA4, 0x00, 0x60, 0x29, 
+	0x0F, 0x09, 0x10, 0x9D, 0x60, 0x02, 0xA9, 0x00, 0x9D, 0x5C, 0x02, 0x60, 0x38, 0xE9, 0x01, 0x48, 0xBD, 0xE3, 0x13, 0xC9, 0x05, 
+	0xD0, 0x03, 0x4C, 0x7B, 0x07, 0x68, 0xE0, 0x03, 0xF0, 0x31, 0x0A, 0x84, 0x00, 0xA8, 0xBD, 0xBD, 0x02, 0xC9, 0x02, 0xD0, 0x22, 
+	0xB1, 0x0C, 0x9D, 0xC9, 0x02, 0xC8, 0xB1, 0x0C, 0x9D, 0xC5, 0x02, 0xA4, 0x00, 0xBD, 0x60, 0x02, 0x1D, 0x5C, 0x02, 0xD0, 0x0C, 
+	0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x4C, 0xEA, 0x06, 0x60, 0x09, 0x10, 0x48, 0xBD, 
+	0xBD, 0x02, 0xC9, 0x02, 0xD0, 0x1E, 0x68, 0x9D, 0xC9, 0x02, 0xA9, 0x00, 0x9D, 0xC5, 0x02, 0xBD, 0x60, 0x02, 0x1D, 0x5C, 0x02, 
+	0xD0, 0x0C, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x68, 0x9D, 0x60, 0x02, 0xA9, 0x00, 
+	0x9D, 0x5C, 0x02, 0x60, 0x18, 0x68, 0x48, 0x0A, 0x6D, 0x04, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x6D, 0x05, 0x02, 0x85, 0x05, 0x18, 
+	0x68, 0x65, 0x04, 0x85, 0x04, 0xA9, 0x00, 0x65, 0x05, 0x85, 0x05, 0x84, 0x00, 0xA0, 0x00, 0xB1, 0x04, 0x8D, 0xF0, 0x02, 0xC8, 
+	0xAD, 0xF1, 0x02, 0x10, 0x07, 0xB1, 0x04, 0x30, 0x03, 0x8D, 0xF1, 0x02, 0xC8, 0xB1, 0x04, 0xA8, 0xAD, 0x06, 0x02, 0x85, 0x04, 
+	0xAD, 0x07, 0x02, 0x85, 0x05, 0xB1, 0x04, 0x8D, 0xED, 0x02, 0xC8, 0xB1, 0x04, 0x8D, 0xEE, 0x02, 0xC8, 0xB1, 0x04, 0x8D, 0xEF, 
+	0x02, 0xA4, 0x00, 0xAD, 0xF3, 0x02, 0x8D, 0xF4, 0x02, 0x60, 0x18, 0xAD, 0x15, 0x02, 0x6D, 0x19, 0x02, 0x8D, 0x15, 0x02, 0xAD, 
+	0x16, 0x02, 0x6D, 0x1A, 0x02, 0x8D, 0x16, 0x02, 0x38, 0xAD, 0x15, 0x02, 0xED, 0x1B, 0x02, 0x8D, 0x15, 0x02, 0xAD, 0x16, 0x02, 
+	0xED, 0x1C, 0x02, 0x8D, 0x16, 0x02, 0x60, 0x98, 0x48, 0xAD, 0x0F, 0x02, 0x85, 0x10, 0xA9, 0x00, 0x85, 0x11, 0xA0, 0x03, 0x06, 
+	0x10, 0x26, 0x11, 0x88, 0xD0, 0xF9, 0xA5, 0x10, 0x85, 0x0E, 0xA5, 0x11, 0xA8, 0x06, 0x10, 0x26, 0x11, 0x18, 0xA5, 0x0E, 0x65, 
+	0x10, 0x85, 0x0E, 0x98, 0x65, 0x11, 0x85, 0x0F, 0xAD, 0x0E, 0x02, 0x85, 0x10, 0xA9, 0x00, 0x85, 0x11, 0x20, 0x4A, 0x08, 0xA5, 
+	0x0E, 0x8D, 0x17, 0x02, 0xA5, 0x0F, 0x8D, 0x18, 0x02, 0xA5, 0x12, 0x8D, 0x1B, 0x02, 0xA5, 0x13, 0x8D, 0x1C, 0x02, 0x68, 0xA8, 
+	0x60, 0xA9, 0x00, 0x85, 0x13, 0xA0, 0x10, 0x06, 0x0E, 0x26, 0x0F, 0x2A, 0x26, 0x13, 0x48, 0xC5, 0x10, 0xA5, 0x13, 0xE5, 0x11, 
+	0x90, 0x08, 0x85, 0x13, 0x68, 0xE5, 0x10, 0x48, 0xE6, 0x0E, 0x68, 0x88, 0xD0, 0xE4, 0x85, 0x12, 0x60, 0xBD, 0x6C, 0x02, 0xF0, 
+	0x2A, 0xBD, 0x6C, 0x02, 0x29, 0x0F, 0x85, 0x00, 0x38, 0xBD, 0x39, 0x02, 0xE5, 0x00, 0x10, 0x02, 0xA9, 0x00, 0x9D, 0x39, 0x02, 
+	0xBD, 0x6C, 0x02, 0x4A, 0x4A, 0x4A, 0x4A, 0x85, 0x00, 0x18, 0xBD, 0x39, 0x02, 0x65, 0x00, 0x10, 0x02, 0xA9, 0x7F, 0x9D, 0x39, 
+	0x02, 0xBD, 0xBD, 0x02, 0xF0, 0x31, 0xC9, 0x01, 0xF0, 0x1B, 0xC9, 0x02, 0xF0, 0x1A, 0xC9, 0x03, 0xF0, 0x19, 0xC9, 0x06, 0xF0, 
+	0x18, 0xC9, 0x08, 0xF0, 0x17, 0xC9, 0x05, 0xF0, 0x16, 0xC9, 0x07, 0xF0, 0x12, 0x4C, 0x1B, 0x0A, 0x4C, 0xCE, 0x0A, 0x4C, 0x90, 
+	0x09, 0x4C, 0x04, 0x0A, 0x4C, 0x6A, 0x0A, 0x4C, 0x90, 0x0A, 0x4C, 0xD5, 0x08, 0x60, 0xBD, 0x60, 0x02, 0x48, 0xBD, 0x5C, 0x02, 
+	0x48, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0x85, 0x00, 0xBD, 0xBD, 0x02, 0xC9, 0x05, 0xF0, 0x11, 0xBD, 0x34, 0x02, 0x38, 0xE5, 0x00, 
+	0x10, 0x02, 0xA9, 0x01, 0xD0, 0x02, 0xA9, 0x01, 0x4C, 0x08, 0x09, 0xBD, 0x34, 0x02, 0x18, 0x65, 0x00, 0xC9, 0x60, 0x90, 0x02, 
+	0xA9, 0x60, 0x9D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xBD, 0x60, 0x02, 0x9D, 0xC9, 0x02, 0xBD, 0x5C, 0x02, 0x9D, 0xC5, 0x02, 0xBD, 
+	0xC1, 0x02, 0x4A, 0x4A, 0x4A, 0x09, 0x01, 0x9D, 0xC1, 0x02, 0x68, 0x9D, 0x5C, 0x02, 0x68, 0x9D, 0x60, 0x02, 0x18, 0xBD, 0xBD, 
+	0x02, 0x69, 0x01, 0x9D, 0xBD, 0x02, 0xE0, 0x03, 0xD0, 0x11, 0xC9, 0x06, 0xF0, 0x08, 0xA9, 0x06, 0x9D, 0xBD, 0x02, 0x4C, 0x9E, 
+	0x08, 0xA9, 0x08, 0x9D, 0xBD, 0x02, 0x4C, 0x9E, 0x08, 0xBD, 0x60, 0x02, 0x9D, 0x64, 0x02, 0xBD, 0x5C, 0x02, 0x9D, 0x68, 0x02, 
+	0xBD, 0x4D, 0x02, 0xC9, 0x80, 0xF0, 0x28, 0xBD, 0x34, 0x02, 0xF0, 0x23, 0x18, 0xBD, 0x64, 0x02, 0x69, 0x80, 0x9D, 0x64, 0x02, 
+	0xBD, 0x68, 0x02, 0x69, 0x00, 0x9D, 0x68, 0x02, 0x38, 0xBD, 0x64, 0x02, 0xFD, 0x4D, 0x02, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 
+	0xE9, 0x00, 0x9D, 0x68, 0x02, 0x20, 0x1A, 0x0B, 0x20, 0xE7, 0x0B, 0x60, 0xBD, 0xC1, 0x02, 0xF0, 0x6C, 0xBD, 0xC9, 0x02, 0x1D, 
+	0xC5, 0x02, 0xF0, 0x64, 0xBD, 0x5C, 0x02, 0xDD, 0xC5, 0x02, 0x90, 0x2F, 0xD0, 0x0D, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 
+	0x25, 0xD0, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x4E, 0x0A, 0xDD, 0xC5, 0x02, 
+	0x90, 0x30, 0x30, 0x2E, 0xD0, 0x38, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 0x24, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x85, 
+	0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x32, 0x0A, 0xBD, 0xC5, 0x02, 0xDD, 0x5C, 0x02, 0x90, 0x0D, 0xD0, 0x17, 0xBD, 0xC9, 0x02, 
+	0xDD, 0x60, 0x02, 0x90, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 0x02, 0x4C, 
+	0xD4, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x0F, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x4E, 0x0A, 0x20, 0xDB, 
+	0x0F, 0x4C, 0xD4, 0x08, 0xBD, 0x34, 0x02, 0xF0, 0x0F, 0xBD, 0xC1, 0x02, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x20, 0x32, 0x0A, 
+	0x20, 0xDB, 0x0F, 0x4C, 0xD4, 0x08, 0x18, 0xBD, 0x60, 0x02, 0x65, 0x04, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0x65, 0x05, 0x9D, 
+	0x5C, 0x02, 0x90, 0x08, 0xA9, 0xFF, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x38, 0xBD, 0x60, 0x02, 0xE5, 0x04, 0x9D, 0x60, 
+	0x02, 0xBD, 0x5C, 0x02, 0xE5, 0x05, 0x9D, 0x5C, 0x02, 0xB0, 0x08, 0xA9, 0x00, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0x38, 
+	0xBD, 0x60, 0x02, 0xFD, 0xC1, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0xE9, 0x00, 0x9D, 0x5C, 0x02, 0x30, 0x36, 0xDD, 0xC5, 
+	0x02, 0x90, 0x31, 0xD0, 0x46, 0xBD, 0x60, 0x02, 0xDD, 0xC9, 0x02, 0x90, 0x27, 0x4C, 0xD4, 0x08, 0x18, 0xBD, 0x60, 0x02, 0x7D, 
+	0xC1, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0x5C, 0x02, 0x69, 0x00, 0x9D, 0x5C, 0x02, 0xDD, 0xC5, 0x02, 0x90, 0x24, 0xD0, 0x0B, 0xBD, 
+	0x60, 0x02, 0xDD, 0xC9, 0x02, 0xB0, 0x03, 0x4C, 0xD4, 0x08, 0xBD, 0xC9, 0x02, 0x9D, 0x60, 0x02, 0xBD, 0xC5, 0x02, 0x9D, 0x5C, 
+	0x02, 0xA9, 0x00, 0x9D, 0xBD, 0x02, 0x9D, 0xC9, 0x02, 0x9D, 0xC5, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xCD, 0x02, 0xC9, 0x01, 0xF0, 
+	0x10, 0xC9, 0x02, 0xF0, 0x2D, 0xBD, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xFE, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x4A, 
+	0x4A, 0x4A, 0x4A, 0x18, 0x7D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0xD0, 0x06, 0x9D, 0xCD, 0x02, 0x4C, 
+	0xD4, 0x08, 0xFE, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xC1, 0x02, 0x29, 0x0F, 0x18, 0x7D, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xA9, 
+	0x00, 0x9D, 0xCD, 0x02, 0x4C, 0xD4, 0x08, 0xBD, 0xD9, 0x02, 0xD0, 0x01, 0x60, 0x18, 0x7D, 0xD1, 0x02, 0x29, 0x3F, 0x9D, 0xD1, 
+	0x02, 0xC9, 0x10, 0x90, 0x1C, 0xC9, 0x20, 0x90, 0x28, 0xC9, 0x30, 0x90, 0x3E, 0x38, 0xE9, 0x30, 0x85, 0x00, 0x38, 0xA9, 0x0F, 
+	0xE5, 0x00, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x4C, 0x7D, 0x0B, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x85, 0x04, 
+	0xA9, 0x00, 0x85, 0x05, 0x4C, 0x92, 0x0B, 0x38, 0xE9, 0x10, 0x85, 0x00, 0x38, 0xA9, 0x0F, 0xE5, 0x00, 0x1D, 0xD5, 0x02, 0xA8, 
+	0xB9, 0x6D, 0x15, 0x85, 0x04, 0xA9, 0x00, 0x85, 0x05, 0x4C, 0x92, 0x0B, 0x38, 0xE9, 0x20, 0x1D, 0xD5, 0x02, 0xA8, 0xB9, 0x6D, 
+	0x15, 0x49, 0xFF, 0x85, 0x04, 0xA9, 0xFF, 0x85, 0x05, 0x18, 0xA5, 0x04, 0x69, 0x01, 0x85, 0x04, 0xA5, 0x05, 0x69, 0x00, 0x85, 
+	0x05, 0xAD, 0x08, 0x02, 0x29, 0x02, 0xF0, 0x1B, 0xA9, 0x0F, 0x18, 0x7D, 0xD5, 0x02, 0xA8, 0x18, 0xB9, 0x6D, 0x15, 0x69, 0x01, 
+	0x65, 0x04, 0x85, 0x04, 0xA5, 0x05, 0x69, 0x00, 0x85, 0x05, 0x46, 0x05, 0x66, 0x04, 0xBD, 0xE8, 0x13, 0xC9, 0x0A, 0xF0, 0x1A, 
+	0xC9, 0x04, 0xF0, 0x16, 0xC9, 0x06, 0xF0, 0x12, 0x38, 0xBD, 0x64, 0x02, 0xE5, 0x04, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 0xE5, 
+	0x05, 0x9D, 0x68, 0x02, 0x60, 0x18, 0xBD, 0x64, 0x02, 0x65, 0x04, 0x9D, 0x64, 0x02, 0xBD, 0x68, 0x02, 0x65, 0x05, 0x9D, 0x68, 
+	0x02, 0x60, 0xBD, 0xE5, 0x02, 0xD0, 0x06, 0xA9, 0x00, 0x9D, 0xE9, 0x02, 0x60, 0x18, 0x7D, 0xDD, 0x02, 0x29, 0x3F, 0x9D, 0xDD, 
+	0x02, 0x4A, 0xC9, 0x10, 0x90, 0x17, 0x38, 0xE9, 0x10, 0x85, 0x00, 0x38, 0xA9, 0x0F, 0xE5, 0x00, 0x1D, 0xE1, 0x02, 0xA8, 0xB9, 
+	0x6D, 0x15, 0x4A, 0x85, 0x00, 0x4C, 0x21, 0x0C, 0x1D, 0xE1, 0x02, 0xA8, 0xB9, 0x6D, 0x15, 0x4A, 0x85, 0x00, 0x9D, 0xE9, 0x02, 
+	0x60, 0xBD, 0x79, 0x02, 0xF0, 0x1A, 0x85, 0x07, 0xBD, 0x75, 0x02, 0x85, 0x06, 0xBD, 0xA5, 0x02, 0xC9, 0xFF, 0xF0, 0x0C, 0x20, 
+	0x72, 0x0D, 0x9D, 0xA5, 0x02, 0xAD, 0x24, 0x02, 0x9D, 0x9D, 0x02, 0xBD, 0x81, 0x02, 0xF0, 0x7B, 0x85, 0x07, 0xBD, 0x7D, 0x02, 
+	0x85, 0x06, 0xBD, 0xA9, 0x02, 0xC9, 0xFF, 0xF0, 0x57, 0x20, 0x72, 0x0D, 0x9D, 0xA9, 0x02, 0xBD, 0x34, 0x02, 0xF0, 0x62, 0xA0, 
+	0x03, 0xB1, 0x06, 0xF0, 0x28, 0xC9, 0x01, 0xF0, 0x1B, 0x18, 0xBD, 0x34, 0x02, 0x6D, 0x24, 0x02, 0xC9, 0x01, 0x90, 0x08, 0xC9, 
+	0x5F, 0x90, 0x06, 0xA9, 0x5F, 0xD0, 0x02, 0xA9, 0x01, 0x9D, 0x34, 0x02, 0x4C, 0xA3, 0x0C, 0xAD, 0x24, 0x02, 0x18, 0x69, 0x01, 
+	0x4C, 0xA3, 0x0C, 0x18, 0xBD, 0x34, 0x02, 0x6D, 0x24, 0x02, 0xF0, 0x02, 0x10, 0x02, 0xA9, 0x01, 0xC9, 0x60, 0x90, 0x02, 0xA9, 
+	0x60, 0x20, 0xDF, 0x06, 0xA9, 0x01, 0x9D, 0xB9, 0x02, 0x4C, 0xC4, 0x0C, 0xA0, 0x03, 0xB1, 0x06, 0xF0, 0x10, 0xBD, 0xB9, 0x02, 
+	0xF0, 0x0B, 0xBD, 0x34, 0x02, 0x20, 0xDF, 0x06, 0xA9, 0x00, 0x9D, 0xB9, 0x02, 0xBD, 0x89, 0x02, 0xF0, 0x32, 0x85, 0x07, 0xBD, 
+	0x85, 0x02, 0x85, 0x06, 0xBD, 0xAD, 0x02, 0xC9, 0xFF, 0xF0, 0x24, 0x20, 0x72, 0x0D, 0x9D, 0xAD, 0x02, 0x18, 0xAD, 0x24, 0x02, 
+	0x7D, 0x60, 0x02, 0x9D, 0x60, 0x02, 0xAD, 0x24, 0x02, 0x10, 0x04, 0xA9, 0xFF, 0x30, 0x02, 0xA9, 0x00, 0x7D, 0x5C, 0x02, 0x9D, 
+	0x5C, 0x02, 0x20, 0xDB, 0x0F, 0xBD, 0x91, 0x02, 0xF0, 0x45, 0x85, 0x07, 0xBD, 0x8D, 0x02, 0x85, 0x06, 0xBD, 0xB1, 0x02, 0xC9, 
+	0xFF, 0xF0, 0x37, 0x20, 0x72, 0x0D, 0x9D, 0xB1, 0x02, 0xAD, 0x24, 0x02, 0x85, 0x04, 0x2A, 0x90, 0x07, 0xA9, 0xFF, 0x85, 0x05, 
+	0x4C, 0x27, 0x0D, 0xA9, 0x00, 0x85, 0x05, 0xA0, 0x04, 0x18, 0x26, 0x04, 0x26, 0x05, 0x88, 0xD0, 0xF8, 0x18, 0xA5, 0x04, 0x7D, 
+	0x60, 0x02, 0x9D, 0x60, 0x02, 0xA5, 0x05, 0x7D, 0x5C, 0x02, 0x9D, 0x5C, 0x02, 0x20, 0xDB, 0x0F, 0xBD, 0x99, 0x02, 0xF0, 0x27, 
+	0x85, 0x07, 0xBD, 0x95, 0x02, 0x85, 0x06, 0xBD, 0xB5, 0x02, 0xC9, 0xFF, 0xF0, 0x19, 0x20, 0x72, 0x0D, 0x9D, 0xB5, 0x02, 0xAD, 
+	0x24, 0x02, 0x48, 0xBD, 0xA1, 0x02, 0x29, 0xF0, 0x9D, 0xA1, 0x02, 0x68, 0x1D, 0xA1, 0x02, 0x9D, 0xA1, 0x02, 0x60, 0x18, 0x69, 
+	0x04, 0xA8, 0xB1, 0x06, 0x8D, 0x24, 0x02, 0x88, 0x88, 0x88, 0x98, 0xA0, 0x00, 0xD1, 0x06, 0xF0, 0x07, 0xA0, 0x02, 0xD1, 0x06, 
+	0xF0, 0x1D, 0x60, 0xC8, 0xB1, 0x06, 0xC9, 0xFF, 0xD0, 0x01, 0x60, 0x48, 0xBD, 0x48, 0x02, 0xD0, 0x02, 0x68, 0x60, 0xA0, 0x02, 
+	0xB1, 0x06, 0xD0, 0x02, 0x68, 0x60, 0x68, 0xA9, 0xFF, 0x60, 0x85, 0x00, 0xBD, 0x48, 0x02, 0xD0, 0x0D, 0x88, 0xB1, 0x06, 0xC9, 
+	0xFF, 0xD0, 0xDE, 0xA5, 0x00, 0x38, 0xE9, 0x01, 0x60, 0xA5, 0x00, 0x60, 0x98, 0x48, 0xBD, 0x79, 0x02, 0xF0, 0x13, 0x85, 0x07, 
+	0xBD, 0x75, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xA5, 0x02, 0xBD, 0x81, 0x02, 0xF0, 
+	0x13, 0x85, 0x07, 0xBD, 0x7D, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xA9, 0x02, 0xBD, 
+	0x89, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x85, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 
+	0xAD, 0x02, 0xBD, 0x91, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x8D, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 0xF0, 0x06, 0x38, 
+	0xE9, 0x01, 0x9D, 0xB1, 0x02, 0xBD, 0x99, 0x02, 0xF0, 0x13, 0x85, 0x07, 0xBD, 0x95, 0x02, 0x85, 0x06, 0xA0, 0x02, 0xB1, 0x06, 
+	0xF0, 0x06, 0x38, 0xE9, 0x01, 0x9D, 0xB5, 0x02, 0x68, 0xA8, 0x60, 0xA9, 0x00, 0x9D, 0xA5, 0x02, 0x9D, 0xA9, 0x02, 0x9D, 0xAD, 
+	0x02, 0x9D, 0xB1, 0x02, 0x9D, 0xB5, 0x02, 0x60, 0x85, 0x02, 0x84, 0x00, 0xA0, 0x00, 0x18, 0x6D, 0x02, 0x02, 0x85, 0x04, 0x98, 
+	0x6D, 0x03, 0x02, 0x85, 0x05, 0x18, 0xB1, 0x04, 0x6D, 0x6D, 0x16, 0x85, 0x06, 0xC8, 0xB1, 0x04, 0x6D, 0x6E, 0x16, 0x85, 0x07, 
+	0xBD, 0xE8, 0x13, 0xA8, 0xB9, 0x84, 0x0E, 0x85, 0x04, 0xC8, 0xB9, 0x84, 0x0E, 0x85, 0x05, 0xA0, 0x00, 0x6C, 0x04, 0x00, 0x90, 
+	0x0E, 0x90, 0x0E, 0xD9, 0x0F, 0xD8, 0x0F, 0x90, 0x0E, 0xDA, 0x0F, 0xB1, 0x06, 0x85, 0x02, 0xC8, 0x66, 0x02, 0x90, 0x34, 0x18, 
+	0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 0x75, 0x02, 
+	0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x79, 0x02, 0xD0, 0x03, 0x4C, 0xD5, 0x0E, 0xA5, 0x04, 0x9D, 0x75, 0x02, 0xA5, 0x05, 0x9D, 0x79, 
+	0x02, 0xA9, 0x00, 0x9D, 0xA5, 0x02, 0x4C, 0xD5, 0x0E, 0xA9, 0x00, 0x9D, 0x75, 0x02, 0x9D, 0x79, 0x02, 0x66, 0x02, 0x90, 0x34, 
+	0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 0x7D, 
+	0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x81, 0x02, 0xD0, 0x03, 0x4C, 0x15, 0x0F, 0xA5, 0x04, 0x9D, 0x7D, 0x02, 0xA5, 0x05, 0x9D, 
+	0x81, 0x02, 0xA9, 0x00, 0x9D, 0xA9, 0x02, 0x4C, 0x15, 0x0F, 0xA9, 0x00, 0x9D, 0x7D, 0x02, 0x9D, 0x81, 0x02, 0x66, 0x02, 0x90, 
+	0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 0xDD, 
+	0x85, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x89, 0x02, 0xD0, 0x03, 0x4C, 0x55, 0x0F, 0xA5, 0x04, 0x9D, 0x85, 0x02, 0xA5, 0x05, 
+	0x9D, 0x89, 0x02, 0xA9, 0x00, 0x9D, 0xAD, 0x02, 0x4C, 0x55, 0x0F, 0xA9, 0x00, 0x9D, 0x85, 0x02, 0x9D, 0x89, 0x02, 0x66, 0x02, 
+	0x90, 0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 0x04, 
+	0xDD, 0x8D, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x91, 0x02, 0xD0, 0x03, 0x4C, 0x95, 0x0F, 0xA5, 0x04, 0x9D, 0x8D, 0x02, 0xA5, 
+	0x05, 0x9D, 0x91, 0x02, 0xA9, 0x00, 0x9D, 0xB1, 0x02, 0x4C, 0x95, 0x0F, 0xA9, 0x00, 0x9D, 0x8D, 0x02, 0x9D, 0x91, 0x02, 0x66, 
+	0x02, 0x90, 0x34, 0x18, 0xB1, 0x06, 0x6D, 0x6D, 0x16, 0x85, 0x04, 0xC8, 0xB1, 0x06, 0x6D, 0x6E, 0x16, 0x85, 0x05, 0xC8, 0xA5, 
+	0x04, 0xDD, 0x95, 0x02, 0xD0, 0x0A, 0xA5, 0x05, 0xDD, 0x99, 0x02, 0xD0, 0x03, 0x4C, 0xD5, 0x0F, 0xA5, 0x04, 0x9D, 0x95, 0x02, 
+	0xA5, 0x05, 0x9D, 0x99, 0x02, 0xA9, 0x00, 0x9D, 0xB5, 0x02, 0x4C, 0xD5, 0x0F, 0xA9, 0x00, 0x9D, 0x95, 0x02, 0x9D, 0x99, 0x02, 
+	0xA4, 0x00, 0x60, 0x60, 0x60, 0x60, 0xBD, 0xE8, 0x13, 0xA8, 0xB9, 0xEF, 0x0F, 0x85, 0x04, 0xC8, 0xB9, 0xEF, 0x0F, 0x85, 0x05, 
+	0xA0, 0x00, 0x6C, 0x04, 0x00, 0xFC, 0x0F, 0x19, 0x10, 0xFB, 0x0F, 0x19, 0x10, 0xFC, 0x0F, 0xFB, 0x0F, 0x60, 0xBD, 0x5C, 0x02, 
+	0x30, 0x0F, 0xC9, 0x08, 0x90, 0x0A, 0xA9, 0x07, 0x9D, 0x5C, 0x02, 0xA9, 0xFF, 0x9D, 0x60, 0x02, 0x60, 0xA9, 0x00, 0x9D, 0x60, 
+	0x02, 0x9D, 0x5C, 0x02, 0x60, 0xBD, 0x5C, 0x02, 0x30, 0x0F, 0xC9, 0x10, 0x90, 0x0A, 0xA9, 0x0F, 0x9D, 0x5C, 0x02, 0xA9, 0xFF, 
+	0x9D, 0x60, 0x02, 0x60, 0xA9, 0x00, 0x9D, 0x60, 0x02, 0x9D, 0x5C, 0x02, 0x60, 0xAD, 0x11, 0x02, 0xD0, 0x11, 0xA9, 0x00, 0x8D, 
+	0x15, 0x40, 0x60, 0xA9, 0xC0, 0x8D, 0x17, 0x40, 0xA9, 0x40, 0x8D, 0x17, 0x40, 0x60, 0xAD, 0x09, 0x02, 0x29, 0x01, 0xD0, 0x03, 
+	0x4C, 0xF1, 0x10, 0xAD, 0x34, 0x02, 0xF0, 0x72, 0xAD, 0x39, 0x02, 0x0A, 0xF0, 0x6C, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0x9D, 0x02, 
+	0xF0, 0x63, 0x05, 0x00, 0xAA, 0xBD, 0xD0, 0x12, 0x38, 0xED, 0xE9, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x39, 0x02, 
+	0xF0, 0x02, 0xA9, 0x01, 0x48, 0xAD, 0xA1, 0x02, 0x29, 0x03, 0xAA, 0x68, 0x1D, 0xCC, 0x12, 0x09, 0x30, 0x8D, 0x00, 0x40, 0xAD, 
+	0x68, 0x02, 0x29, 0xF8, 0xF0, 0x0A, 0xA9, 0x07, 0x8D, 0x68, 0x02, 0xA9, 0xFF, 0x8D, 0x64, 0x02, 0xAD, 0x71, 0x02, 0xF0, 0x2E, 
+	0x29, 0x80, 0xF0, 0x46, 0xAD, 0x71, 0x02, 0x8D, 0x01, 0x40, 0x29, 0x7F, 0x8D, 0x71, 0x02, 0x20, 0x41, 0x10, 0xAD, 0x64, 0x02, 
+	0x8D, 0x02, 0x40, 0xAD, 0x68, 0x02, 0x8D, 0x03, 0x40, 0xA9, 0xFF, 0x8D, 0x73, 0x02, 0x4C, 0xF1, 0x10, 0xA9, 0x30, 0x8D, 0x00, 
+	0x40, 0x4C, 0xF1, 0x10, 0xA9, 0x08, 0x8D, 0x01, 0x40, 0x20, 0x41, 0x10, 0xAD, 0x64, 0x02, 0x8D, 0x02, 0x40, 0xAD, 0x68, 0x02, 
+	0xCD, 0x73, 0x02, 0xF0, 0x06, 0x8D, 0x03, 0x40, 0x8D, 0x73, 0x02, 0xAD, 0x09, 0x02, 0x29, 0x02, 0xD0, 0x03, 0x4C, 0x96, 0x11, 
+	0xAD, 0x35, 0x02, 0xF0, 0x72, 0xAD, 0x3A, 0x02, 0x0A, 0xF0, 0x6C, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0x9E, 0x02, 0xF0, 0x63, 0x05, 
+	0x00, 0xAA, 0xBD, 0xD0, 0x12, 0x38, 0xED, 0xEA, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x3A, 0x02, 0xF0, 0x02, 0xA9, 
+	0x01, 0x48, 0xAD, 0xA2, 0x02, 0x29, 0x03, 0xAA, 0x68, 0x1D, 0xCC, 0x12, 0x09, 0x30, 0x8D, 0x04, 0x40, 0xAD, 0x69, 0x02, 0x29, 
+	0xF8, 0xF0, 0x0A, 0xA9, 0x07, 0x8D, 0x69, 0x02, 0xA9, 0xFF, 0x8D, 0x65, 0x02, 0xAD, 0x72, 0x02, 0xF0, 0x2E, 0x29, 0x80, 0xF0, 
+	0x46, 0xAD, 0x72, 0x02, 0x8D, 0x05, 0x40, 0x29, 0x7F, 0x8D, 0x72, 0x02, 0x20, 0x41, 0x10, 0xAD, 0x65, 0x02, 0x8D, 0x06, 0x40, 
+	0xAD, 0x69, 0x02, 0x8D, 0x07, 0x40, 0xA9, 0xFF, 0x8D, 0x74, 0x02, 0x4C, 0x96, 0x11, 0xA9, 0x30, 0x8D, 0x04, 0x40, 0x4C, 0x96, 
+	0x11, 0xA9, 0x08, 0x8D, 0x05, 0x40, 0x20, 0x41, 0x10, 0xAD, 0x65, 0x02, 0x8D, 0x06, 0x40, 0xAD, 0x69, 0x02, 0xCD, 0x74, 0x02, 
+	0xF0, 0x06, 0x8D, 0x07, 0x40, 0x8D, 0x74, 0x02, 0xAD, 0x09, 0x02, 0x29, 0x04, 0xF0, 0x39, 0xAD, 0x9F, 0x02, 0xF0, 0x2F, 0xAD, 
+	0x3B, 0x02, 0xF0, 0x2A, 0xAD, 0x36, 0x02, 0xF0, 0x25, 0xA9, 0x81, 0x8D, 0x08, 0x40, 0xAD, 0x6A, 0x02, 0x29, 0xF8, 0xF0, 0x0A, 
+	0xA9, 0x07, 0x8D, 0x6A, 0x02, 0xA9, 0xFF, 0x8D, 0x66, 0x02, 0xAD, 0x66, 0x02, 0x8D, 0x0A, 0x40, 0xAD, 0x6A, 0x02, 0x8D, 0x0B, 
+	0x40, 0x4C, 0xD6, 0x11, 0xA9, 0x00, 0x8D, 0x08, 0x40, 0xAD, 0x09, 0x02, 0x29, 0x08, 0xF0, 0x56, 0xAD, 0x37, 0x02, 0xF0, 0x4C, 
+	0xAD, 0x3C, 0x02, 0x0A, 0xF0, 0x46, 0x29, 0xF0, 0x85, 0x00, 0xAD, 0xA0, 0x02, 0xF0, 0x3D, 0x05, 0x00, 0xAA, 0xBD, 0xD0, 0x12, 
+	0x38, 0xED, 0xEC, 0x02, 0x10, 0x02, 0xA9, 0x00, 0xD0, 0x07, 0xAD, 0x3C, 0x02, 0xF0, 0x02, 0xA9, 0x01, 0x09, 0x30, 0x8D, 0x0C, 
+	0x40, 0xA9, 0x00, 0x8D, 0x0D, 0x40, 0xAD, 0xA4, 0x02, 0x6A, 0x6A, 0x29, 0x80, 0x85, 0x00, 0xAD, 0x67, 0x02, 0x29, 0x0F, 0x49, 
+	0x0F, 0x05, 0x00, 0x8D, 0x0E, 0x40, 0xA9, 0x00, 0x8D, 0x0F, 0x40, 0xF0, 0x05, 0xA9, 0x30, 0x8D, 0x0C, 0x40, 0xAD, 0x09, 0x02, 
+	0x29, 0x10, 0xD0, 0x01, 0x60, 0xA2, 0x04, 0xAD, 0xF3, 0x02, 0xF0, 0x0D, 0xCE, 0xF4, 0x02, 0xD0, 0x08, 0x8D, 0xF4, 0x02, 0xA9, 
+	0x01, 0x9D, 0x34, 0x02, 0xAD, 0xF1, 0x02, 0x30, 0x03, 0x8D, 0x11, 0x40, 0xA9, 0x80, 0x8D, 0xF1, 0x02, 0xBD, 0x34, 0x02, 0xF0, 
+	0x5D, 0x30, 0x4B, 0xAD, 0xF0, 0x02, 0x29, 0x40, 0x85, 0x00, 0xAD, 0xF5, 0x02, 0x10, 0x03, 0xAD, 0xF0, 0x02, 0x05, 0x00, 0x8D, 
+	0x10, 0x40, 0xA9, 0x80, 0x8D, 0xF5, 0x02, 0xAD, 0xEF, 0x02, 0xF0, 0x03, 0x20, 0xD4, 0x13, 0x18, 0xAD, 0xED, 0x02, 0x6D, 0xF2, 
+	0x02, 0x8D, 0x12, 0x40, 0xAD, 0xF2, 0x02, 0x0A, 0x0A, 0x85, 0x00, 0x38, 0xAD, 0xEE, 0x02, 0xE5, 0x00, 0x8D, 0x13, 0x40, 0xA9, 
+	0x80, 0x9D, 0x34, 0x02, 0xA9, 0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x1F, 0x8D, 0x15, 0x40, 0x60, 0xC9, 0xFF, 0xF0, 0x01, 0x60, 0xA9, 
+	0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x80, 0x9D, 0x34, 0x02, 0x60, 0xA9, 0x0F, 0x8D, 0x15, 0x40, 0xA9, 0x80, 0x8D, 0x11, 0x40, 0x9D, 
+	0x34, 0x02, 0x60, 0x00, 0x40, 0x80, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 
+	0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x03, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x03, 
+	0x03, 0x03, 0x04, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x05, 0x00, 0x01, 
+	0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x04, 0x05, 0x05, 0x06, 0x00, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 
+	0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 0x06, 0x06, 0x07, 0x00, 0x01, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 
+	0x06, 0x06, 0x07, 0x08, 0x00, 0x01, 0x01, 0x01, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x06, 0x06, 0x07, 0x07, 0x08, 0x09, 0x00, 
+	0x01, 0x01, 0x02, 0x02, 0x03, 0x04, 0x04, 0x05, 0x06, 0x06, 0x07, 0x08, 0x08, 0x09, 0x0A, 0x00, 0x01, 0x01, 0x02, 0x02, 0x03, 
+	0x04, 0x05, 0x05, 0x06, 0x07, 0x08, 0x08, 0x09, 0x0A, 0x0B, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x04, 0x05, 0x06, 0x07, 0x08, 
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 
+	0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x00, 0x01, 0x02, 0x03, 0x04, 
+	0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x8D, 0xFB, 0x5F, 0x60, 0x18, 0x8D, 0xFC, 0x5F, 0x69, 0x01, 
+	0x8D, 0xFD, 0x5F, 0x69, 0x01, 0x8D, 0xFE, 0x5F, 0x60, 0x01, 0x02, 0x03, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5B, 0x0D, 
+	0x9C, 0x0C, 0xE6, 0x0B, 0x3B, 0x0B, 0x9A, 0x0A, 0x01, 0x0A, 0x72, 0x09, 0xEA, 0x08, 0x6A, 0x08, 0xF1, 0x07, 0x7F, 0x07, 0x13, 
+	0x07, 0xAD, 0x06, 0x4D, 0x06, 0xF3, 0x05, 0x9D, 0x05, 0x4C, 0x05, 0x00, 0x05, 0xB8, 0x04, 0x74, 0x04, 0x34, 0x04, 0xF8, 0x03, 
+	0xBF, 0x03, 0x89, 0x03, 0x56, 0x03, 0x26, 0x03, 0xF9, 0x02, 0xCE, 0x02, 0xA6, 0x02, 0x80, 0x02, 0x5C, 0x02, 0x3A, 0x02, 0x1A, 
+	0x02, 0xFB, 0x01, 0xDF, 0x01, 0xC4, 0x01, 0xAB, 0x01, 0x93, 0x01, 0x7C, 0x01, 0x67, 0x01, 0x52, 0x01, 0x3F, 0x01, 0x2D, 0x01, 
+	0x1C, 0x01, 0x0C, 0x01, 0xFD, 0x00, 0xEF, 0x00, 0xE1, 0x00, 0xD5, 0x00, 0xC9, 0x00, 0xBD, 0x00, 0xB3, 0x00, 0xA9, 0x00, 0x9F, 
+	0x00, 0x96, 0x00, 0x8E, 0x00, 0x86, 0x00, 0x7E, 0x00, 0x77, 0x00, 0x70, 0x00, 0x6A, 0x00, 0x64, 0x00, 0x5E, 0x00, 0x59, 0x00, 
+	0x54, 0x00, 0x4F, 0x00, 0x4B, 0x00, 0x46, 0x00, 0x42, 0x00, 0x3F, 0x00, 0x3B, 0x00, 0x38, 0x00, 0x34, 0x00, 0x31, 0x00, 0x2F, 
+	0x00, 0x2C, 0x00, 0x29, 0x00, 0x27, 0x00, 0x25, 0x00, 0x23, 0x00, 0x21, 0x00, 0x1F, 0x00, 0x1D, 0x00, 0x1B, 0x00, 0x1A, 0x00, 
+	0x18, 0x00, 0x17, 0x00, 0x15, 0x00, 0x14, 0x00, 0x13, 0x00, 0x12, 0x00, 0x11, 0x00, 0x10, 0x00, 0x0F, 0x00, 0x0E, 0x00, 0x0D, 
+	0x00, 0x68, 0x0C, 0xB6, 0x0B, 0x0E, 0x0B, 0x6F, 0x0A, 0xD9, 0x09, 0x4B, 0x09, 0xC6, 0x08, 0x48, 0x08, 0xD1, 0x07, 0x60, 0x07, 
+	0xF6, 0x06, 0x92, 0x06, 0x34, 0x06, 0xDB, 0x05, 0x86, 0x05, 0x37, 0x05, 0xEC, 0x04, 0xA5, 0x04, 0x62, 0x04, 0x23, 0x04, 0xE8, 
+	0x03, 0xB0, 0x03, 0x7B, 0x03, 0x49, 0x03, 0x19, 0x03, 0xED, 0x02, 0xC3, 0x02, 0x9B, 0x02, 0x75, 0x02, 0x52, 0x02, 0x31, 0x02, 
+	0x11, 0x02, 0xF3, 0x01, 0xD7, 0x01, 0xBD, 0x01, 0xA4, 0x01, 0x8C, 0x01, 0x76, 0x01, 0x61, 0x01, 0x4D, 0x01, 0x3A, 0x01, 0x29, 
+	0x01, 0x18, 0x01, 0x08, 0x01, 0xF9, 0x00, 0xEB, 0x00, 0xDE, 0x00, 0xD1, 0x00, 0xC6, 0x00, 0xBA, 0x00, 0xB0, 0x00, 0xA6, 0x00, 
+	0x9D, 0x00, 0x94, 0x00, 0x8B, 0x00, 0x84, 0x00, 0x7C, 0x00, 0x75, 0x00, 0x6E, 0x00, 0x68, 0x00, 0x62, 0x00, 0x5D, 0x00, 0x57, 
+	0x00, 0x52, 0x00, 0x4E, 0x00, 0x49, 0x00, 0x45, 0x00, 0x41, 0x00, 0x3E, 0x00, 0x3A, 0x00, 0x37, 0x00, 0x34, 0x00, 0x31, 0x00, 
+	0x2E, 0x00, 0x2B, 0x00, 0x29, 0x00, 0x26, 0x00, 0x24, 0x00, 0x22, 0x00, 0x20, 0x00, 0x1E, 0x00, 0x1D, 0x00, 0x1B, 0x00, 0x19, 
+	0x00, 0x18, 0x00, 0x16, 0x00, 0x15, 0x00, 0x14, 0x00, 0x13, 0x00, 0x12, 0x00, 0x11, 0x00, 0x10, 0x00, 0x0F, 0x00, 0x0E, 0x00, 
+	0x0D, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 
+	0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 
+	0x00, 0x00, 0x01, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05, 0x06, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x01, 0x02, 0x03, 
+	0x04, 0x05, 0x06, 0x07, 0x07, 0x08, 0x08, 0x09, 0x09, 0x09, 0x09, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 
+	0x09, 0x0A, 0x0B, 0x0B, 0x0B, 0x0B, 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0C, 0x0D, 0x0D, 
+	0x0D, 0x00, 0x01, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x00, 0x02, 0x04, 0x06, 
+	0x08, 0x0A, 0x0C, 0x0D, 0x0F, 0x11, 0x12, 0x13, 0x14, 0x15, 0x15, 0x15, 0x00, 0x02, 0x05, 0x08, 0x0B, 0x0E, 0x10, 0x13, 0x15, 
+	0x17, 0x18, 0x1A, 0x1B, 0x1C, 0x1D, 0x1D, 0x00, 0x04, 0x08, 0x0C, 0x10, 0x14, 0x18, 0x1B, 0x1F, 0x22, 0x24, 0x26, 0x28, 0x2A, 
+	0x2B, 0x2B, 0x00, 0x06, 0x0C, 0x12, 0x18, 0x1E, 0x23, 0x28, 0x2D, 0x31, 0x35, 0x38, 0x3B, 0x3D, 0x3E, 0x3F, 0x00, 0x09, 0x12, 
+	0x1B, 0x24, 0x2D, 0x35, 0x3C, 0x43, 0x4A, 0x4F, 0x54, 0x58, 0x5B, 0x5E, 0x5F, 0x00, 0x0C, 0x18, 0x25, 0x30, 0x3C, 0x47, 0x51, 
+	0x5A, 0x62, 0x6A, 0x70, 0x76, 0x7A, 0x7D, 0x7F, 0x6F, 0x16, 
+};
+
+const int DRIVER_RELOC_WORD_2A03[] = {
+	9, 12, 16, 138, 143, 153, 162, 203, 230, 294, 297, 322, 330, 342, 351, 376, 399, 407, 420, 429, 
+	523, 544, 618, 628, 637, 644, 647, 655, 658, 682, 708, 733, 757, 772, 775, 807, 837, 845, 873, 885, 
+	925, 953, 961, 964, 972, 995, 1017, 1026, 1033, 1039, 1052, 1059, 1062, 1119, 1127, 1130, 1142, 1157, 1160, 1168, 
+	1175, 1204, 1217, 1224, 1228, 1248, 1254, 1268, 1321, 1323, 1325, 1327, 1329, 1331, 1333, 1335, 1337, 1339, 1341, 1343, 
+	1345, 1347, 1349, 1351, 1353, 1355, 1357, 1359, 1361, 1363, 1365, 1367, 1369, 1371, 1373, 1375, 1377, 1380, 1383, 1386, 
+	1389, 1395, 1403, 1406, 1412, 1415, 1418, 1424, 1427, 1430, 1436, 1439, 1445, 1448, 1456, 1459, 1468, 1471, 1482, 1485, 
+	1496, 1499, 1510, 1513, 1524, 1541, 1544, 1550, 1553, 1587, 1590, 1609, 1615, 1618, 1624, 1632, 1635, 1642, 1645, 1651, 
+	1654, 1671, 1674, 1680, 1683, 1694, 1697, 1708, 1711, 1717, 1720, 1728, 1731, 1748, 1751, 1757, 1802, 1809, 1862, 2097, 
+	2240, 2243, 2246, 2249, 2252, 2255, 2258, 2298, 2316, 2372, 2380, 2442, 2445, 2482, 2494, 2514, 2526, 2547, 2562, 2579, 
+	2582, 2585, 2602, 2605, 2608, 2702, 2738, 2764, 2781, 2787, 2801, 2814, 2820, 2832, 2840, 2884, 2887, 2894, 2903, 2920, 
+	2929, 2939, 2978, 2997, 3087, 3093, 3100, 3129, 3160, 3205, 3214, 3236, 3244, 3261, 3288, 3321, 3343, 3361, 3395, 3417, 
+	3684, 3692, 3697, 3701, 3707, 3716, 3718, 3720, 3722, 3724, 3726, 3741, 3749, 3769, 3787, 3805, 3813, 3833, 3851, 3869, 
+	3877, 3897, 3915, 3933, 3941, 3961, 3979, 3997, 4005, 4025, 4043, 4060, 4064, 4070, 4079, 4081, 4083, 4085, 4087, 4089, 
+	4180, 4206, 4234, 4279, 4299, 4307, 4315, 4345, 4371, 4399, 4444, 4464, 4472, 4480, 4559, 4597, 4738, 5741, 
+};
+
+const int DRIVER_RELOC_LOW_2A03[] = {
+	195, -32531, 220, -32595, 
+};
+
+const int DRIVER_RELOC_HIGH_2A03[] = {
+	199, 5101, 224, 5293, 
+};
+
@@ -6,7 +6,7 @@
 //------------------------------------------------------------------------
 
 // Get rid of visual studio specific warnings
-#define _SCL_SECURE_NO_WARNINGS
+#define _SCL_SECURE_NO_WARNINGS
 
 #include "resample.hpp"
 //------------------------------------------------------------------------
@@ -16,51 +16,45 @@
 #include <algorithm>
 //------------------------------------------------------------------------
 
-/** Below is for debug purpose only; normally commented-out**/
-/*
+// // // SSE is used for the filter whenever the target has it
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define RESAMPLE_SSE
+#include <xmmintrin.h>
+#endif
 
-#define inner_product inner_product2_2eA6jpo51vPqr9ww
+/** small utility function computing two dot products in one pass **/
 
-namespace std {
-template <typename T, typename InIter1, typename InIter2>
- T inner_product2_2eA6jpo51vPqr9ww(InIter1 first1, InIter1 last1, InIter2 first2, T init)
+namespace {
+
+void dot2(const float *x, const float *a, const float *b, size_t n,
+          float &ra, float &rb)
 {
-    for (;first1 != last1; ++first1, ++first2)
+    size_t i = 0;
+    float sa = 0.f, sb = 0.f;
+#ifdef RESAMPLE_SSE
+    __m128 va = _mm_setzero_ps(), vb = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4)
     {
-        T temp;
-        T t1 = *first1;
-        T t2 = *first2;
-        temp = t1 * t2;
-        init += temp;
+        const __m128 vx = _mm_loadu_ps(x + i);
+        va = _mm_add_ps(va, _mm_mul_ps(vx, _mm_loadu_ps(a + i)));
+        vb = _mm_add_ps(vb, _mm_mul_ps(vx, _mm_loadu_ps(b + i)));
     }
-    return init;
-}
+    float ta[4], tb[4];
+    _mm_storeu_ps(ta, va);
+    _mm_storeu_ps(tb, vb);
+    sa = (ta[0] + ta[1]) + (ta[2] + ta[3]);
+    sb = (tb[0] + tb[1]) + (tb[2] + tb[3]);
+#endif
+    for (; i < n; ++i)
+    {
+        sa += x[i] * a[i];
+        sb += x[i] * b[i];
+    }
+    ra = sa;
+    rb = sb;
 }
-//*/
-
-/** small utility class to change a function object into an iterator **/
 
-template <typename func>
- class func_iterator : public std::iterator<std::forward_iterator_tag, float>
-{
-    func f_;
-    float x_;
-    float step_;
-public:
-    func_iterator(func f, float initval, float step=1.f)
-     : f_(f), x_(initval), step_(step) {}
-
-    func_iterator &operator++() { x_ += step_; return *this; }
-    float operator*() { return f_(x_); }
-};
-
-/** small utility function to create a func_iterator **/
-
-template <typename func>
- func_iterator<func> make_func_iterator(func f, float init, float step)
-{
-    return func_iterator<func>(f, init, step);
-}
+} // anonymous namespace
 
 //------------------------------------------------------------------------
 
@@ -82,7 +76,8 @@ namespace jarh
 //
 //------------------------------------------------------------------------
 resample_base::resample_base(const sinc &s)
- : flags_(goodbit), sinc_(s)
+ : flags_(goodbit), sinc_(s), taps_(0), pos_(0),
+   cutoff_(0.f), ratio_(0.f)      // // //
 {
 }
 //------------------------------------------------------------------------
@@ -112,24 +107,47 @@ void resample_base::ratio(float theratio)
 
     sincstep_= (std::min)(1.f, ratio_) * cutoff_;
 
-    buf_.resize(1 +
-                static_cast<size_t>(std::floor(
+    taps_ = 1 + static_cast<size_t>(std::floor(
                           2*sinc_.range() / sincstep_
-                          ))
-            );
+                          ));
+
+    // // // room for the window to slide over several output samples
+    buf_.assign(taps_ * 4, 0.f);
+    pos_ = 0;
+
+    // // // evaluate the sinc once for every phase of the input position
+    // between two samples; conv() interpolates between adjacent phases
+    bank_.resize((phases + 1) * taps_);
+    for (size_t p = 0; p <= phases; ++p)
+    {
+        const float x0 = -sinc_.range() + sincstep_ - (float)p / phases * sincstep_;
+        float *row = &bank_[p * taps_];
+        for (size_t k = 0; k < taps_; ++k)
+            row[k] = sinc_(x0 + k * sincstep_);
+    }
 }
 //------------------------------------------------------------------------
 
 //------------------------------------------------------------------------
 float resample_base::conv() const
 {
-    return std::inner_product(buf_.begin(),
-                              buf_.end(),
-                              make_func_iterator(sinc_,
-                                                -sinc_.range() + sincstep_ - subidx_ * sincstep_,
-                                                 sincstep_
-                                            ),
-                                0.f);
+    // // // filter with the two nearest phases of the precomputed bank
+    const float x = subidx_ * phases;
+    const size_t p = static_cast<size_t>(x);
+    const float *row = &bank_[p * taps_];
+
+    float lo, hi;
+    dot2(&buf_[pos_], row, row + taps_, taps_, lo, hi);
+    return lo + (x - p) * (hi - lo);
+}
+//------------------------------------------------------------------------
+
+//------------------------------------------------------------------------
+size_t resample_base::needed() const
+{
+    // // // same arithmetic as updateidx()
+    const size_t inc = static_cast<size_t>(subidx_ + invratio_);
+    return (std::min)(inc, taps_);
 }
 //------------------------------------------------------------------------
 
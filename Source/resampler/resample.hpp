@@ -59,6 +59,9 @@ public:
     resample_base(const sinc &s);
     ~resample_base() {}
 
+    // // // number of phases of the precomputed filter bank
+    static const size_t phases = 256;
+
     typedef int iostate;
     enum
     {
@@ -90,6 +93,11 @@ public:
     bool operator!() const { return fail(); }
     operator const void *() const { return fail() ? 0 : this; }
 
+    // // // number of input samples the next call to get() will request
+    // from fill(), so that a stream can be fed only when enough input is
+    // available
+    size_t needed() const;
+
     // state control
     void clear(iostate b= goodbit)
     {
@@ -105,7 +113,10 @@ protected:
 private:
     iostate flags_;
     const sinc &sinc_;
-    std::vector<float> buf_;
+    std::vector<float> buf_;        // // // sliding window storage
+    std::vector<float> bank_;       // // // sinc evaluated at every phase
+    size_t taps_;                   // // // size of the window
+    size_t pos_;                    // // // start of the window in buf_
     float cutoff_;
     float ratio_;
     float invratio_;
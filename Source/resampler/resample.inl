@@ -49,14 +49,13 @@ template <typename Base>
     bool res = static_cast<Base *>(this)->initstream();
     if (res)
     {
-        const size_t offset = (size_t)std::ceil((float)(buf_.size()/2)) - 1;
-        float *start = &*buf_.begin() + offset;
-
-        std::fill(&*buf_.begin(), start, 0.f);
-//        fillcheck(&* buf_.begin(), start, &*buf_.end());
-        fillcheck(	&buf_[0], start, &buf_[0] + buf_.size());
-
+        // // // start at the beginning of the window storage
+        pos_ = 0;
+        const size_t offset = (size_t)std::ceil((float)(taps_/2)) - 1;
+        float *first = &buf_[0];
 
+        std::fill(first, first + offset, 0.f);
+        fillcheck(first, first + offset, first + taps_);
     }
     else
     {
@@ -86,17 +85,29 @@ template <typename Base>
  void resample<Base>::update_buffer()
 {
     const size_t offset = updateidx();
-    float *start = &* buf_.begin();
     if (offset)
     {
-        if (offset < buf_.size())
-            start = &*std::copy(buf_.begin()+offset, buf_.end(), buf_.begin());
-
-
+        // // // slide the window instead of moving its contents on every
+        // sample; the retained samples are only moved back to the front
+        // when the window reaches the end of the storage
+        float *first = &buf_[0];
+        size_t keep = 0;
+        if (offset < taps_)
+        {
+            keep = taps_ - offset;
+            if (pos_ + offset + taps_ > buf_.size())
+            {
+                std::copy(first + pos_ + offset, first + pos_ + taps_, first);
+                pos_ = 0;
+            }
+            else
+                pos_ += offset;
+        }
+        else
+            pos_ = 0;
 
-		fillcheck(&buf_[0], start, &buf_[0] + buf_.size());
+        fillcheck(first + pos_, first + pos_ + keep, first + pos_ + taps_);
     }
-
 }
 //------------------------------------------------------------------------
 // fillcheck(float *first, float *mid, float *last) -
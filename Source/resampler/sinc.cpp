@@ -7,7 +7,7 @@
 #include "sinc.hpp"
 //------------------------------------------------------------------------
 #include <limits>
-#include <cmath>
+#include <cmath>
 #include <algorithm>		// // //
 //------------------------------------------------------------------------
 
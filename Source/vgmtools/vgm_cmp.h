@@ -1,11 +1,21 @@
-#pragma once
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-extern int CompressVGM(const char *Filename);
-
-#ifdef __cplusplus
-}
-#endif
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// // // in-memory compressor, every context is independent of the others
+typedef struct vgm_cmp_context VGM_CMP_CONTEXT;
+
+extern VGM_CMP_CONTEXT* VGMCmp_Create(void);
+extern void VGMCmp_Destroy(VGM_CMP_CONTEXT* ctx);
+
+// compresses a complete VGM image, returns 0 on success
+// the image must stay valid as long as the result is used
+extern int VGMCmp_Compress(VGM_CMP_CONTEXT* ctx, const unsigned char* Data, unsigned int DataLen);
+extern const unsigned char* VGMCmp_GetData(const VGM_CMP_CONTEXT* ctx);
+extern unsigned int VGMCmp_GetDataSize(const VGM_CMP_CONTEXT* ctx);
+
+#ifdef __cplusplus
+}
+#endif
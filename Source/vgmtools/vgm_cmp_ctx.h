@@ -0,0 +1,40 @@
+#ifndef __VGM_CMP_CTX_H__
+#define __VGM_CMP_CTX_H__
+
+// // // State of a single compression run, shared by vgm_cmp.c and chip_cmp.c
+
+#include "stdtype.h"
+#include "stdbool.h"
+#include "VGMFile.h"
+#include "vgm_cmp.h"
+
+struct vgm_cmp_context
+{
+	// vgm_cmp.c
+	VGM_HEADER VGMHead;
+	UINT32 VGMDataLen;
+	const UINT8* VGMData;	// either the caller's image or VGMBuf
+	UINT8* VGMBuf;
+	UINT32 VGMPos;
+	INT32 VGMSmplPos;
+	UINT8* DstData;
+	UINT32 DstDataLen;
+	UINT32 DataSizeA;
+	UINT32 DataSizeB;
+
+	UINT32 NxtCmdPos;
+	UINT8 NxtCmdCommand;
+	UINT16 NxtCmdReg;
+	UINT8 NxtCmdVal;
+
+	bool JustTimerCmds;
+	bool DoOKI6258;
+
+	// chip_cmp.c
+	UINT8 ChipCount;
+	struct all_chips* ChipData;
+	struct all_chips* ChDat;
+	bool VGM_Loops;
+};
+
+#endif	// __VGM_CMP_CTX_H__
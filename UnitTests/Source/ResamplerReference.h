@@ -0,0 +1,87 @@
+#pragma once
+
+// Helpers shared by the resampler tests and benchmarks, including the FIR
+// kernel as it was before the polyphase table
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "resampler/resample.hpp"
+#include "resampler/resample.inl"
+
+// The original resampler, which evaluates the sinc for every tap of every sample
+class CReferenceResampler
+{
+public:
+	CReferenceResampler(const jarh::sinc &Sinc, float Ratio, float Cutoff, const std::vector<float> &Input) :
+		m_Sinc(Sinc), m_Input(Input), m_iInputPos(0)
+	{
+		m_fInvRatio = 1.f / Ratio;
+		m_fStep = std::min(1.f, Ratio) * Cutoff;
+		m_fBuffer.resize(1 + (size_t)std::floor(2 * Sinc.range() / m_fStep));
+		const float Range = -Sinc.range() / m_fStep;
+		m_fSubIndex = Range - std::floor(Range);
+		const size_t Offset = (size_t)std::ceil((float)(m_fBuffer.size() / 2)) - 1;
+		Fill(Offset);
+	}
+
+	float Get() {
+		float Sum = 0.f;
+		float x = -m_Sinc.range() + m_fStep - m_fSubIndex * m_fStep;
+		for (float Sample : m_fBuffer) {
+			Sum += Sample * m_Sinc(x);
+			x += m_fStep;
+		}
+		m_fSubIndex += m_fInvRatio;
+		const size_t Inc = (size_t)m_fSubIndex;
+		m_fSubIndex -= Inc;
+		if (Inc < m_fBuffer.size())
+			std::copy(m_fBuffer.begin() + Inc, m_fBuffer.end(), m_fBuffer.begin());
+		Fill(m_fBuffer.size() - std::min(Inc, m_fBuffer.size()));
+		return Sum * m_fStep;
+	}
+
+private:
+	void Fill(size_t Pos) {
+		for (; Pos < m_fBuffer.size(); ++Pos)
+			m_fBuffer[Pos] = m_iInputPos < m_Input.size() ? m_Input[m_iInputPos++] : 0.f;
+	}
+
+private:
+	const jarh::sinc &m_Sinc;
+	const std::vector<float> &m_Input;
+	size_t m_iInputPos;
+	std::vector<float> m_fBuffer;
+	float m_fInvRatio, m_fStep, m_fSubIndex;
+};
+
+// The polyphase resampler reading from the same input
+class CVectorResampler : public jarh::resample<CVectorResampler>
+{
+	friend class jarh::resample<CVectorResampler>;
+public:
+	CVectorResampler(const jarh::sinc &Sinc, float Ratio, float Cutoff, const std::vector<float> &Input) :
+		jarh::resample<CVectorResampler>(Sinc), m_Input(Input), m_iInputPos(0)
+	{
+		init(Ratio, Cutoff);
+	}
+
+	float Get() {
+		return get();
+	}
+
+protected:
+	bool initstream() {
+		m_iInputPos = 0;
+		return true;
+	}
+	float *fill(float *begin, float *end) {
+		for (; begin != end; ++begin)
+			*begin = m_iInputPos < m_Input.size() ? m_Input[m_iInputPos++] : 0.f;
+		return end;
+	}
+
+private:
+	const std::vector<float> &m_Input;
+	size_t m_iInputPos;
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+// Helpers shared by the SN76489 tests and benchmarks, including the channel
+// implementations as they were before their output was batched
+
+#include <memory>
+#include <vector>
+#include "APU/Mixer.h"
+#include "APU/SN76489_new.h"
+
+const uint32 CLOCK_RATE = 3579545;
+const uint32 SAMPLE_RATE = 44100;
+const uint32 FRAME_CYCLES = CLOCK_RATE / 60;
+
+// The square wave loop as it was before batching, one mixer call per half period
+class CReferenceSquare
+{
+public:
+	CReferenceSquare(CMixer *pMixer, int ID) : m_pMixer(pMixer), m_iChanId(ID) { }
+
+	void Reset() {
+	}
+
+	void Process(uint32 Time) {
+		uint16 Period = m_iPeriod ? m_iPeriod : 1;
+		while (Time >= m_iSquareCounter) {
+			Time -= m_iSquareCounter;
+			m_iTime += m_iSquareCounter;
+			m_iSquareCounter = Period << 4;
+			m_bSqaureActive = Period > CSNSquare::CUTOFF_PERIOD ? !m_bSqaureActive : 0;
+			int32 Vol = m_bSqaureActive ? CSN76489::VOLUME_TABLE[m_iAttenuation] : 0;
+			m_pMixer->AddValue(m_iChanId, SNDCHIP_NONE, m_bLeft ? Vol : 0, m_bRight ? Vol : 0, m_iTime);
+		}
+		m_iSquareCounter -= Time;
+		m_iTime += Time;
+	}
+
+	void EndFrame() {
+		m_iTime = 0;
+	}
+
+	void SetPeriodLo(uint8 Value) {
+		m_iPeriod = (m_iPeriod & 0x3F0) | (Value & 0x0F);
+	}
+
+	void SetPeriodHi(uint8 Value) {
+		m_iPeriod = (m_iPeriod & 0x0F) | ((Value & 0x3F) << 4);
+	}
+
+	void SetAttenuation(uint8 Value) {
+		m_iAttenuation = Value & 0xF;
+	}
+
+	void SetStereo(bool Left, bool Right) {
+		m_bLeft = Left;
+		m_bRight = Right;
+	}
+
+private:
+	CMixer *m_pMixer;
+	int m_iChanId;
+	uint32 m_iTime = 0;
+	uint32 m_iSquareCounter = 0;
+	uint16 m_iPeriod = 0;
+	uint8 m_iAttenuation = 0xF;
+	bool m_bSqaureActive = true;
+	bool m_bLeft = true;
+	bool m_bRight = true;
+};
+
+inline void SetupMixer(CMixer &Mixer)
+{
+	Mixer.AllocateBuffer(SAMPLE_RATE / 10, SAMPLE_RATE, 2);
+	Mixer.SetClockRate(CLOCK_RATE);
+	Mixer.SetChipLevel(CHIP_LEVEL_SN7Sep, .6f);
+	Mixer.UpdateSettings(16, 12000, 24, 1.f);
+	Mixer.ClearBuffer();
+}
+
+struct render_result_t
+{
+	std::vector<float> Samples;
+	std::vector<int32> Levels;
+};
+
+// Reference noise generator as it was before the LFSR steps were batched
+class CReferenceNoise
+{
+public:
+	CReferenceNoise(CMixer *pMixer) : m_pMixer(pMixer) { }
+
+	void Reset() {
+	}
+
+	void Process(uint32 Time) {
+		uint16 Period = m_iCH3Period ? m_iCH3Period : 1;
+		while (Time >= m_iSquareCounter) {
+			Time -= m_iSquareCounter;
+			m_iTime += m_iSquareCounter;
+			m_iSquareCounter = Period << 4;
+			if ((m_bSqaureActive = !m_bSqaureActive)) {
+				int Feedback = m_iLFSRState;
+				switch (m_iNoiseFeedback) {
+				case SN_NOI_FB_SHORT: Feedback &= 1; break;
+				case SN_NOI_FB_LONG:  Feedback = ((Feedback & 0x0009) && ((Feedback & 0x0009) ^ 0x0009)); break;
+				}
+				m_iLFSRState = (m_iLFSRState >> 1) | (Feedback << (16 - 1));
+				int32 Vol = (m_iLFSRState & 1) ? CSN76489::VOLUME_TABLE[m_iAttenuation] : 0;
+				m_pMixer->AddValue(CHANID_NOISE, SNDCHIP_NONE, m_bLeft ? Vol : 0, m_bRight ? Vol : 0, m_iTime);
+			}
+		}
+		m_iSquareCounter -= Time;
+		m_iTime += Time;
+	}
+
+	void EndFrame() {
+		m_iTime = 0;
+	}
+
+	void SetControlMode(uint8 Value) {
+		m_iNoiseFeedback = static_cast<SN_noise_fb_t>(Value & 0x04);
+		m_iLFSRState = 0x8000;
+	}
+
+	void CachePeriod(uint16 Period) {
+		m_iCH3Period = Period;
+	}
+
+	void SetAttenuation(uint8 Value) {
+		m_iAttenuation = Value & 0xF;
+	}
+
+	void SetStereo(bool Left, bool Right) {
+		m_bLeft = Left;
+		m_bRight = Right;
+	}
+
+private:
+	CMixer *m_pMixer;
+	uint32 m_iTime = 0;
+	uint32 m_iSquareCounter = 0;
+	uint16 m_iCH3Period = 0;
+	uint16 m_iLFSRState = 0x8000;
+	SN_noise_fb_t m_iNoiseFeedback = SN_NOI_FB_LONG;
+	uint8 m_iAttenuation = 0xF;
+	bool m_bSqaureActive = true;
+	bool m_bLeft = true;
+	bool m_bRight = true;
+};
+
+// Renders channels created by Make, Update writes to them and runs them for a frame
+template <typename T, typename M, typename U>
+render_result_t Render(int Frames, int Count, M Make, U Update)
+{
+	CMixer Mixer;
+	SetupMixer(Mixer);
+	std::vector<std::unique_ptr<T>> Chans;
+	for (int i = 0; i < Count; ++i) {
+		Chans.push_back(Make(&Mixer, i));
+		Chans.back()->Reset();
+	}
+
+	render_result_t Result;
+	std::vector<float> Buffer(SAMPLE_RATE * 2);
+	for (int f = 0; f < Frames; ++f) {
+		for (int i = 0; i < Count; ++i) {
+			Update(*Chans[i], f, i);
+			Chans[i]->EndFrame();
+		}
+		int Avail = Mixer.FinishBuffer(FRAME_CYCLES);
+		int Read = Mixer.ReadBuffer(Avail, Buffer.data(), true);
+		Result.Samples.insert(Result.Samples.end(), Buffer.begin(), Buffer.begin() + Read);
+		for (int i = CHANID_SQUARE1; i <= CHANID_NOISE; ++i)
+			Result.Levels.push_back(Mixer.GetChanOutput(i));
+	}
+	return Result;
+}
+
+// Plays high pitched squares with changing periods, volumes and stereo flags
+template <typename T>
+render_result_t RenderSquares(int Frames)
+{
+	return Render<T>(Frames, 3, [] (CMixer *pMixer, int i) {
+		return std::make_unique<T>(pMixer, CHANID_SQUARE1 + i);
+	}, [] (T &Chan, int f, int i) {
+		if (!(f % (5 + i))) {
+			uint16 Period = f % 97 == 0 ? 3 : 7 + (f + 11 * i) % 24;		// includes the cutoff period
+			Chan.SetPeriodLo(Period & 0x0F);
+			Chan.SetPeriodHi(Period >> 4);
+			Chan.SetAttenuation((f + i) % 6);
+			Chan.SetStereo(f % 3 != 2, f % 4 != 3);
+		}
+		Chan.Process(FRAME_CYCLES / 3);
+		Chan.SetAttenuation((f + i) % 5);
+		Chan.Process(FRAME_CYCLES - FRAME_CYCLES / 3);
+	});
+}
+
+// Plays noise clocked by the third square at small periods
+template <typename T>
+render_result_t RenderNoise(int Frames)
+{
+	return Render<T>(Frames, 1, [] (CMixer *pMixer, int) {
+		return std::make_unique<T>(pMixer);
+	}, [] (T &Chan, int f, int) {
+		if (!(f % 7)) {
+			Chan.SetControlMode(SN_NOI_DIV_CH3 | ((f / 7) % 2 ? SN_NOI_FB_LONG : SN_NOI_FB_SHORT));
+			Chan.CachePeriod(1 + (f / 7) % 13);
+			Chan.SetStereo(f % 3 != 2, f % 4 != 3);
+		}
+		Chan.SetAttenuation(f % 5);
+		Chan.Process(FRAME_CYCLES / 2);
+		Chan.SetAttenuation(f % 3);
+		Chan.Process(FRAME_CYCLES - FRAME_CYCLES / 2);
+	});
+}
@@ -0,0 +1,136 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "APU/APU.h"
+
+TEST_SUITE("APU");
+
+namespace {
+
+// Keeps the output of every audio frame
+class CFrameCollector : public IAudioCallback
+{
+public:
+	void FlushBuffer(float *Buffer, uint32 Size) override {
+		Frames.emplace_back(Buffer, Buffer + Size);
+	}
+
+	std::vector<std::vector<float>> Frames;
+};
+
+float Peak(const std::vector<float> &Samples)
+{
+	float Max = 0.f;
+	for (float x : Samples)
+		Max = std::max(Max, std::abs(x));
+	return Max;
+}
+
+void SetupAPU(CAPU &APU)
+{
+	APU.SetupSound(44100, 2, MACHINE_NTSC);
+	APU.SetupMixer(0, 12000, 24, 100);		// no bass filter, an offset would stay in the output
+	APU.Reset();
+}
+
+const uint32 FRAME_CYCLES = CAPU::BASE_FREQ_NTSC / CAPU::FRAME_RATE_NTSC;
+
+struct timed_write_t
+{
+	uint32 Time;		// cycles after the previous write
+	uint16 Address;
+	uint8 Value;
+};
+
+// Tones, volume changes and noise at irregular times over a few frames
+std::vector<timed_write_t> MakeWrites()
+{
+	std::vector<timed_write_t> Writes;
+	unsigned Seed = 1;
+	auto Next = [&Seed] (unsigned Range) {
+		Seed = Seed * 1103515245 + 12345;
+		return (Seed >> 16) % Range;
+	};
+	for (int i = 0; i < 600; ++i) {
+		uint16 Address = Next(8);
+		uint8 Value = Address % 2 || Address == 6 ? Next(0x10) : 0x04 + Next(0x40);
+		Writes.push_back({Next(600), Address, Value});
+	}
+	return Writes;
+}
+
+// Renders the writes, Shift moves every write by a number of cycles
+std::vector<std::vector<float>> RenderWrites(const std::vector<timed_write_t> &Writes, bool Immediate, uint32 Shift = 0)
+{
+	CFrameCollector Output;
+	CAPU APU {&Output};
+	SetupAPU(APU);
+
+	APU.AddTime(Shift);
+	uint32 Total = Shift;
+	for (const auto &x : Writes) {
+		APU.AddTime(x.Time);
+		Total += x.Time;
+		if (Immediate)		// run up to the write first, like the APU used to
+			APU.Process();
+		APU.Write(x.Address, x.Value);
+	}
+	APU.AddTime(FRAME_CYCLES * 6 - Total);
+	APU.Process();
+
+	return Output.Frames;
+}
+
+
+} // namespace
+
+SCENARIO("SN76489 instances") {
+	GIVEN("An APU with two chips, the second one playing a square") {
+		CFrameCollector Output;
+		CAPU APU {&Output};
+		SetupAPU(APU);
+		APU.SetChipCount(2);
+		REQUIRE(APU.GetChipCount() == 2);
+
+		APU.Write(1, 0, 0x00);		// period 0x100, 4096 cycles per half period
+		APU.Write(1, (uint16)-1, 0x10);
+		APU.Write(1, 1, 0x00);		// full volume
+
+		WHEN("The second chip is removed while the square is high") {
+			APU.AddTime(6000);
+			APU.Process();
+			APU.SetChipCount(1);
+			APU.AddTime(FRAME_CYCLES * 3 - 6000);
+			APU.Process();
+
+			THEN("The output returns to silence") {
+				REQUIRE(APU.GetChipCount() == 1);
+				REQUIRE(Output.Frames.size() == 3);
+				REQUIRE(Peak(Output.Frames[0]) > .01f);
+				REQUIRE(Peak(Output.Frames[2]) < 1e-4f);
+			}
+		}
+	}
+}
+
+SCENARIO("Queued register writes") {
+	GIVEN("Register writes at irregular cycles spanning several frames") {
+		const auto Writes = MakeWrites();
+
+		WHEN("The writes are queued and the APU is run once") {
+			auto Queued = RenderWrites(Writes, false);
+
+			THEN("The output matches running the APU up to every write") {
+				auto Immediate = RenderWrites(Writes, true);
+				REQUIRE(Queued.size() == 6);
+				REQUIRE(Queued == Immediate);
+				REQUIRE(Peak(Queued[1]) > .01f);
+			}
+			THEN("The output changes if the writes land one cycle later") {
+				REQUIRE(Queued != RenderWrites(Writes, false, 1));
+			}
+		}
+	}
+}
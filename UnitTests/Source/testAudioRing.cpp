@@ -0,0 +1,83 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "AudioRing.h"
+
+TEST_SUITE("Audio ring");
+
+SCENARIO("Audio ring buffer") {
+	GIVEN("A ring of 1000 bytes") {
+		CAudioRing Ring;
+		REQUIRE(Ring.Allocate(1000));
+
+		THEN("The capacity is rounded up to a power of two") {
+			REQUIRE(Ring.GetCapacity() == 1024u);
+			REQUIRE(Ring.GetFill() == 0u);
+			REQUIRE(Ring.GetFree() == 1024u);
+		}
+
+		WHEN("More is written than fits, across the end of the buffer") {
+			std::vector<char> In(1500), Out(2000);
+			for (size_t i = 0; i < In.size(); ++i)
+				In[i] = (char)(i * 7);
+			REQUIRE(Ring.Write(In.data(), 700) == 700u);
+			REQUIRE(Ring.Read(Out.data(), 600) == 600u);
+			REQUIRE(Ring.Write(In.data() + 700, 800) == 800u);
+			REQUIRE(Ring.GetFill() == 900u);
+			REQUIRE(Ring.Write(In.data() + 1500 - 200, 200) == 124u);
+
+			THEN("Reads return the written bytes in order until the ring is empty") {
+				REQUIRE(Ring.Read(Out.data() + 600, 2000) == 1024u);
+				REQUIRE(std::equal(In.begin(), In.begin() + 1500, Out.begin()));
+				REQUIRE(Ring.Read(Out.data(), 1) == 0u);
+			}
+		}
+	}
+
+	GIVEN("A producer and a consumer thread") {
+		const unsigned int TOTAL = 1 << 20;
+		const unsigned int BLOCK = 1000;
+		CAudioRing Ring;
+		REQUIRE(Ring.Allocate(4096));
+
+		// Both sides stop after TOTAL bytes and yield while the ring is empty or full
+		unsigned int Errors = 0;
+		std::thread Consumer {[&] {
+			std::vector<char> Buf(BLOCK);
+			unsigned int Pos = 0;
+			while (Pos < TOTAL) {
+				unsigned int Read = Ring.Read(Buf.data(), std::min(BLOCK, TOTAL - Pos));
+				if (!Read)
+					std::this_thread::yield();
+				for (unsigned int i = 0; i < Read; ++i)
+					if (Buf[i] != (char)((Pos + i) * 13))
+						++Errors;
+				Pos += Read;
+			}
+		}};
+
+		std::vector<char> Buf(BLOCK);
+		unsigned int Pos = 0;
+		while (Pos < TOTAL) {
+			unsigned int Size = std::min(BLOCK, TOTAL - Pos);
+			for (unsigned int i = 0; i < Size; ++i)
+				Buf[i] = (char)((Pos + i) * 13);
+			unsigned int Written = 0;
+			while (Written < Size) {
+				unsigned int Count = Ring.Write(Buf.data() + Written, Size - Written);
+				if (!Count)
+					std::this_thread::yield();
+				Written += Count;
+			}
+			Pos += Size;
+		}
+		Consumer.join();
+
+		THEN("Every byte arrives in order") {
+			REQUIRE(Errors == 0u);
+			REQUIRE(Ring.GetFill() == 0u);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "NullSink.h"
+#include "FileSink.h"
+#include "AudioRing.h"
+#include "AudioFeeder.h"
+
+TEST_SUITE("Audio sinks");
+
+namespace {
+
+// Only moves when a channel waits for it or when it is advanced
+class CManualClock : public CAudioClock
+{
+public:
+	std::chrono::nanoseconds Now() const override {
+		return m_Time;
+	}
+	void WaitUntil(std::unique_lock<std::mutex> &Lock, std::condition_variable &Wake, std::chrono::nanoseconds Time) override {
+		m_Time = std::max(m_Time, Time);
+	}
+	void Advance(std::chrono::nanoseconds Time) {
+		m_Time += Time;
+	}
+
+private:
+	std::chrono::nanoseconds m_Time {0};
+};
+
+} // namespace
+
+SCENARIO("Null audio sink") {
+	GIVEN("A channel of 10 ms blocks on a manual clock") {
+		CManualClock Clock;
+		CNullSink Sink {&Clock};
+		REQUIRE(Sink.SetupDevice(0));
+		CAudioChannel *pChannel = Sink.OpenChannel(48000, 16, 2, 40, 4);
+		REQUIRE(pChannel != nullptr);
+		REQUIRE(pChannel->GetBlockSize() == 48000 / 100 * 4);
+
+		WHEN("Every block is written as soon as it is requested") {
+			std::vector<char> Block(pChannel->GetBlockSize());
+			for (int i = 0; i < 20; ++i) {
+				REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_IN_SYNC);
+				REQUIRE(pChannel->WriteBuffer(Block.data(), Block.size()));
+			}
+
+			THEN("Blocks are consumed in real time") {
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(200));
+			}
+		}
+
+		WHEN("The timeout is shorter than a block") {
+			THEN("The wait times out") {
+				REQUIRE(pChannel->WaitForSyncEvent(5) == BUFFER_TIMEOUT);
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(5));
+				REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_IN_SYNC);
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(10));
+			}
+		}
+
+		WHEN("The writer stalls for more than the buffer length") {
+			REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_IN_SYNC);
+			Clock.Advance(std::chrono::milliseconds(60));
+
+			THEN("The next event reports the lost sync") {
+				REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_OUT_OF_SYNC);
+				REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_IN_SYNC);
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(80));
+			}
+		}
+
+		WHEN("The wait is interrupted from another thread") {
+			REQUIRE(pChannel->WaitForSyncEvent(100) == BUFFER_IN_SYNC);
+			std::thread Thread([pChannel] { pChannel->Interrupt(); });
+			Thread.join();
+
+			THEN("The waiting thread returns") {
+				REQUIRE(pChannel->WaitForSyncEvent(1000) == BUFFER_CUSTOM_EVENT);
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(10));
+			}
+		}
+
+		Sink.CloseChannel(pChannel);
+	}
+}
+
+SCENARIO("Audio device loop") {
+	GIVEN("A feeder passing an audio ring to a null channel") {
+		CManualClock Clock;
+		CNullSink Sink {&Clock};
+		REQUIRE(Sink.SetupDevice(0));
+		CAudioChannel *pChannel = Sink.OpenChannel(48000, 16, 2, 40, 4);
+		REQUIRE(pChannel != nullptr);
+		std::vector<char> Block(pChannel->GetBlockSize());
+
+		CAudioRing Ring;
+		REQUIRE(Ring.Allocate(Block.size() * 4));
+		CAudioFeeder Feeder;
+		Feeder.SetOutput(&Ring, pChannel);
+		bool Underrun;
+
+		WHEN("The ring holds two blocks") {
+			REQUIRE(Ring.Write(Block.data(), Block.size()) == Block.size());
+			REQUIRE(Ring.Write(Block.data(), Block.size()) == Block.size());
+
+			THEN("Both are played without an underrun") {
+				REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+				REQUIRE_FALSE(Underrun);
+				REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+				REQUIRE_FALSE(Underrun);
+				REQUIRE(Ring.GetFill() == 0u);
+				REQUIRE(Clock.Now() == std::chrono::milliseconds(20));
+
+				AND_THEN("Running empty counts one underrun until a block arrives") {
+					REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+					REQUIRE(Underrun);
+					REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+					REQUIRE_FALSE(Underrun);
+					REQUIRE(Ring.Write(Block.data(), Block.size()) == Block.size());
+					REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+					REQUIRE_FALSE(Underrun);
+					REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+					REQUIRE(Underrun);
+				}
+			}
+		}
+
+		WHEN("The device runs a whole buffer ahead") {
+			REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_IN_SYNC);
+			Clock.Advance(std::chrono::milliseconds(60));
+
+			THEN("The lost sync is an underrun") {
+				REQUIRE(Feeder.Feed(100, Underrun) == BUFFER_OUT_OF_SYNC);
+				REQUIRE(Underrun);
+			}
+		}
+
+		WHEN("The device does not respond in time") {
+			THEN("The timeout is reported without an underrun") {
+				REQUIRE(Feeder.Feed(5, Underrun) == BUFFER_TIMEOUT);
+				REQUIRE_FALSE(Underrun);
+			}
+		}
+
+		Feeder.SetOutput(NULL, NULL);
+		Sink.CloseChannel(pChannel);
+	}
+}
+
+SCENARIO("File audio sink") {
+	GIVEN("A sink writing to a temporary file") {
+		const char Path[] = "testAudioSink.raw";
+		std::vector<char> Block(441 * 4);
+		for (size_t i = 0; i < Block.size(); ++i)
+			Block[i] = (char)i;
+
+		{
+			CFileSink Sink(Path);
+			REQUIRE(Sink.SetupDevice(0));
+			CAudioChannel *pChannel = Sink.OpenChannel(44100, 16, 2, 20, 2);
+			REQUIRE(pChannel != nullptr);
+			REQUIRE(pChannel->GetBlockSize() == (int)Block.size());
+			for (int i = 0; i < 3; ++i) {
+				REQUIRE(pChannel->WaitForSyncEvent(0) == BUFFER_IN_SYNC);
+				REQUIRE(pChannel->WriteBuffer(Block.data(), Block.size()));
+			}
+			Sink.CloseChannel(pChannel);
+			Sink.CloseDevice();
+		}
+
+		THEN("The file holds the written blocks") {
+			FILE *f = fopen(Path, "rb");
+			REQUIRE(f != nullptr);
+			std::vector<char> Data(Block.size() * 4);
+			size_t Size = fread(Data.data(), 1, Data.size(), f);
+			fclose(f);
+			remove(Path);
+			REQUIRE(Size == Block.size() * 3);
+			REQUIRE(std::equal(Block.begin(), Block.end(), Data.begin() + Block.size() * 2));
+		}
+	}
+}
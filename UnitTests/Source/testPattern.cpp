@@ -1,96 +1,255 @@
-#include "doctest.h"
-
-#include "Document/PatternData_new.h"
-#include "Document/TrackData.h"
-
-using namespace FTExt;
-
-TEST_SUITE("Pattern data");
-
-SCENARIO("Pattern data test") {
-	GIVEN("A default-constructed pattern") {
-		CPatternData p;
-		auto &&cp = std::as_const(p);
-
-		
-	}
-}
-
-SCENARIO("Track data test") {
-	GIVEN("A track object") {
-		CTrackData t;
-		auto &&ct = std::as_const(t);
-
-		AND_GIVEN("It is default-constructed") {
-			WHEN("At the beginning") {
-				THEN("All pattern indices should be initially 00") {
-					bool id = true;
-					for (size_t i = 0; i < MAX_FRAMES; ++i)
-						if (t.GetPatternIndex(i)) {
-							id = false; break;
-						}
-					REQUIRE(id);
-					AND_THEN("Track should contain 1 effect column") {
-						REQUIRE(t.GetEffectColumnCount() == 1);
-					}
-				}
-			}
-
-			AND_WHEN("Pattern is accessed as const") {
-				auto ptr = ct.GetPattern(0);
-				THEN("No patterns should be created") {
-					REQUIRE(ptr == nullptr);
-					REQUIRE(ct.GetPattern(MAX_FRAMES) == nullptr);
-				}
-			}
-
-			AND_WHEN("Pattern is accessed") {
-				auto ptr = t.GetPattern(0);
-				THEN("Pointer to created pattern should be returned") {
-					REQUIRE(ptr != nullptr);
-					AND_THEN("Patterns should be unique") {
-						REQUIRE(ptr != t.GetPattern(1));
-						REQUIRE(ptr != t.GetPattern(MAX_FRAMES - 1));
-					}
-				}
-				AND_WHEN("The same pattern index is used to access it again") {
-					auto p2 = t.GetPattern(0);
-					THEN("The patterns should be identical") {
-						REQUIRE(ptr == p2);
-					}
-				}
-			}
-
-			AND_WHEN("Out-of-bound pattern indices are accessed") {
-				THEN("nullptr should be returned") {
-					REQUIRE(t.GetPattern(MAX_FRAMES) == nullptr);
-					REQUIRE(t.GetPattern((size_t)-1) == nullptr);
-					REQUIRE(ct.GetPattern(MAX_FRAMES) == nullptr);
-					REQUIRE(ct.GetPattern((size_t)-1) == nullptr);
-				}
-			}
-
-			AND_WHEN("Effect column count is changed") {
-				THEN("Track should be able to hold 1 - 4 columns") {
-					t.SetEffectColumnCount(2);
-					REQUIRE(t.GetEffectColumnCount() == 2);
-					t.SetEffectColumnCount(4);
-					REQUIRE(t.GetEffectColumnCount() == 4);
-					t.SetEffectColumnCount(1);
-					REQUIRE(t.GetEffectColumnCount() == 1);
-					t.SetEffectColumnCount(3);
-					REQUIRE(t.GetEffectColumnCount() == 3);
-					const int Count = t.GetEffectColumnCount();
-					AND_THEN("Column count should not change otherwise") {
-						try { t.SetEffectColumnCount(5); } catch (...) { }
-						REQUIRE(t.GetEffectColumnCount() == Count);
-						try { t.SetEffectColumnCount(0); } catch (...) { }
-						REQUIRE(t.GetEffectColumnCount() == Count);
-					}
-				}
-			}
-		}
-	}
-}
-
-TEST_SUITE_END;
+#include "doctest.h"
+
+#include "Document/PatternData_new.h"
+#include "Document/TrackData.h"
+
+using namespace FTExt;
+
+TEST_SUITE("Pattern data");
+
+SCENARIO("Pattern data test") {
+	GIVEN("A default-constructed pattern") {
+		CPatternData p;
+		auto &&cp = std::as_const(p);
+
+		WHEN("At the beginning") {
+			THEN("The pattern should be empty") {
+				REQUIRE(cp.GetSize() == CPatternData::MAX_SIZE);
+				REQUIRE(cp.IsEmpty());
+				REQUIRE(cp.GetHash() == CPatternData::GetBlankHash(CPatternData::MAX_SIZE));
+				REQUIRE(CPatternData(7).GetHash() == CPatternData::GetBlankHash(7));
+			}
+		}
+
+		AND_WHEN("The pattern is resized") {
+			CPatternNote Note;
+			Note.Note = 1;
+			Note.Effect[1].Index = 2;
+			p.SetNote(5, Note);
+			p.SetSize(4);
+			THEN("Rows beyond the size should be kept but not counted") {
+				REQUIRE(cp.IsEmpty());
+				REQUIRE(cp.GetNote(5) == Note);
+				p.SetSize(8);
+				REQUIRE(!cp.IsEmpty());
+			}
+			AND_WHEN("The pattern is shrunk") {
+				p.ShrinkToSize();
+				THEN("Rows beyond the size should be dropped") {
+					p.SetSize(8);
+					REQUIRE(cp.GetNote(5) == CPatternNote::BLANK);
+					REQUIRE(cp.IsEmpty());
+				}
+			}
+			AND_WHEN("The pattern is shrunk to fit") {
+				CPatternData q = p;
+				p.ShrinkToFit();
+				THEN("Only blank rows at the end should be dropped") {
+					REQUIRE(!cp.SharesDataWith(q));
+					REQUIRE(cp.GetNote(5) == Note);
+					REQUIRE(cp.GetSize() == 4);
+					REQUIRE(cp.GetHash() == q.GetHash());
+					REQUIRE(cp.FindNextNote(0) == 5);
+					p.SetSize(8);
+					REQUIRE(!cp.IsEmpty());
+				}
+			}
+		}
+	}
+
+	GIVEN("A short pattern") {
+		CPatternData p(4);
+		CPatternNote Note;
+		Note.Vol = 3;
+
+		WHEN("A row beyond the storage is written") {
+			p.SetNote(10, Note);
+			THEN("The row should be readable") {
+				REQUIRE(p.GetNote(10) == Note);
+				REQUIRE(p.GetNote(11) == CPatternNote::BLANK);
+				REQUIRE(p.GetSize() == 4);
+			}
+		}
+
+		AND_WHEN("Patterns are compared") {
+			CPatternData q(4);
+			THEN("Only rows within the size should matter") {
+				REQUIRE(p == q);
+				q.SetNote(10, Note);
+				REQUIRE(p == q);
+				q.SetNote(3, Note);
+				REQUIRE(p != q);
+				REQUIRE(p != CPatternData(5));
+			}
+		}
+
+		AND_WHEN("The pattern is copied") {
+			p.SetNote(1, Note);
+			CPatternData q = p;
+			THEN("Both patterns should share their rows until one is modified") {
+				REQUIRE(q.SharesDataWith(p));
+				REQUIRE(q.GetHash() == p.GetHash());
+				q.SetNote(1, Note);
+				REQUIRE(q.SharesDataWith(p));
+				q.SetNote(2, Note);
+				REQUIRE(!q.SharesDataWith(p));
+				REQUIRE(p.GetNote(2) == CPatternNote::BLANK);
+				REQUIRE(q.GetHash() != p.GetHash());
+				REQUIRE(p != q);
+			}
+		}
+
+		AND_WHEN("An identical pattern is built separately") {
+			CPatternData q(4);
+			p.SetNote(2, Note);
+			q.SetNote(2, Note);
+			THEN("It should be able to share the rows") {
+				REQUIRE(!q.SharesDataWith(p));
+				REQUIRE(q.GetHash() == p.GetHash());
+				REQUIRE(q.ShareData(p));
+				REQUIRE(q.SharesDataWith(p));
+				q.SetNote(9, Note);
+				REQUIRE(p.GetNote(9) == CPatternNote::BLANK);
+				REQUIRE(!p.ShareData(q));
+			}
+		}
+
+		AND_WHEN("Some rows are written") {
+			p.SetNote(2, Note);
+			p.SetNote(0, Note);
+			p.SetNote(7, Note);
+			THEN("Only the rows that are not blank should be visited") {
+				REQUIRE(p.FindNextNote(0) == 0);
+				REQUIRE(p.FindNextNote(1) == 2);
+				REQUIRE(p.FindNextNote(3) == 7);
+				REQUIRE(p.FindNextNote(8) == CPatternData::MAX_SIZE);
+				REQUIRE(p.GetNoteCount() == 2);
+				REQUIRE(!p.IsRowBlank(2));
+				REQUIRE(p.IsRowBlank(3));
+			}
+			AND_WHEN("A row is cleared") {
+				p.SetNote(2, CPatternNote::BLANK);
+				THEN("It should no longer be visited") {
+					REQUIRE(p.FindNextNote(1) == 7);
+					REQUIRE(p.IsRowBlank(2));
+					REQUIRE(p.GetNoteCount() == 1);
+				}
+			}
+			AND_WHEN("The pattern is shrunk") {
+				p.ShrinkToSize();
+				THEN("Rows beyond the size should no longer be visited") {
+					REQUIRE(p.FindNextNote(1) == 2);
+					REQUIRE(p.FindNextNote(3) == CPatternData::MAX_SIZE);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Track data test") {
+	GIVEN("A track object") {
+		CTrackData t;
+		auto &&ct = std::as_const(t);
+
+		AND_GIVEN("It is default-constructed") {
+			WHEN("At the beginning") {
+				THEN("All pattern indices should be initially 00") {
+					bool id = true;
+					for (size_t i = 0; i < MAX_FRAMES; ++i)
+						if (t.GetPatternIndex(i)) {
+							id = false; break;
+						}
+					REQUIRE(id);
+					AND_THEN("Track should contain 1 effect column") {
+						REQUIRE(t.GetEffectColumnCount() == 1);
+					}
+				}
+			}
+
+			AND_WHEN("Pattern is accessed as const") {
+				auto ptr = ct.GetPattern(0);
+				THEN("No patterns should be created") {
+					REQUIRE(ptr == nullptr);
+					REQUIRE(ct.GetPattern(MAX_FRAMES) == nullptr);
+				}
+			}
+
+			AND_WHEN("Pattern is accessed") {
+				auto ptr = t.GetPattern(0);
+				THEN("Pointer to created pattern should be returned") {
+					REQUIRE(ptr != nullptr);
+					AND_THEN("Patterns should be unique") {
+						REQUIRE(ptr != t.GetPattern(1));
+						REQUIRE(ptr != t.GetPattern(MAX_FRAMES - 1));
+					}
+				}
+				AND_WHEN("The same pattern index is used to access it again") {
+					auto p2 = t.GetPattern(0);
+					THEN("The patterns should be identical") {
+						REQUIRE(ptr == p2);
+					}
+				}
+			}
+
+			AND_WHEN("Out-of-bound pattern indices are accessed") {
+				THEN("nullptr should be returned") {
+					REQUIRE(t.GetPattern(MAX_FRAMES) == nullptr);
+					REQUIRE(t.GetPattern((size_t)-1) == nullptr);
+					REQUIRE(ct.GetPattern(MAX_FRAMES) == nullptr);
+					REQUIRE(ct.GetPattern((size_t)-1) == nullptr);
+				}
+			}
+
+			AND_WHEN("Whole patterns are copied and swapped") {
+				CPatternNote Note;
+				Note.Note = 2;
+				t.NewPattern(1, 16)->SetNote(0, Note);
+				t.CopyPattern(2, 1);
+				THEN("The copy should be independent") {
+					REQUIRE(ct.GetPattern(2) != ct.GetPattern(1));
+					REQUIRE(*ct.GetPattern(2) == *ct.GetPattern(1));
+					t.GetPattern(1)->Clear();
+					REQUIRE(ct.GetPattern(2)->GetNote(0) == Note);
+				}
+				AND_THEN("Copying an absent pattern should clear the target") {
+					t.CopyPattern(2, 3);
+					REQUIRE(ct.GetPattern(2) == nullptr);
+				}
+				AND_THEN("Swapping should exchange the pattern objects") {
+					const CPatternData *pOld = ct.GetPattern(1);
+					t.SwapPatterns(1, 3);
+					REQUIRE(ct.GetPattern(1) == nullptr);
+					REQUIRE(ct.GetPattern(3) == pOld);
+				}
+				AND_THEN("Released patterns should be owned by the caller") {
+					CPatternData *pOld = t.ReleasePattern(1);
+					REQUIRE(ct.GetPattern(1) == nullptr);
+					t.ReplacePattern(4, pOld);
+					REQUIRE(ct.GetPattern(4) == pOld);
+				}
+			}
+
+			AND_WHEN("Effect column count is changed") {
+				THEN("Track should be able to hold 1 - 4 columns") {
+					t.SetEffectColumnCount(2);
+					REQUIRE(t.GetEffectColumnCount() == 2);
+					t.SetEffectColumnCount(4);
+					REQUIRE(t.GetEffectColumnCount() == 4);
+					t.SetEffectColumnCount(1);
+					REQUIRE(t.GetEffectColumnCount() == 1);
+					t.SetEffectColumnCount(3);
+					REQUIRE(t.GetEffectColumnCount() == 3);
+					const int Count = t.GetEffectColumnCount();
+					AND_THEN("Column count should not change otherwise") {
+						try { t.SetEffectColumnCount(5); } catch (...) { }
+						REQUIRE(t.GetEffectColumnCount() == Count);
+						try { t.SetEffectColumnCount(0); } catch (...) { }
+						REQUIRE(t.GetEffectColumnCount() == Count);
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST_SUITE_END;
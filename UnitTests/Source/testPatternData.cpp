@@ -0,0 +1,76 @@
+#include "doctest.h"
+
+#include "PatternData.h"
+
+TEST_SUITE("Song pattern data");
+
+SCENARIO("Song pattern access") {
+	GIVEN("A song without patterns") {
+		CPatternData Song(64, 6, 150);
+		const CPatternData &cSong = Song;
+
+		WHEN("Patterns are only read") {
+			bool Blank = true;
+			for (unsigned int i = 0; i < MAX_CHANNELS; ++i)
+				for (unsigned int j = 0; j < MAX_PATTERN; ++j) {
+					stChanNote Note = cSong.GetNote(i, j, 10);
+					if (Note.Note != stChanNote::BLANK.Note || Note.Vol != stChanNote::BLANK.Vol ||
+						Note.Instrument != stChanNote::BLANK.Instrument || Note.EffNumber[0] != stChanNote::BLANK.EffNumber[0])
+						Blank = false;
+					cSong.GetPattern(i, j);
+					cSong.IsPatternAllocated(i, j);
+					cSong.IsPatternEmpty(i, j);
+					cSong.FindNextNote(i, j, 0);
+				}
+
+			THEN("They read as blank and stay unallocated") {
+				REQUIRE(Blank);
+				bool Allocated = false;
+				for (unsigned int i = 0; i < MAX_CHANNELS; ++i)
+					for (unsigned int j = 0; j < MAX_PATTERN; ++j)
+						if (cSong.IsPatternAllocated(i, j) || cSong.GetPattern(i, j) != nullptr)
+							Allocated = true;
+				REQUIRE_FALSE(Allocated);
+			}
+		}
+
+		WHEN("A note is written") {
+			stChanNote Note = stChanNote::BLANK;
+			Note.Note = 1;
+			Note.Octave = 3;
+			Song.SetNote(2, 5, 10, Note);
+
+			THEN("Only its pattern is allocated") {
+				REQUIRE(cSong.IsPatternAllocated(2, 5));
+				REQUIRE(cSong.GetNote(2, 5, 10).Note == 1);
+				REQUIRE_FALSE(cSong.IsPatternAllocated(2, 4));
+				REQUIRE_FALSE(cSong.IsPatternAllocated(3, 5));
+			}
+			AND_THEN("Unallocated patterns hash like a cleared pattern") {
+				Song.SetNote(2, 5, 10, stChanNote::BLANK);
+				REQUIRE(cSong.GetPatternHash(2, 4) == cSong.GetPatternHash(2, 5));
+				REQUIRE_FALSE(cSong.IsPatternAllocated(2, 4));
+			}
+		}
+
+		WHEN("Notes are hidden beyond a shorter pattern length and patterns are compacted") {
+			stChanNote Note = stChanNote::BLANK;
+			Note.Note = 1;
+			Note.Octave = 3;
+			Song.SetNote(0, 1, 40, Note);
+			Song.SetNote(0, 2, 10, Note);
+			Song.SetNote(0, 2, 10, stChanNote::BLANK);
+			Song.SetPatternLength(32);
+			Song.CompactPatterns();
+
+			THEN("Patterns without notes are released and hidden notes are kept") {
+				REQUIRE(cSong.IsPatternEmpty(0, 1));
+				REQUIRE(cSong.IsPatternAllocated(0, 1));
+				REQUIRE_FALSE(cSong.IsPatternAllocated(0, 2));
+				Song.SetPatternLength(64);
+				REQUIRE(cSong.GetNote(0, 1, 40).Note == 1);
+				REQUIRE_FALSE(cSong.IsPatternEmpty(0, 1));
+			}
+		}
+	}
+}
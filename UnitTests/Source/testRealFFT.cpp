@@ -0,0 +1,58 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+#include "FFT/RealFFT.h"
+
+TEST_SUITE("Real FFT");
+
+SCENARIO("Real FFT") {
+	GIVEN("A 256 point transform and some noisy input") {
+		const unsigned int N = 256;
+		const double PI = 3.14159265358979323846;
+		CRealFFT<N> FFT;
+
+		std::vector<short> In(N);
+		unsigned int Seed = 12345;
+		for (unsigned int i = 0; i < N; ++i) {
+			Seed = Seed * 1103515245 + 12345;
+			In[i] = (short)(8000 * sin(2 * PI * 20.5 * i / N) + (int)((Seed >> 16) & 0x7FF) - 0x400);
+		}
+		FFT.Transform(In.data());
+
+		THEN("The magnitudes match a windowed DFT") {
+			double MaxError = 0.0;
+			for (unsigned int k = 0; k < N / 2; ++k) {
+				double Re = 0.0, Im = 0.0;
+				for (unsigned int i = 0; i < N; ++i) {
+					double x = In[i] * 0.5 * (1.0 - cos(2 * PI * i / (N - 1)));
+					Re += x * cos(2 * PI * k * i / N);
+					Im -= x * sin(2 * PI * k * i / N);
+				}
+				double Mag = sqrt(Re * Re + Im * Im) / sqrt((double)N);
+				MaxError = std::max(MaxError, fabs(Mag - FFT.GetIntensity(k)));
+			}
+			REQUIRE(MaxError < 0.05);
+		}
+
+		THEN("The sine is the strongest bin") {
+			unsigned int Peak = 0;
+			for (unsigned int k = 1; k < N / 2; ++k)
+				if (FFT.GetIntensity(k) > FFT.GetIntensity(Peak))
+					Peak = k;
+			REQUIRE((Peak == 20u || Peak == 21u));
+		}
+
+		WHEN("Transforming again") {
+			std::vector<float> Before(N / 2);
+			for (unsigned int k = 0; k < N / 2; ++k)
+				Before[k] = FFT.GetIntensity(k);
+			FFT.Transform(In.data());
+
+			THEN("The result does not change") {
+				for (unsigned int k = 0; k < N / 2; ++k)
+					REQUIRE(FFT.GetIntensity(k) == Before[k]);
+			}
+		}
+	}
+}
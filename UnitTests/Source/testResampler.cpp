@@ -0,0 +1,100 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "APU/OutputResampler.h"
+#include "ResamplerReference.h"
+
+TEST_SUITE("Resampler");
+
+namespace {
+
+const float PI = 3.14159265358979f;
+
+template <typename T>
+std::vector<float> Resample(T &Resampler, size_t Count)
+{
+	std::vector<float> Output(Count);
+	for (auto &x : Output)
+		x = Resampler.Get();
+	return Output;
+}
+
+// Root mean square of a sine of the given frequency converted by the output resampler
+double ResampledLevel(double Frequency, uint32 OutputRate)
+{
+	const uint32 InputRate = COutputResampler::INTERNAL_SAMPLE_RATE;
+	const int FRAME = InputRate / 60;
+	std::vector<float> Input(FRAME * 2);
+	std::vector<float> Output(FRAME * 2);
+	COutputResampler Resampler;
+	Resampler.Init(OutputRate, 2);
+
+	double Sum = 0.;
+	uint32 Count = 0;
+	for (int Frame = 0; Frame < 30; ++Frame) {
+		for (int i = 0; i < FRAME; ++i) {
+			double t = double(Frame * FRAME + i) / InputRate;
+			Input[i * 2] = Input[i * 2 + 1] = (float)(.5 * std::sin(2. * PI * Frequency * t));
+		}
+		uint32 Written = Resampler.Process(Input.data(), FRAME * 2, Output.data(), FRAME * 2);
+		if (Frame >= 5)		// skip the initial transient
+			for (uint32 i = 0; i < Written; ++i) {
+				Sum += double(Output[i]) * Output[i];
+				++Count;
+			}
+	}
+	return std::sqrt(Sum / Count) / (.5 / std::sqrt(2.));
+}
+
+} // namespace
+
+SCENARIO("Polyphase FIR resampler") {
+	GIVEN("The reference resampler and the polyphase resampler with the same sinc") {
+		const jarh::sinc Sinc {4096, 256};
+		const float RATIO = 44100.f / 192000.f;
+		const float CUTOFF = .9f;
+		const size_t INPUT = 192000 * 2;
+
+		std::mt19937 rng {1};
+		std::uniform_real_distribution<float> Dist {-10000.f, 10000.f};
+		std::vector<float> Input(INPUT);
+		for (auto &x : Input)
+			x = Dist(rng);
+
+		CReferenceResampler Reference {Sinc, RATIO, CUTOFF, Input};
+		CVectorResampler Polyphase {Sinc, RATIO, CUTOFF, Input};
+
+		WHEN("Two seconds of noise are resampled") {
+			const size_t OUTPUT = (size_t)(INPUT * RATIO);
+			auto Expected = Resample(Reference, OUTPUT);
+			auto Actual = Resample(Polyphase, OUTPUT);
+
+			THEN("The outputs differ by less than one LSB") {
+				float MaxError = 0.f;
+				for (size_t i = 0; i < OUTPUT; ++i)
+					MaxError = std::max(MaxError, std::abs(Expected[i] - Actual[i]));
+				REQUIRE(MaxError < 1.f);
+			}
+		}
+	}
+
+	GIVEN("The output resampler") {
+		WHEN("A tone in the passband is converted") {
+			THEN("Its level is preserved") {
+				REQUIRE(std::abs(ResampledLevel(1000., 44100) - 1.) < .01);
+				REQUIRE(std::abs(ResampledLevel(1000., 48000) - 1.) < .01);
+				REQUIRE(std::abs(ResampledLevel(1000., 96000) - 1.) < .01);
+			}
+		}
+		WHEN("A tone above the output Nyquist frequency is converted") {
+			THEN("It is attenuated instead of aliased") {
+				REQUIRE(ResampledLevel(30000., 44100) < .01);
+				REQUIRE(ResampledLevel(30000., 48000) < .01);
+				REQUIRE(ResampledLevel(60000., 96000) < .01);
+			}
+		}
+	}
+}
@@ -0,0 +1,226 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "SN76489Reference.h"
+
+TEST_SUITE("SN76489");
+
+SCENARIO("Square wave synthesis") {
+	GIVEN("High frequency squares rendered per half period and in batches") {
+		const int FRAMES = 3000;
+		auto Reference = RenderSquares<CReferenceSquare>(FRAMES);
+		auto Batched = RenderSquares<CSNSquare>(FRAMES);
+
+		THEN("The output is bit-identical and the channel meters agree") {
+			REQUIRE(Reference.Samples.size() == Batched.Samples.size());
+			REQUIRE(Reference.Samples == Batched.Samples);
+			REQUIRE(Reference.Levels == Batched.Levels);
+		}
+	}
+}
+
+SCENARIO("Noise generator") {
+	GIVEN("Every LFSR state and feedback mode") {
+		THEN("Stepping several times at once matches stepping one at a time") {
+			bool Match = true;
+			for (SN_noise_fb_t Mode : {SN_NOI_FB_SHORT, SN_NOI_FB_LONG})
+				for (unsigned Seed = 0; Seed <= 0xFFFF; ++Seed)
+					for (unsigned Steps = 1; Steps <= CSNNoise::MAX_LFSR_STEPS; ++Steps) {
+						uint16 Expected = Seed;
+						unsigned Output = 0;
+						for (unsigned i = 0; i < Steps; ++i) {
+							int Feedback = Mode == SN_NOI_FB_LONG ?
+								((Expected & 0x0009) && ((Expected & 0x0009) ^ 0x0009)) : (Expected & 1);
+							Expected = (Expected >> 1) | (Feedback << (16 - 1));
+							Output |= (Expected & 1) << i;
+						}
+						uint16 State = Seed;
+						if (CSNNoise::StepLFSR(State, Steps, Mode) != Output || State != Expected)
+							Match = false;
+					}
+			REQUIRE(Match);
+		}
+	}
+
+	GIVEN("Noise clocked by the third square, rendered per step and in batches") {
+		const int FRAMES = 3000;
+		auto Reference = RenderNoise<CReferenceNoise>(FRAMES);
+		auto Batched = RenderNoise<CSNNoise>(FRAMES);
+
+		THEN("The output is bit-identical and the channel meters agree") {
+			REQUIRE(Reference.Samples.size() == Batched.Samples.size());
+			REQUIRE(Reference.Samples == Batched.Samples);
+			REQUIRE(Reference.Levels == Batched.Levels);
+		}
+	}
+}
+
+SCENARIO("Stereo separation") {
+	GIVEN("A square wave panned to the left") {
+		auto RenderPanned = [] (float Sep) {
+			CMixer Mixer;
+			SetupMixer(Mixer);
+			Mixer.SetChipLevel(CHIP_LEVEL_SN7Sep, Sep);
+			CSNSquare Chan {&Mixer, CHANID_SQUARE1};
+			Chan.Reset();
+			Chan.SetPeriodLo(0x0E);
+			Chan.SetPeriodHi(0x0F);
+			Chan.SetAttenuation(0);
+			Chan.SetStereo(true, false);
+
+			std::vector<float> Samples;
+			std::vector<float> Buffer(SAMPLE_RATE * 2);
+			for (int f = 0; f < 10; ++f) {
+				Chan.Process(FRAME_CYCLES);
+				Chan.EndFrame();
+				int Read = Mixer.ReadBuffer(Mixer.FinishBuffer(FRAME_CYCLES), Buffer.data(), true);
+				Samples.insert(Samples.end(), Buffer.begin(), Buffer.begin() + Read);
+			}
+			return Samples;
+		};
+
+		WHEN("The channels are fully separated") {
+			auto Samples = RenderPanned(1.f);
+			THEN("Only the left output is audible") {
+				float Left = 0.f, Right = 0.f;
+				for (size_t i = 0; i < Samples.size(); i += 2) {
+					Left = std::max(Left, std::abs(Samples[i]));
+					Right = std::max(Right, std::abs(Samples[i + 1]));
+				}
+				REQUIRE(Left > 1000.f / 32768.f);
+				REQUIRE(Right <= 1.f / 32768.f);
+			}
+		}
+
+		WHEN("The channels are not separated") {
+			auto Samples = RenderPanned(0.f);
+			THEN("Both outputs are equal") {
+				bool Equal = true;
+				for (size_t i = 0; i < Samples.size(); i += 2)
+					if (Samples[i] != Samples[i + 1])
+						Equal = false;
+				REQUIRE(Equal);
+			}
+		}
+	}
+}
+
+SCENARIO("Multiple chip instances") {
+	GIVEN("Two SN76489 instances sharing a mixer") {
+		struct chips_result_t
+		{
+			std::vector<float> Samples;
+			std::vector<int32> Levels;
+		};
+
+		// Plays a tone and noise on one of the chips, the other one stays silent
+		auto RenderOn = [] (unsigned Active) {
+			CMixer Mixer;
+			SetupMixer(Mixer);
+			CSN76489 Chip[] = {{&Mixer, 0}, {&Mixer, 1}};
+			for (auto &x : Chip)
+				x.Reset();
+
+			chips_result_t Result;
+			std::vector<float> Buffer(SAMPLE_RATE * 2);
+			for (int f = 0; f < 20; ++f) {
+				CSN76489 &x = Chip[Active];
+				x.Write(0, 0x0E);
+				x.Write(0xFFFF, 0x03 + f % 4);
+				x.Write(1, f % 6);
+				x.Write(6, 0x04 | (f % 4));
+				x.Write(7, f % 3);
+				x.Write(CSN76489::STEREO_PORT, f % 2 ? 0xFF : 0xF7);
+				for (auto &y : Chip) {
+					y.Process(FRAME_CYCLES);
+					y.EndFrame();
+				}
+				int Read = Mixer.ReadBuffer(Mixer.FinishBuffer(FRAME_CYCLES), Buffer.data(), true);
+				Result.Samples.insert(Result.Samples.end(), Buffer.begin(), Buffer.begin() + Read);
+				for (int i = 0; i < 2 * SN76489_CHANNELS; ++i)
+					Result.Levels.push_back(Mixer.GetChanOutput(i));
+			}
+			return Result;
+		};
+
+		auto First = RenderOn(0);
+		auto Second = RenderOn(1);
+
+		THEN("Either instance produces the same output") {
+			REQUIRE(First.Samples.size() == Second.Samples.size());
+			REQUIRE(First.Samples == Second.Samples);
+		}
+		THEN("The meters of each instance are separate") {
+			bool Separate = true;
+			for (size_t i = 0; i < First.Levels.size(); i += 2 * SN76489_CHANNELS)
+				for (int j = 0; j < SN76489_CHANNELS; ++j)
+					if (First.Levels[i + j] != Second.Levels[i + SN76489_CHANNELS + j] ||
+						First.Levels[i + SN76489_CHANNELS + j] != 0 || Second.Levels[i + j] != 0)
+						Separate = false;
+			REQUIRE(Separate);
+			REQUIRE(*std::max_element(First.Levels.begin(), First.Levels.end()) > 0);
+		}
+	}
+}
+
+SCENARIO("Stem rendering") {
+	GIVEN("Squares and noise rendered with and without stems") {
+		struct stems_result_t
+		{
+			std::vector<float> Samples;
+			std::vector<std::vector<float>> Stems;
+		};
+
+		auto RenderStems = [] (int Stems) {
+			CMixer Mixer;
+			REQUIRE(Mixer.SetStemCount(Stems));
+			SetupMixer(Mixer);
+			CSN76489 Chip {&Mixer, 0};
+			Chip.Reset();
+
+			stems_result_t Result;
+			Result.Stems.resize(Stems);
+			std::vector<float> Buffer(SAMPLE_RATE * 2);
+			for (int f = 0; f < 200; ++f) {
+				for (int i = 0; i < 3; ++i) {
+					Chip.Write(i * 2, 0x04 + f % 7 + i);
+					Chip.Write(i * 2 + 1, f % 5 + i);
+				}
+				Chip.Write(6, 0x04 | (f % 4));
+				Chip.Write(7, f % 3);
+				Chip.Write(CSN76489::STEREO_PORT, f % 2 ? 0xFF : 0xB7);
+				Chip.Process(FRAME_CYCLES);
+				Chip.EndFrame();
+				int Avail = Mixer.FinishBuffer(FRAME_CYCLES);
+				int Read = Mixer.ReadBuffer(Avail, Buffer.data(), true);
+				Result.Samples.insert(Result.Samples.end(), Buffer.begin(), Buffer.begin() + Read);
+				for (int i = 0; i < Stems; ++i) {
+					REQUIRE(Mixer.ReadStem(i, Avail, Buffer.data(), true) == Read);
+					Result.Stems[i].insert(Result.Stems[i].end(), Buffer.begin(), Buffer.begin() + Read);
+				}
+			}
+			return Result;
+		};
+
+		auto Plain = RenderStems(0);
+		auto Split = RenderStems(SN76489_CHANNELS);
+
+		THEN("The master mix does not change") {
+			REQUIRE(Plain.Samples == Split.Samples);
+		}
+		THEN("Every stem is audible and the stems add up to the master mix") {
+			float MaxError = 0.f;
+			for (size_t i = 0; i < Split.Samples.size(); ++i) {
+				float Sum = 0.f;
+				for (const auto &x : Split.Stems)
+					Sum += x[i];
+				MaxError = std::max(MaxError, std::abs(Sum - Split.Samples[i]));
+			}
+			REQUIRE(MaxError <= SN76489_CHANNELS * 2.f / 32768.f);
+			for (const auto &x : Split.Stems)
+				REQUIRE(*std::max_element(x.begin(), x.end()) > 100.f / 32768.f);
+		}
+	}
+}
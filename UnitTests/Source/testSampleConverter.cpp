@@ -0,0 +1,84 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "APU/SampleConverter.h"
+
+TEST_SUITE("Sample converter");
+
+SCENARIO("Floating point sample conversion") {
+	GIVEN("Random samples beyond full scale") {
+		std::mt19937 rng {1};
+		std::uniform_real_distribution<float> Dist {-1.25f, 1.25f};
+
+		THEN("The SSE2 path matches the scalar path, with and without dither") {
+			bool Match = true;
+			for (int Run = 0; Run < 2000; ++Run) {
+				uint32 Count = Run % 53;
+				bool Dither = (Run & 1) != 0;
+				std::vector<float> In(Count);
+				for (auto &x : In)
+					x = Dist(rng);
+
+				CSampleConverter Scalar {(uint32)Run}, SSE2 {(uint32)Run};
+				std::vector<int16> Out16[2] = {std::vector<int16>(Count), std::vector<int16>(Count)};
+				std::vector<uint8> Out8[2] = {std::vector<uint8>(Count), std::vector<uint8>(Count)};
+				for (int i = 0; i < 2; ++i) {		// the generators continue into the second call
+					if (Scalar.ToInt16Scalar(In.data(), Out16[0].data(), Count, Dither) !=
+						SSE2.ToInt16SSE2(In.data(), Out16[1].data(), Count, Dither))
+						Match = false;
+					if (Scalar.ToUInt8Scalar(In.data(), Out8[0].data(), Count, Dither) !=
+						SSE2.ToUInt8SSE2(In.data(), Out8[1].data(), Count, Dither))
+						Match = false;
+					if (Out16[0] != Out16[1] || Out8[0] != Out8[1])
+						Match = false;
+				}
+			}
+			REQUIRE(Match);
+		}
+	}
+
+	GIVEN("Samples at known levels") {
+		const float In[] = {0.f, .5f / 32768, 1.5f / 32768, -1.f / 32768, .5f, -1.f, 1.f, 2.f, -2.f};
+		const int16 Expected16[] = {0, 0, 2, -1, 16384, -32768, 32767, 32767, -32768};
+		const uint8 Expected8[] = {0x80, 0x80, 0x80, 0x80, 0xC0, 0x00, 0xFF, 0xFF, 0x00};
+		const uint32 Count = sizeof(In) / sizeof(*In);
+
+		WHEN("They are converted without dither") {
+			int16 Out16[Count];
+			uint8 Out8[Count];
+			CSampleConverter Converter;
+			uint32 Clips16 = Converter.ToInt16(In, Out16, Count, false);
+			uint32 Clips8 = Converter.ToUInt8(In, Out8, Count, false);
+
+			THEN("They are rounded to nearest and clamped") {
+				for (uint32 i = 0; i < Count; ++i) {
+					REQUIRE(Out16[i] == Expected16[i]);
+					REQUIRE(Out8[i] == Expected8[i]);
+				}
+				REQUIRE(Clips16 == 3);
+				REQUIRE(Clips8 == 3);
+			}
+		}
+	}
+
+	GIVEN("A constant level below one LSB") {
+		const uint32 COUNT = 1 << 20;
+		const float Level = .3f / 32768;
+		std::vector<float> In(COUNT, Level);
+		std::vector<int16> Out(COUNT);
+		CSampleConverter Converter;
+
+		WHEN("It is converted with dither") {
+			Converter.ToInt16(In.data(), Out.data(), COUNT, true);
+
+			THEN("The average output is the input level") {
+				double Sum = 0.;
+				for (int16 x : Out)
+					Sum += x;
+				REQUIRE(std::abs(Sum / COUNT - .3) < .01);
+			}
+		}
+	}
+}
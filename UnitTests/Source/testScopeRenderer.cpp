@@ -0,0 +1,79 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+#include "ScopeRenderer.h"
+
+TEST_SUITE("Scope renderer");
+
+SCENARIO("Scope renderer") {
+	GIVEN("A 150 x 40 scope") {
+		const int W = 150, H = 40;
+		CScopeRenderer Scope;
+		Scope.Create(W, H);
+
+		WHEN("A square wave is drawn") {
+			std::vector<short> Samples(W);
+			for (int x = 0; x < W; ++x)
+				Samples[x] = (x / 25) % 2 ? 15000 : -15000;
+			Scope.Render(Samples.data(), false);
+			const unsigned int *pBuffer = Scope.GetBuffer();
+
+			THEN("Every row between the two levels is crossed at each edge") {
+				for (int y = H / 2 - 12; y <= H / 2 + 12; ++y) {
+					bool Lit = false;
+					for (int x = 24; x <= 26; ++x)
+						Lit |= (pBuffer[y * W + x] & 0xFF) > 0x80;
+					REQUIRE(Lit);
+				}
+			}
+
+			THEN("The background gradient is left elsewhere") {
+				REQUIRE(pBuffer[(H / 2) * W + 10] == pBuffer[(H / 2) * W + 11]);
+				REQUIRE((pBuffer[(H / 2) * W + 10] & 0xFF) > (pBuffer[3 * W + 10] & 0xFF));
+			}
+		}
+
+		WHEN("A frame is blurred") {
+			std::vector<short> Samples(W, 0);
+			Scope.Render(Samples.data(), false);
+			std::vector<unsigned int> Before(Scope.GetBuffer(), Scope.GetBuffer() + W * H);
+			Scope.Blur();
+			const unsigned int *pBuffer = Scope.GetBuffer();
+
+			THEN("Pixels are the faded average of their neighbours") {
+				for (int y = 1; y < H - 1; ++y)
+					for (int x = 1; x < W - 1; ++x)
+						for (int Shift = 0; Shift < 24; Shift += 8) {
+							int Sum = 0;
+							for (int dy = -1; dy <= 1; ++dy)
+								for (int dx = -1; dx <= 1; ++dx)
+									if (dx || dy)
+										Sum += (Before[(y + dy) * W + x + dx] >> Shift) & 0xFF;
+							int Expected = (Sum >> 3) - (Shift == 0 ? 3 : 12);
+							REQUIRE(int((pBuffer[y * W + x] >> Shift) & 0xFF) == (Expected > 0 ? Expected : 0));
+						}
+				REQUIRE(pBuffer[0] == 0u);
+				REQUIRE(pBuffer[W * H - 1] == 0u);
+			}
+		}
+
+		WHEN("Many frames are rendered") {
+			std::vector<short> Samples(W);
+			for (int i = 0; i < 10; ++i) {
+				for (int x = 0; x < W; ++x)
+					Samples[x] = (short)(20000 * sin((x + i) * 0.1));
+				Scope.Render(Samples.data(), true);
+			}
+
+			THEN("The wave is visible in every column") {
+				for (int x = 0; x < W; ++x) {
+					bool Lit = false;
+					for (int y = 0; y < H; ++y)
+						Lit |= Scope.GetBuffer()[y * W + x] != 0u;
+					REQUIRE(Lit);
+				}
+			}
+		}
+	}
+}
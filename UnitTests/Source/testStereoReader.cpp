@@ -0,0 +1,121 @@
+#include "doctest.h"
+
+#include <random>
+#include <vector>
+#include "APU/StereoReader.h"
+#include "APU/SampleConverter.h"
+#include "Blip_Buffer/Blip_Buffer.h"
+
+TEST_SUITE("Stereo reader");
+
+namespace {
+
+typedef void (*read_func_t)(const int32 *, const int32 *, int32 &, int32 &, int, const stereo_matrix_t &, float *, uint32);
+
+struct read_result_t
+{
+	std::vector<float> Samples;
+	int32 AccumMid, AccumSide;
+
+	bool operator==(const read_result_t &other) const {
+		return Samples == other.Samples && AccumMid == other.AccumMid && AccumSide == other.AccumSide;
+	}
+};
+
+read_result_t ReadWith(read_func_t Func, const std::vector<int32> &Mid, const std::vector<int32> &Side,
+	int32 AccumMid, int32 AccumSide, int BassShift, const stereo_matrix_t &Matrix)
+{
+	read_result_t Result {std::vector<float>(Mid.size() * 2), AccumMid, AccumSide};
+	Func(Mid.data(), Side.data(), Result.AccumMid, Result.AccumSide,
+		BassShift, Matrix, Result.Samples.data(), (uint32)Mid.size());
+	return Result;
+}
+
+} // namespace
+
+SCENARIO("Fused stereo read-out") {
+	GIVEN("Random raw samples, accumulators and matrices") {
+		std::mt19937 rng {1};
+		std::uniform_int_distribution<int32> Delta {-(1 << 19), 1 << 19};
+		std::uniform_int_distribution<int32> Accum {-(1 << 30), 1 << 30};
+		std::uniform_real_distribution<float> Coef {-1.5f, 1.5f};
+
+		THEN("The SSE2 and AVX2 paths match the scalar path") {
+			// without AVX2 that path falls back to SSE2
+			bool Match = true;
+			for (int Run = 0; Run < 2000; ++Run) {
+				uint32 Count = Run % 67;
+				std::vector<int32> Mid(Count), Side(Count);
+				for (auto &x : Mid)
+					x = Delta(rng);
+				for (auto &x : Side)
+					x = Delta(rng);
+				stereo_matrix_t Matrix {Coef(rng), Coef(rng), Coef(rng), Coef(rng)};
+				int BassShift = 1 + Run % 31;
+				int32 AccumMid = Accum(rng);
+				int32 AccumSide = Accum(rng);
+
+				auto Scalar = ReadWith(CStereoReader::ReadScalar, Mid, Side, AccumMid, AccumSide, BassShift, Matrix);
+				if (!(ReadWith(CStereoReader::ReadSSE2, Mid, Side, AccumMid, AccumSide, BassShift, Matrix) == Scalar))
+					Match = false;
+				if (!(ReadWith(CStereoReader::ReadAVX2, Mid, Side, AccumMid, AccumSide, BassShift, Matrix) == Scalar))
+					Match = false;
+				if (!(ReadWith(CStereoReader::Read, Mid, Side, AccumMid, AccumSide, BassShift, Matrix) == Scalar))
+					Match = false;
+			}
+			REQUIRE(Match);
+		}
+	}
+
+	GIVEN("Two identical blip buffers") {
+		const long SAMPLE_RATE = 44100;
+		const long CLOCK_RATE = 3579545;
+		const int FRAME_CYCLES = CLOCK_RATE / 60;
+
+		Blip_Buffer Buffer[2];
+		Blip_Synth<blip_good_quality, 5000> Synth;
+		Synth.volume(2.0);
+		for (auto &b : Buffer) {
+			b.set_sample_rate(SAMPLE_RATE, 100);
+			b.clock_rate(CLOCK_RATE);
+			b.bass_freq(30);
+		}
+		std::mt19937 rng {2};
+		for (int i = 0; i < 400; ++i) {
+			int Time = rng() % FRAME_CYCLES;
+			int Delta = (int)(rng() % 8000) - 4000;
+			for (auto &b : Buffer)
+				Synth.offset(Time, Delta, &b);
+		}
+		for (auto &b : Buffer)
+			b.end_frame(FRAME_CYCLES);
+
+		WHEN("One is read by Blip_Buffer and the other as both channels of the stereo reader, then converted") {
+			long Count = Buffer[0].samples_avail();
+			std::vector<blip_sample_t> Expected(Count);
+			Buffer[0].read_samples(Expected.data(), Count);
+
+			Blip_Reader Mid, Side;
+			int BassShift = Mid.begin(Buffer[1]);
+			Side.begin(Buffer[1]);
+			std::vector<float> Output(Count * 2);
+			CStereoReader::Read(Mid.data(), Side.data(), Mid.raw_accum(), Side.raw_accum(),
+				BassShift, stereo_matrix_t {1.f, 0.f, 0.f, 1.f}, Output.data(), Count);
+			std::vector<int16> Samples(Count * 2);
+			uint32 Clips = CSampleConverter { }.ToInt16(Output.data(), Samples.data(), Count * 2, false);
+
+			THEN("The samples are the same") {
+				bool Match = true;
+				uint32 ExpectedClips = 0;
+				for (long i = 0; i < Count; ++i) {
+					if (Samples[i * 2] != Expected[i] || Samples[i * 2 + 1] != Expected[i])
+						Match = false;
+					if (Output[i * 2] * 32768.f > 32767.f || Output[i * 2] * 32768.f < -32768.f)
+						ExpectedClips += 2;
+				}
+				REQUIRE(Match);
+				REQUIRE(Clips == ExpectedClips);
+			}
+		}
+	}
+}
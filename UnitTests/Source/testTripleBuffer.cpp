@@ -0,0 +1,62 @@
+#include "doctest.h"
+
+#include <thread>
+#include <vector>
+#include "TripleBuffer.h"
+
+TEST_SUITE("Triple buffer");
+
+SCENARIO("Triple buffer") {
+	GIVEN("An empty triple buffer") {
+		CTripleBuffer<int> Buffer;
+
+		THEN("Nothing can be acquired") {
+			REQUIRE_FALSE(Buffer.Acquire());
+		}
+
+		WHEN("Several blocks are published before reading") {
+			for (int i = 1; i <= 3; ++i) {
+				Buffer.GetWriteBuffer().assign(i, i);
+				Buffer.Publish();
+			}
+
+			THEN("Only the latest block is read") {
+				REQUIRE(Buffer.Acquire());
+				REQUIRE(Buffer.GetReadBuffer() == std::vector<int>(3, 3));
+				REQUIRE_FALSE(Buffer.Acquire());
+			}
+		}
+	}
+
+	GIVEN("A writer and a reader thread") {
+		const int BLOCKS = 100000;
+		const int SIZE = 64;
+		CTripleBuffer<int> Buffer;
+
+		int Torn = 0, Reordered = 0, Last = 0;
+		std::thread Reader {[&] {
+			while (Last < BLOCKS) {
+				if (!Buffer.Acquire())
+					continue;
+				const std::vector<int> &Block = Buffer.GetReadBuffer();
+				for (int x : Block)
+					if (x != Block[0])
+						++Torn;
+				if (Block[0] <= Last)
+					++Reordered;
+				Last = Block[0];
+			}
+		}};
+
+		for (int i = 1; i <= BLOCKS; ++i) {
+			Buffer.GetWriteBuffer().assign(SIZE, i);
+			Buffer.Publish();
+		}
+		Reader.join();
+
+		THEN("Every block read is complete and newer than the previous one") {
+			REQUIRE(Torn == 0);
+			REQUIRE(Reordered == 0);
+		}
+	}
+}
@@ -0,0 +1,257 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <thread>
+#include <vector>
+#include "VGM/Logger.h"
+#include "VGM/Writer/SN76489.h"
+
+namespace {
+
+size_t g_iAllocations = 0;
+bool g_bCountAllocations = false;
+
+} // namespace
+
+void *operator new(size_t size)
+{
+	if (g_bCountAllocations)
+		++g_iAllocations;
+	if (void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc { };
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+TEST_SUITE("VGM logger");
+
+namespace {
+
+size_t LogWrites(const char *fname, bool Streaming, int Writes)
+{
+	CVGMLogger logger {fname, Streaming};
+	CVGMWriterSN76489 writer {logger};
+	logger.Reserve(Writes * 3);		// each write is 2 bytes, plus a delay every 64 writes
+
+	g_iAllocations = 0;
+	g_bCountAllocations = true;
+	for (int i = 0; i < Writes; ++i) {
+		writer.WriteReg(0, 0x90 | (i & 0x6F));
+		if (!(i & 0x3F))
+			logger.DelayTicks(1);
+	}
+	g_bCountAllocations = false;
+
+	return g_iAllocations;
+}
+
+} // namespace
+
+SCENARIO("VGM command encoding") {
+	GIVEN("A logger with an SN76489 writer") {
+		const char *fname = "testVGMLogger.vgm";
+		const int WRITES = 1000000;
+
+		WHEN("A million register writes are logged in memory") {
+			size_t Allocations = LogWrites(fname, false, WRITES);
+			THEN("Nothing is allocated once the command buffer is reserved") {
+				REQUIRE(Allocations == 0);
+			}
+		}
+
+		WHEN("A million register writes are streamed to the file") {
+			size_t Allocations = LogWrites(fname, true, WRITES);
+			THEN("Nothing is allocated") {
+				REQUIRE(Allocations == 0);
+			}
+		}
+
+		std::remove(fname);
+	}
+}
+
+SCENARIO("VGM streaming") {
+	GIVEN("A streaming logger with a loop point") {
+		const char *fname = "testVGMStream.vgm";
+		const int WRITES = 100000;
+		std::vector<char> tag {'G', 'd', '3', ' ', 0, 1, 0, 0, 0, 0, 0, 0};
+		{
+			CVGMLogger logger {fname, true};
+			CVGMWriterSN76489 writer {logger};
+			logger.SetGD3Tag(tag);
+			for (int i = 0; i < WRITES; ++i) {
+				if (i == WRITES / 2)
+					logger.Loop();
+				writer.WriteReg(0, 0x90 | (i & 0x6F));
+				logger.DelayTicks(1);
+			}
+			REQUIRE(logger.Commit());
+		}
+
+		THEN("The header offsets point into the streamed data") {
+			std::ifstream f {fname, std::ios::binary};
+			std::vector<char> data {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> { }};
+			auto At = [&] (size_t pos) {
+				uint32_t x;
+				std::memcpy(&x, &data[pos], sizeof(x));
+				return x;
+			};
+
+			REQUIRE(data.size() > 0x100u);
+			REQUIRE(std::memcmp(data.data(), "Vgm ", 4) == 0);
+			REQUIRE(At(0x04) + 0x04 == data.size());
+			REQUIRE(At(0x34) + 0x34 == 0x100u);
+			REQUIRE(std::memcmp(&data[At(0x14) + 0x14], tag.data(), tag.size()) == 0);
+			REQUIRE(data[At(0x14) + 0x14 - 1] == 0x66);
+			REQUIRE(At(0x18) == WRITES * 735u);
+			REQUIRE(At(0x20) == WRITES / 2 * 735u);
+
+			size_t loop = At(0x1C) + 0x1C;
+			REQUIRE(data[loop] == 0x50);
+			REQUIRE((unsigned char)data[loop + 1] == (0x90 | (WRITES / 2 & 0x6F)));
+			REQUIRE(data[loop - 1] == 0x62);
+		}
+
+		std::remove(fname);
+	}
+}
+
+SCENARIO("VGM streaming threshold") {
+	GIVEN("A buffered logger with a small streaming threshold and one without") {
+		const char *fname[] = {"testVGMSpill1.vgm", "testVGMSpill2.vgm"};
+		const int WRITES = 20000;
+		std::vector<char> tag {'G', 'd', '3', ' ', 0, 1, 0, 0, 0, 0, 0, 0};
+		bool status[2] = { };
+
+		for (int i = 0; i < 2; ++i) {
+			CVGMLogger logger {fname[i]};
+			if (i == 0)
+				logger.SetStreamingThreshold(0x1000);
+			CVGMWriterSN76489 writer {logger};
+			logger.SetGD3Tag(tag);
+			for (int j = 0; j < WRITES; ++j) {
+				if (j == WRITES / 2)
+					logger.Loop();
+				writer.WriteReg(0, 0x90 | (j / 4 % 3));		// mostly redundant writes
+				logger.DelayTicks(1);
+			}
+			status[i] = logger.Commit();
+		}
+
+		THEN("The logger that started streaming writes the same compressed file") {
+			std::vector<char> data[2];
+			for (int i = 0; i < 2; ++i) {
+				REQUIRE(status[i]);
+				std::ifstream f {fname[i], std::ios::binary};
+				data[i].assign(std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> { });
+			}
+			REQUIRE(data[0].size() > 0x100u);
+			REQUIRE(data[0].size() < 0x100u + WRITES * 3u);
+			REQUIRE(data[0] == data[1]);
+		}
+
+		for (auto x : fname)
+			std::remove(x);
+	}
+}
+
+SCENARIO("Dual chip VGM") {
+	GIVEN("A streaming logger with a writer for each of two SN76489 chips") {
+		const char *fname = "testVGMDual.vgm";
+		{
+			CVGMLogger logger {fname, true};
+			CVGMWriterSN76489 first {logger};
+			CVGMWriterSN76489 second {logger};
+			second.SetSecondChip(true);
+
+			WHEN("Both chips are written to") {
+				first.WriteReg(0, 0x9F);
+				second.WriteReg(0, 0x90);
+				second.WriteReg(0, 0xF0, 0x06);		// stereo port
+				first.WriteReg(0, 0x0F, 0x06);
+				REQUIRE(logger.Commit());
+
+				THEN("The header has the dual chip bit and the second chip uses its own commands") {
+					std::ifstream f {fname, std::ios::binary};
+					std::vector<char> data {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> { }};
+					REQUIRE(data.size() >= 0x109u);
+
+					uint32_t Clock;
+					std::memcpy(&Clock, &data[0x0C], sizeof(Clock));
+					REQUIRE(Clock == (3579545u | 0x40000000u));
+
+					const unsigned char Expected[] = {0x50, 0x9F, 0x30, 0x90, 0x3F, 0xF0, 0x4F, 0x0F, 0x66};
+					for (size_t i = 0; i < sizeof(Expected); ++i)
+						REQUIRE((unsigned char)data[0x100 + i] == Expected[i]);
+				}
+			}
+		}
+		std::remove(fname);
+	}
+}
+
+SCENARIO("VGM length limit") {
+	GIVEN("A streaming logger") {
+		const char *fname = "testVGMLimit.vgm";
+		{
+			CVGMLogger logger {fname, true};
+			CVGMWriterSN76489 writer {logger};
+			writer.WriteReg(0, 0x9F);
+
+			WHEN("More samples are logged than the format allows") {
+				logger.DelaySamples(0x100000000ull);
+				writer.WriteReg(0, 0x90);
+				THEN("Logging does not throw, but the log cannot be committed") {
+					REQUIRE(!logger.Commit());
+				}
+			}
+		}
+		std::remove(fname);
+	}
+}
+
+SCENARIO("VGM compression") {
+	GIVEN("Two loggers committing redundant writes on separate threads") {
+		const char *fname[] = {"testVGMCmp1.vgm", "testVGMCmp2.vgm"};
+		const int WRITES = 10000;
+		bool status[2] = { };
+
+		auto Log = [&] (int i) {
+			CVGMLogger logger {fname[i]};
+			CVGMWriterSN76489 writer {logger};
+			for (int j = 0; j < WRITES; ++j) {
+				writer.WriteReg(0, 0x90 | (0x0F - i));		// same volume each time
+				logger.DelayTicks(1);
+			}
+			status[i] = logger.Commit();
+		};
+		std::thread t1 {Log, 0};
+		std::thread t2 {Log, 1};
+		t1.join();
+		t2.join();
+
+		THEN("Both files are written and the redundant writes are removed") {
+			for (int i = 0; i < 2; ++i) {
+				REQUIRE(status[i]);
+				std::ifstream f {fname[i], std::ios::binary};
+				std::vector<char> data {std::istreambuf_iterator<char> {f}, std::istreambuf_iterator<char> { }};
+				REQUIRE(data.size() > 0x100u);
+				REQUIRE(std::memcmp(data.data(), "Vgm ", 4) == 0);
+				REQUIRE(data.size() < 0x100u + WRITES * 2u);
+				REQUIRE(data[0x100] == 0x50);
+				REQUIRE((unsigned char)data[0x101] == (0x9F - i));
+			}
+		}
+
+		for (auto x : fname)
+			std::remove(x);
+	}
+}
@@ -1,540 +1,545 @@
-//{{NO_DEPENDENCIES}}
-// Microsoft Visual C++ generated include file.
-// Used by FamiTracker.rc
-//
-#define ID_MANIFEST                     1
-#define ID_INVALID_WAVEFILE             3
-#define IDC_MOVE_UP                     6
-#define IDC_MOVE_DOWN                   7
-#define IDD_ABOUTBOX                    100
-#define IDS_CLEARPATTERN                101
-#define IDS_CLIPBOARD_COPY_ERROR        102
-#define IDS_CLIPBOARD_PASTE_ERROR       103
-#define IDS_DPCM_SPACE_FORMAT           104
-#define IDS_FILE_VERSION_TOO_NEW        105
-#define IDS_INST_EDITOR_TITLE           106
-#define IDS_INST_EDITOR_TITLE_FORMAT    106
-#define IDS_INSTRUMENT_EDITOR_TITLE     106
-#define IDS_INST_VERSION_UNSUPPORTED    107
-#define IDS_INVALID_INST_FILE           108
-#define IDS_FILE_SAVED                  108
-#define IDS_MIDI_ERR_INPUT              109
-#define IDS_MIDI_ERR_OUTPUT             110
-#define IDS_NEW_SOUND_CONFIG            111
-#define IDS_REMOVE_INSTRUMENTS          112
-#define IDS_REMOVE_PATTERNS             113
-#define IDS_SONG_DELETE                 114
-#define IDS_SOUND_FAIL                  115
-#define IDS_UNDERRUN_MESSAGE            116
-#define IDS_WELCOME_VER                 117
-#define IDS_WELCOME_VER_FORMAT          117
-#define IDS_INVALID_WAVEFILE            118
-#define IDS_DPCM_IMPORT_INVALID_WAVEFILE 118
-#define IDS_INST_FILE_ERROR             119
-#define IDS_NEW_2A03_INSTRUMENT         120
-#define IDS_NEW_VRC6_INSTRUMENT         121
-#define IDS_NEW_VRC7_INSTRUMENT         122
-#define IDS_NEW_FDS_INSTRUMENT          123
-#define IDS_NEW_N163_INSTRUMENT         124
-#define ID_NEXT_FRAME                   125
-#define IDS_NEW_S5B_INSTRUMENT          125
-#define ID_PREV_FRAME                   126
-#define IDS_FRAME_DROP_COPY_NEW         126
-#define IDC_FOLLOW_TOGGLE               127
-#define IDS_FRAME_DROP_COPY             127
-#define IDR_MAINFRAME                   128
-#define ID_CMD_OCTAVE_NEXT              128
-#define IDR_FamiTrackerTYPE             129
-#define ID_CMD_OCTAVE_PREVIOUS          129
-#define IDS_FRAME_DROP_MOVE             129
-#define IDS_DPCM_IMPORT_QUALITY_FORMAT  130
-#define IDD_MAINFRAME                   131
-#define IDS_CLIPBOARD_ERROR             131
-#define IDS_FILE_OPEN_ERROR             132
-#define ID_CMD_NEXT_INSTRUMENT          132
-#define IDS_FILE_VALID_ERROR            133
-#define ID_CMD_PREV_INSTRUMENT          133
-#define IDS_FILE_VERSION_ERROR          134
-#define ID_CMD_INCREASESTEPSIZE         134
-#define IDS_INST_LIMIT                  135
-#define ID_CMD_DECREASESTEPSIZE         135
-#define IDS_CLIPBOARD_OPEN_ERROR        136
-#define ID_TRACKER_TOGGLE_PLAY          136
-#define IDS_CLIPBOARD_NOT_AVALIABLE     137
-#define ID_TRACKER_PLAY_START           138
-#define IDS_INSTRUMENT_FILE_FAIL        139
-#define ID_FOCUS_FRAME_EDITOR           139
-#define IDS_SAMPLES_NEEDED              140
-#define ID_FOCUS_PATTERN_EDITOR         140
-#define IDS_CLIPPING_MESSAGE            140
-#define IDS_OPEN                        141
-#define ID_CMD_STEP_UP                  141
-#define IDS_FILTER_FTI                  141
-#define IDS_SAVE_ERROR_REASON           142
-#define ID_CMD_STEP_DOWN                142
-#define IDS_SAVE_FILE_ERROR             142
-#define IDS_START_ERROR                 143
-#define ID_DELETE_ROW                   143
-#define IDS_SOUNDGEN_ERROR              144
-#define ID_BLOCK_START                  144
-#define IDS_INFO_TITLE                  144
-#define IDD_PERFORMANCE                 145
-#define IDS_SOUNDGEN_CLOSE_ERR          145
-#define ID_BLOCK_END                    145
-#define IDS_INFO_AUTHOR                 145
-#define IDD_SPEED                       146
-#define IDS_OUT_OF_SLOTS                146
-#define IDS_OUT_OF_SAMPLEMEM            147
-#define IDS_OUT_OF_SAMPLEMEM_FORMAT     147
-#define IDS_SAMPLE_ADJUSTED             148
-#define IDS_DPCM_IMPORT_GAIN_FORMAT     148
-#define IDS_INVALID_RIFF                149
-#define IDS_OPEN_FILE_ERROR             149
-#define IDS_INCLUDE_INSTRUMENTS         150
-#define IDS_INFO_COPYRIGHT              150
-#define IDS_IMPORT_FAILED               151
-#define IDS_IMPORT_CHIP_MISMATCH        152
-#define IDS_IMPORT_INSTRUMENT_COUNT     153
-#define IDS_IMPORT_SAMPLE_SLOTS         154
-#define IDS_DPCM_IMPORT_TITLE_FORMAT    155
-#define IDS_DPCM_IMPORT_WAVE_FORMAT     156
-#define IDS_DPCM_IMPORT_TARGET_FORMAT   157
-#define IDD_INSTRUMENT_INTERNAL         158
-#define IDS_PERFORMANCE_FRAMERATE_FORMAT 158
-#define IDS_PERFORMANCE_UNDERRUN_FORMAT 159
-#define IDD_INSTRUMENT                  160
-#define IDS_DPCM_IMPORT_INVALID_WAVE    160
-#define IDS_LOADING_FILE                160
-#define IDS_FILTER_DMC                  161
-#define IDS_FILTER_WAV                  162
-#define IDS_FILTER_TXT                  163
-#define IDS_DPCM_EDIT_INFO_FORMAT       164
-#define IDS_WAVE_EXPORT_DONE            165
-#define IDS_WAVE_EXPORT_FINISHED        166
-#define IDS_ABOUT_TOOLTIP_MAIL          167
-#define IDS_ABOUT_TOOLTIP_WEB           168
-#define IDB_SAMPLEBG                    169
-#define IDS_ABOUT_VERSION_FORMAT        169
-#define IDB_VISUALIZER                  169
-#define IDS_PROPERTIES_CHANNELS         170
-#define IDS_LOADING_DONE                171
-#define IDB_KEY_BLACK                   172
-#define IDS_DPCM_IMPORT_SIZE_FORMAT     172
-#define IDB_KEY_BLACK_MARK              173
-#define IDS_INSTRUMENT_FOLDER           173
-#define IDB_KEY_WHITE                   174
-#define IDS_FILTER_VGM                  174
-#define ID_CLONE_SEQUENCE               175
-#define IDS_VGM_START                   175
-#define IDB_KEY_WHITE_MARK              176
-#define ID_MODULE_TEST_EXPORT           176
-#define ID_INCREASEVALUES               177
-#define ID_DECREASEVALUES               178
-#define IDI_INST_2A03INV                179
-#define IDI_INST_2A03                   179
-#define IDD_CONFIG_APPEARANCE           180
-#define IDD_CONFIG_GENERAL              183
-#define IDD_PROPERTIES                  185
-#define IDD_CONFIG_MIDI                 194
-#define IDR_PATTERN_POPUP               198
-#define IDD_CONFIG_SOUND                201
-#define IDS_FILE_LOAD_ERROR             204
-#define IDS_CONFIG_WINDOW               205
-#define IDS_WELCOME                     206
-#define IDS_SAVE_ERROR                  210
-#define IDD_CONFIG_SHORTCUTS            211
-#define IDD_OCTAVE                      212
-#define IDI_INST_VRC6INV                217
-#define IDD_EXPORT                      218
-#define IDI_INST_VRC7INV                225
-#define IDD_CREATEWAV                   232
-#define IDD_WAVE_PROGRESS               233
-#define IDD_MAINBAR                     235
-#define IDR_FRAME_POPUP                 240
-#define IDI_INST_5B                     247
-#define IDD_FRAMEBAR                    251
-#define IDD_FRAMECONTROLS               251
-#define IDB_TOOLBAR_256                 257
-#define IDR_INSTRUMENT_POPUP            262
-#define IDB_TOOLBAR_INST_256            277
-#define IDR_SAMPLE_WND_POPUP            279
-#define IDR_INSTRUMENT_TOOLBAR          280
-#define IDT_INSTRUMENT                  280
-#define IDD_CHANNELS                    282
-#define IDD_HEADER                      283
-#define IDR_PATTERN_HEADER_POPUP        285
-#define IDD_COMMENTS                    288
-#define IDI_INST_2A07                   289
-#define IDR_FRAMEWND                    291
-#define IDD_CONFIG_LEVELS               292
-#define IDD_CONFIG_MIXER                292
-#define IDD_INSTRUMENT_N163_WAVE1       293
-#define ID_TRACKER_PLAY_CURSOR          300
-#define IDD_IMPORT                      301
-#define IDS_DPCM_IMPORT_INVALID_RIFF    306
-#define IDS_WAVE_PROGRESS_FILE_FORMAT   308
-#define IDD_EXPORT_TEST                 308
-#define IDS_WAVE_PROGRESS_FRAME_FORMAT  309
-#define IDS_WAVE_PROGRESS_TIME_FORMAT   310
-#define IDS_WAVE_PROGRESS_ELAPSED_FORMAT 311
-#define IDR_EXPORT_TEST_REPORT          311
-#define IDS_DSOUND_ERROR                312
-#define IDS_DSOUND_BUFFER_ERROR         313
-#define IDB_ABOUT                       313
-#define IDS_EDIT_MODE                   314
-#define IDI_LEFT                        314
-#define IDS_NORMAL_MODE                 315
-#define IDS_MIDI_MESSAGE_ON_FORMAT      316
-#define IDS_MIDI_MESSAGE_OFF            317
-#define IDI_RIGHT                       317
-#define IDR_SEQUENCE_POPUP              319
-#define IDC_INSTRUMENTS                 1001
-#define IDC_INSTSETTINGS                1002
-#define IDC_INSTNAME                    1005
-#define IDC_SEQ_INDEX                   1007
-#define IDC_ROWS                        1019
-#define IDC_ROWS_SPIN                   1020
-#define IDC_SPEED_SPIN                  1022
-#define IDC_TEMPO_SPIN                  1023
-#define IDC_FRAMES                      1026
-#define IDC_FRAME_SPIN                  1027
-#define IDC_KEYSTEP                     1028
-#define IDC_KEYSTEP_SPIN                1029
-#define IDC_TEMPO                       1030
-#define IDC_FRAME_DEC                   1035
-#define IDC_FRAME_INC                   1036
-#define IDC_KEYREPEAT                   1038
-#define IDC_SAMPLE_RATE                 1039
-#define IDC_SAMPLE_SIZE                 1040
-#define IDC_BUF_LENGTH                  1041
-#define IDC_BASS_FREQ                   1042
-#define IDC_CHANGE_ALL                  1043
-#define IDC_TREBLE_DAMP                 1043
-#define IDC_BUF_LEN                     1044
-#define IDC_BASS_FREQ_T                 1045
-#define IDC_NAME                        1046
-#define IDC_TREBLE_DAMP_T               1046
-#define IDC_ARTIST                      1047
-#define IDC_TREBLE_FREQ                 1047
-#define IDC_COPYRIGHT                   1048
-#define IDC_TREBLE_FREQ_T               1048
-#define IDC_VOLUME_T                    1050
-#define IDC_SPEED_SLD                   1051
-#define IDC_SPEED                       1052
-#define IDC_VOLUME                      1054
-#define IDC_CPU                         1058
-#define IDC_CPU_BAR                     1059
-#define IDC_FRAMERATE                   1060
-#define IDC_UNDERRUN                    1061
-#define IDC_OPT_WRAPCURSOR              1062
-#define IDC_OPT_FREECURSOR              1063
-#define IDC_DEVICES                     1063
-#define IDC_OPT_WAVEPREVIEW             1064
-#define IDC_MASTER_SYNC                 1065
-#define IDC_OPT_KEYREPEAT               1065
-#define IDC_KEY_RELEASE                 1066
-#define IDC_OPT_HEXROW                  1066
-#define IDC_CHANMAP                     1067
-#define IDC_SONG_NAME                   1067
-#define IDC_OPT_WRAPFRAMES              1067
-#define IDC_SONG_ARTIST                 1068
-#define IDC_VELOCITY                    1068
-#define IDC_OPT_FRAMEPREVIEW            1068
-#define IDC_SONG_COPYRIGHT              1069
-#define IDC_OPT_NODPCMRESET             1069
-#define IDC_ARPEGGIATE                  1069
-#define IDC_OPT_NOSTEPMOVE              1070
-#define IDC_FONT                        1071
-#define IDC_ABOUT                       1072
-#define IDC_OPT_PULLUPDELETE            1072
-#define IDC_PATTERNCOLORS               1072
-#define IDC_ABOUT1                      1072
-#define IDC_OPT_BACKUPS                 1073
-#define IDC_ABOUT2                      1073
-#define IDC_DISPLAYFLATS                1073
-#define IDC_SHORTCUTS                   1074
-#define IDC_OPT_SINGLEINSTANCE          1074
-#define IDC_OCTAVE                      1075
-#define IDC_OPT_PREVIEWFULLROW          1075
-#define IDC_OPT_DISPLAYFLATS            1076
-#define IDC_INST_TAB                    1077
-#define IDC_KEYBOARD                    1084
-#define IDC_FREE_SEQ                    1086
-#define IDC_STYLE1                      1094
-#define IDC_STYLE2                      1098
-#define IDC_STYLE3                      1099
-#define IDC_COL_ITEM                    1100
-#define IDC_PICK_COL                    1101
-#define IDC_COL_PREVIEW                 1102
-#define IDC_SCHEME                      1104
-#define IDC_PREVIEW                     1105
-#define IDC_PAL                         1112
-#define IDC_DELTA_ENABLE                1119
-#define IDC_OUTDEVICES                  1124
-#define IDC_INDEVICES                   1126
-#define IDC_SUBTUNE                     1127
-#define IDC_PAGELENGTH                  1129
-#define IDC_DEFAULT                     1132
-#define IDC_EXPANSION                   1135
-#define IDC_VIBRATO                     1136
-#define IDC_CLOSE                       1137
-#define IDC_EXPORT                      1142
-#define IDC_OUTPUT                      1143
-#define IDC_SONG_ADD                    1146
-#define IDC_SONG_REMOVE                 1147
-#define IDC_FOLLOW                      1147
-#define IDC_SONG_DOWN                   1148
-#define IDC_TYPE                        1149
-#define IDC_SONG_UP                     1149
-#define IDC_SONGLIST                    1150
-#define IDC_SONGNAME                    1151
-#define IDC_SONG_IMPORT                 1152
-#define IDC_HIGHLIGHT1                  1153
-#define IDC_PROGRESS_BAR                1154
-#define IDC_HIGHLIGHT2                  1154
-#define IDC_TIMES                       1155
-#define IDC_KEY_NOTE_RELEASE            1155
-#define IDC_SECONDS                     1156
-#define IDC_KEY_CLEAR                   1156
-#define IDC_KEY_REPEAT                  1157
-#define IDC_BEGIN                       1159
-#define IDC_CANCEL                      1160
-#define IDC_RADIO_LOOP                  1162
-#define IDC_RADIO_TIME                  1163
-#define IDC_SPIN_LOOP                   1165
-#define IDC_PROGRESS_LBL                1166
-#define IDC_SPIN_TIME                   1166
-#define IDC_PROGRESS_FILE               1167
-#define IDC_HIGHLIGHTSPIN1              1167
-#define IDC_TIME                        1168
-#define IDC_KEY_NOTE_CUT                1168
-#define IDC_HIGHLIGHTSPIN2              1168
-#define IDC_SEQUENCE_SPIN               1171
-#define IDC_SEQUENCE_STRING             1172
-#define IDC_LOOP_POINT                  1193
-#define IDC_OK                          1194
-#define IDC_PLAY                        1195
-#define IDC_MAIL                        1208
-#define IDC_WEBPAGE                     1209
-#define IDC_ADDED_LIST                  1217
-#define IDC_FONT_SIZE                   1219
-#define IDC_AVAILABLE_TREE              1222
-#define IDC_KEY                         1230
-#define IDC_CLEAR                       1231
-#define IDC_COMMENTS                    1232
-#define IDC_CHECK1                      1233
-#define IDC_NTSC                        1234
-#define IDC_DUAL                        1236
-#define IDC_VOL_2A03                    1236
-#define IDC_LEVEL_2A03                  1238
-#define IDC_LEVEL_VRC6                  1239
-#define IDC_LEVEL_VRC7                  1240
-#define IDC_LEVEL_MMC5                  1241
-#define IDC_LEVEL_FDS                   1242
-#define IDC_VOL_VRC6                    1244
-#define IDC_VOL_VRC7                    1245
-#define IDC_VOL_MMC5                    1246
-#define IDC_VOL_FDS                     1247
-#define IDC_SHOWONOPEN                  1247
-#define IDC_CHANNELS                    1250
-#define IDC_CHANNELS_NR                 1251
-#define IDC_COMBO1                      1255
-#define IDC_TRACKS                      1257
-#define IDC_ABOUT3                      1258
-#define IDC_SPIN1                       1263
-#define IDC_SPIN3                       1264
-#define IDC_OPT_DOUBLECLICK             1265
-#define IDC_BUTTON1                     1266
-#define IDC_ABORT                       1266
-#define IDC_CONTINUE                    1267
-#define IDC_SLIDER1                     1268
-#define IDC_SLIDER_APU1                 1268
-#define IDC_EDIT1                       1270
-#define IDC_HEAD                        1271
-#define IDC_COMBOBOXEX1                 1272
-#define IDC_LEVEL_APU1                  1273
-#define IDC_LEVEL_APU2                  1274
-#define IDC_LEVEL_N163                  1275
-#define IDC_LEVEL_APU3                  1275
-#define IDC_LEVEL_S5B                   1276
-#define IDC_SLIDER2                     1279
-#define IDC_SLIDER_APU2                 1279
-#define IDC_SLIDER3                     1280
-#define IDC_SLIDER_VRC6                 1280
-#define IDC_SLIDER_STEREO               1280
-#define IDC_SLIDER4                     1281
-#define IDC_SLIDER_VRC7                 1281
-#define IDC_SLIDER5                     1282
-#define IDC_SLIDER_MMC5                 1282
-#define IDC_SLIDER6                     1283
-#define IDC_SLIDER_FDS                  1283
-#define IDC_SLIDER7                     1284
-#define IDC_SLIDER_N163                 1284
-#define IDC_SLIDER8                     1285
-#define IDC_SLIDER_S5B                  1285
-#define ID_TRACKER_PLAY                 32771
-#define ID_TRACKER_PLAYPATTERN          32775
-#define ID_TRACKER_STOP                 32776
-#define ID_TRACKER_EDIT                 32777
-#define ID_TRACKER_KILLSOUND            32778
-#define ID_FILE_CREATE_NSF              32807
-#define ID_FILE_SOUNDSETTINGS           32809
-#define ID_EDIT_DELETE                  32820
-#define ID_EDIT_UNLOCKCURSOR            32823
-#define ID_TRACKER_NTSC                 32824
-#define ID_TRACKER_PAL                  32825
-#define ID_SPEED_DEFALUT                32827
-#define ID_SPEED_CUSTOM                 32828
-#define ID_HELP_PERFORMANCE             32829
-#define ID_EDIT_PASTEOVERWRITE          32831
-#define ID_TRANSPOSE_INCREASENOTE       32833
-#define ID_TRANSPOSE_DECREASENOTE       32834
-#define ID_TRANSPOSE_INCREASEOCTAVE     32835
-#define ID_TRANSPOSE_DECREASEOCTAVE     32836
-#define ID_EDIT_SELECTALL               32847
-#define ID_FILE_GENERALSETTINGS         32851
-#define ID_EDIT_ENABLEMIDI              32853
-#define ID_FRAME_INSERT                 32854
-#define ID_FRAME_REMOVE                 32855
-#define ID_TRACKER_PLAYROW              32858
-#define ID_FILE_IMPORTMIDI              32863
-#define ID_CREATE_NSF                   32867
-#define ID_BUTTON32892                  32892
-#define ID_SPEED_DEFAULT                32893
-#define ID_MODULE_MODULEPROPERTIES      32895
-#define ID_EDIT_PASTEMIX                32899
-#define ID_MODULE_MOVEFRAMEDOWN         32902
-#define ID_MODULE_MOVEFRAMEUP           32903
-#define ID_MODULE_SAVEINSTRUMENT        32909
-#define ID_MODULE_LOADINSTRUMENT        32911
-#define ID_MODULE_ADDINSTRUMENT         32915
-#define ID_MODULE_REMOVEINSTRUMENT      32916
-#define ID_TRACKER_SOLOCHANNEL          32940
-#define ID_TRACKER_TOGGLECHANNEL        32941
-#define ID_EDIT_GRADIENT                32942
-#define ID_MODULE_EDITINSTRUMENT        32943
-#define ID_NEXT_SONG                    32944
-#define ID_PREV_SONG                    32945
-#define ID_EDIT_INSTRUMENTMASK          32948
-#define ID_TRACKER_SWITCHTOTRACKINSTRUMENT 32949
-#define ID_FRAME_INSERT_UNIQUE          32952
-#define ID_FILE_CREATEWAV               32954
-#define ID_VIEW_CONTROLPANEL            32956
-#define ID_EDIT_CLEARPATTERNS           32958
-#define ID_EDIT_INTERPOLATE             32959
-#define ID_POPUP_SOLOCHANNEL            32962
-#define ID_POPUP_TOGGLECHANNEL          32963
-#define ID_MODULE_DUPLICATEFRAME        32964
-#define ID_POPUP_DELETE                 32982
-#define ID_EDIT_REVERSE                 32984
-#define ID_TRACKER_DPCM                 32987
-#define ID_INSTRUMENT_ADD               32995
-#define ID_INSTRUMENT_REMOVE            32996
-#define ID_INSTRUMENT_EDIT              32997
-#define ID_INSTRUMENT_CLONE             32998
-#define ID_FRAME_COPY                   33000
-#define ID_FRAME_PASTE                  33001
-#define ID_EDIT_REPLACEINSTRUMENT       33002
-#define ID_CLEANUP_REMOVEUNUSEDPATTERNS 33016
-#define ID_HELP_EFFECTTABLE             33017
-#define ID_CLEANUP_REMOVEUNUSEDINSTRUMENTS 33022
-#define ID_POPUP_SAMPLEGRAPH2           33026
-#define ID_POPUP_SPECTRUMANALYZER       33027
-#define ID_POPUP_NOTHING                33028
-#define ID_POPUP_SAMPLEGRAPH1           33029
-#define ID_POPUP_PICKUPROW              33032
-#define ID_POPUP_UNMUTEALLCHANNELS      33037
-#define ID_MODULE_CHANNELS              33038
-#define ID_INSTRUMENT_                  33039
-#define ID_HELP_CHECKFORNEWVERSIONS     33040
-#define ID_EDIT_EXPANDPATTERN           33041
-#define ID_EDIT_SHRINKPATTERN           33042
-#define ID_EDIT_EXPANDPATTERN33043      33043
-#define ID_EDIT_SHRINKPATTERN33044      33044
-#define ID_Menu33045                    33045
-#define ID_FILE_IMPORT                  33046
-#define ID_MODULE_FRAME_INSERT          33047
-#define ID_MODULE_FRAME_REMOVE          33048
-#define ID_MODULE_HEJ                   33049
-#define ID_MODULE_REMOVEFRAME           33050
-#define ID_MODULE_COMMENTS              33051
-#define ID_MODULE_INSERTFRAME           33052
-#define ID_INSTRUMENT_NEW               33053
-#define ID_INSTRUMENT_LOAD              33054
-#define ID_INSTRUMENT_SAVE              33055
-#define ID_POPUP_DECAY                  33065
-#define ID_DECAY_SLOW                   33066
-#define ID_DECAY_FAST                   33067
-#define ID_INSTRUMENT_CLONEINSTRUMENTSEQUENCES 33068
-#define ID_Menu                         33069
-#define ID_INSTRUMENT_DEEPCLONE         33070
-#define ID_INSTRUMENT_CLONEINSTRUMENTSEQUENCES33071 33071
-#define ID_MODULE_DUPLICATEPATTERNS     33072
-#define ID_FRAME_DUPLICATEPATTERNS      33073
-#define ID_MODULE_DUPLICATEFRAMEPATTERNS 33074
-#define ID_EDIT_EXPANDPATTERNS          33075
-#define ID_EDIT_SHRINKPATTERNS          33076
-#define ID_POPUP_EXPANDPATTERN          33077
-#define ID_POPUP_SHRINKPATTERNS         33078
-#define ID_TRACKER_PLAYFROMSTART        33079
-#define ID_VIEW_FRAMEEDITOR             33080
-#define ID_FRAMEEDITOR_TOP              33081
-#define ID_FRAMEEDITOR_LEFT             33082
-#define ID_POPUP_TRANSPOSE              33083
-#define ID_TRANSPOSE_INCREASENOTE33084  33084
-#define ID_TRANSPOSE_DECREASENOTE33085  33085
-#define ID_TRANSPOSE_INCRESAEOCTAVE     33086
-#define ID_TRANSPOSE_DECREASEOCTAVE33087 33087
-#define ID_TRANSOSE_INCREASEOCTAVE      33088
-#define ID_TRACKER_PLAYFROMCURSOR       33089
-#define ID_TOGGLE_SPEED                 33092
-#define ID_POPUP_COPYVOLUMEVALUES       33097
-#define ID_Menu33098                    33098
-#define ID_FRAME_CUT                    33099
-#define ID_FILE_TESTTEST                33100
-#define ID_FRAME_DELETE                 33101
-#define ID_FILE_IMPORTTEXT              33104
-#define ID_FILE_EXPORTTEXT              33105
-#define ID_CLEANUP_MERGEDUPLICATEDPATTERNS 33106
-#define ID_POPUP_SAMPLESCOPE2           33107
-#define ID_POPUP_SAMPLESCOPE1           33108
-#define ID_EDIT_VOLUMEMASK              33111
-#define ID_POPUP_HIDECHANNEL            33112
-#define ID_EDIT_PASTE33113              33113
-#define ID_EDIT_PASTEMIXED              33114
-#define ID_FRAME_PASTEASNEWPA           33115
-#define ID_FRAME_PASTENEWPATTERNS       33116
-#define ID_POPUP_DELETE33117            33117
-#define ID_POPUP_TRIM                   33118
-#define ID_POPUP_PLAY                   33119
-#define ID_INSTRUMENT_SAVETOFILE        33120
-#define ID_INSTRUMENT_LOADFROMFILE      33121
-#define ID_HELP_FAQ                     33122
-#define ID_POPUP_CLONESEQUENCE          33125
-#define ID_TRACKER_DISPLAYREGISTERSTATE 33126
-#define ID_TRACKER_LOGVGMFILE           33127
-#define ID_INSTRUMENT_ADD_2A03          36864
-#define ID_INSTRUMENT_ADD_FDS           36865
-#define ID_INSTRUMENT_ADD_MMC5          36866
-#define ID_INSTRUMENT_ADD_N163          36867
-#define ID_INSTRUMENT_ADD_S5B           36868
-#define ID_INSTRUMENT_ADD_VRC6          36869
-#define ID_INSTRUMENT_ADD_VRC7          36870
-#define ID_INDICATOR_CHIP               53248
-#define ID_INDICATOR_INSTRUMENT         53249
-#define ID_INDICATOR_OCTAVE             53250
-#define ID_INDICATOR_RATE               53251
-#define ID_INDICATOR_TEMPO              53252
-#define ID_INDICATOR_TIME               53253
-#define ID_INDICATOR_POS                53254
-
-// Next default values for new objects
-// 
-#ifdef APSTUDIO_INVOKED
-#ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        322
-#define _APS_NEXT_COMMAND_VALUE         33128
-#define _APS_NEXT_CONTROL_VALUE         1280
-#define _APS_NEXT_SYMED_VALUE           179
-#endif
-#endif
+//{{NO_DEPENDENCIES}}
+// Microsoft Visual C++ generated include file.
+// Used by FamiTracker.rc
+//
+#define ID_MANIFEST                     1
+#define ID_INVALID_WAVEFILE             3
+#define IDC_MOVE_UP                     6
+#define IDC_MOVE_DOWN                   7
+#define IDD_ABOUTBOX                    100
+#define IDS_CLEARPATTERN                101
+#define IDS_CLIPBOARD_COPY_ERROR        102
+#define IDS_CLIPBOARD_PASTE_ERROR       103
+#define IDS_DPCM_SPACE_FORMAT           104
+#define IDS_FILE_VERSION_TOO_NEW        105
+#define IDS_INST_EDITOR_TITLE           106
+#define IDS_INST_EDITOR_TITLE_FORMAT    106
+#define IDS_INSTRUMENT_EDITOR_TITLE     106
+#define IDS_INST_VERSION_UNSUPPORTED    107
+#define IDS_INVALID_INST_FILE           108
+#define IDS_FILE_SAVED                  108
+#define IDS_MIDI_ERR_INPUT              109
+#define IDS_MIDI_ERR_OUTPUT             110
+#define IDS_NEW_SOUND_CONFIG            111
+#define IDS_REMOVE_INSTRUMENTS          112
+#define IDS_REMOVE_PATTERNS             113
+#define IDS_SONG_DELETE                 114
+#define IDS_SOUND_FAIL                  115
+#define IDS_UNDERRUN_MESSAGE            116
+#define IDS_WELCOME_VER                 117
+#define IDS_WELCOME_VER_FORMAT          117
+#define IDS_INVALID_WAVEFILE            118
+#define IDS_DPCM_IMPORT_INVALID_WAVEFILE 118
+#define IDS_INST_FILE_ERROR             119
+#define IDS_NEW_2A03_INSTRUMENT         120
+#define IDS_NEW_VRC6_INSTRUMENT         121
+#define IDS_NEW_VRC7_INSTRUMENT         122
+#define IDS_NEW_FDS_INSTRUMENT          123
+#define IDS_NEW_N163_INSTRUMENT         124
+#define ID_NEXT_FRAME                   125
+#define IDS_NEW_S5B_INSTRUMENT          125
+#define ID_PREV_FRAME                   126
+#define IDS_FRAME_DROP_COPY_NEW         126
+#define IDC_FOLLOW_TOGGLE               127
+#define IDS_FRAME_DROP_COPY             127
+#define IDR_MAINFRAME                   128
+#define ID_CMD_OCTAVE_NEXT              128
+#define IDR_FamiTrackerTYPE             129
+#define ID_CMD_OCTAVE_PREVIOUS          129
+#define IDS_FRAME_DROP_MOVE             129
+#define IDS_DPCM_IMPORT_QUALITY_FORMAT  130
+#define IDD_MAINFRAME                   131
+#define IDS_CLIPBOARD_ERROR             131
+#define IDS_FILE_OPEN_ERROR             132
+#define ID_CMD_NEXT_INSTRUMENT          132
+#define IDS_FILE_VALID_ERROR            133
+#define ID_CMD_PREV_INSTRUMENT          133
+#define IDS_FILE_VERSION_ERROR          134
+#define ID_CMD_INCREASESTEPSIZE         134
+#define IDS_INST_LIMIT                  135
+#define ID_CMD_DECREASESTEPSIZE         135
+#define IDS_CLIPBOARD_OPEN_ERROR        136
+#define ID_TRACKER_TOGGLE_PLAY          136
+#define IDS_CLIPBOARD_NOT_AVALIABLE     137
+#define ID_TRACKER_PLAY_START           138
+#define IDS_INSTRUMENT_FILE_FAIL        139
+#define ID_FOCUS_FRAME_EDITOR           139
+#define IDS_SAMPLES_NEEDED              140
+#define ID_FOCUS_PATTERN_EDITOR         140
+#define IDS_CLIPPING_MESSAGE            140
+#define IDS_OPEN                        141
+#define ID_CMD_STEP_UP                  141
+#define IDS_FILTER_FTI                  141
+#define IDS_SAVE_ERROR_REASON           142
+#define ID_CMD_STEP_DOWN                142
+#define IDS_SAVE_FILE_ERROR             142
+#define IDS_START_ERROR                 143
+#define ID_DELETE_ROW                   143
+#define IDS_SOUNDGEN_ERROR              144
+#define ID_BLOCK_START                  144
+#define IDS_INFO_TITLE                  144
+#define IDD_PERFORMANCE                 145
+#define IDS_SOUNDGEN_CLOSE_ERR          145
+#define ID_BLOCK_END                    145
+#define IDS_INFO_AUTHOR                 145
+#define IDD_SPEED                       146
+#define IDS_OUT_OF_SLOTS                146
+#define IDS_OUT_OF_SAMPLEMEM            147
+#define IDS_OUT_OF_SAMPLEMEM_FORMAT     147
+#define IDS_SAMPLE_ADJUSTED             148
+#define IDS_DPCM_IMPORT_GAIN_FORMAT     148
+#define IDS_INVALID_RIFF                149
+#define IDS_OPEN_FILE_ERROR             149
+#define IDS_INCLUDE_INSTRUMENTS         150
+#define IDS_INFO_COPYRIGHT              150
+#define IDS_IMPORT_FAILED               151
+#define IDS_IMPORT_CHIP_MISMATCH        152
+#define IDS_IMPORT_INSTRUMENT_COUNT     153
+#define IDS_IMPORT_SAMPLE_SLOTS         154
+#define IDS_DPCM_IMPORT_TITLE_FORMAT    155
+#define IDS_DPCM_IMPORT_WAVE_FORMAT     156
+#define IDS_DPCM_IMPORT_TARGET_FORMAT   157
+#define IDD_INSTRUMENT_INTERNAL         158
+#define IDS_PERFORMANCE_FRAMERATE_FORMAT 158
+#define IDS_PERFORMANCE_UNDERRUN_FORMAT 159
+#define IDD_INSTRUMENT                  160
+#define IDS_DPCM_IMPORT_INVALID_WAVE    160
+#define IDS_LOADING_FILE                160
+#define IDS_FILTER_DMC                  161
+#define IDS_FILTER_WAV                  162
+#define IDS_FILTER_TXT                  163
+#define IDS_DPCM_EDIT_INFO_FORMAT       164
+#define IDS_WAVE_EXPORT_DONE            165
+#define IDS_WAVE_EXPORT_FINISHED        166
+#define IDS_ABOUT_TOOLTIP_MAIL          167
+#define IDS_ABOUT_TOOLTIP_WEB           168
+#define IDB_SAMPLEBG                    169
+#define IDS_ABOUT_VERSION_FORMAT        169
+#define IDB_VISUALIZER                  169
+#define IDS_PROPERTIES_CHANNELS         170
+#define IDS_LOADING_DONE                171
+#define IDB_KEY_BLACK                   172
+#define IDS_DPCM_IMPORT_SIZE_FORMAT     172
+#define IDB_KEY_BLACK_MARK              173
+#define IDS_INSTRUMENT_FOLDER           173
+#define IDB_KEY_WHITE                   174
+#define IDS_FILTER_VGM                  174
+#define ID_CLONE_SEQUENCE               175
+#define IDS_VGM_START                   175
+#define IDB_KEY_WHITE_MARK              176
+#define ID_MODULE_TEST_EXPORT           176
+#define ID_INCREASEVALUES               177
+#define ID_DECREASEVALUES               178
+#define IDI_INST_2A03INV                179
+#define IDI_INST_2A03                   179
+#define IDD_CONFIG_APPEARANCE           180
+#define IDD_CONFIG_GENERAL              183
+#define IDD_PROPERTIES                  185
+#define IDD_CONFIG_MIDI                 194
+#define IDR_PATTERN_POPUP               198
+#define IDD_CONFIG_SOUND                201
+#define IDS_FILE_LOAD_ERROR             204
+#define IDS_CONFIG_WINDOW               205
+#define IDS_WELCOME                     206
+#define IDS_SAVE_ERROR                  210
+#define IDD_CONFIG_SHORTCUTS            211
+#define IDD_OCTAVE                      212
+#define IDI_INST_VRC6INV                217
+#define IDD_EXPORT                      218
+#define IDI_INST_VRC7INV                225
+#define IDD_CREATEWAV                   232
+#define IDD_WAVE_PROGRESS               233
+#define IDD_MAINBAR                     235
+#define IDR_FRAME_POPUP                 240
+#define IDI_INST_5B                     247
+#define IDD_FRAMEBAR                    251
+#define IDD_FRAMECONTROLS               251
+#define IDB_TOOLBAR_256                 257
+#define IDR_INSTRUMENT_POPUP            262
+#define IDB_TOOLBAR_INST_256            277
+#define IDR_SAMPLE_WND_POPUP            279
+#define IDR_INSTRUMENT_TOOLBAR          280
+#define IDT_INSTRUMENT                  280
+#define IDD_CHANNELS                    282
+#define IDD_HEADER                      283
+#define IDR_PATTERN_HEADER_POPUP        285
+#define IDD_COMMENTS                    288
+#define IDI_INST_2A07                   289
+#define IDR_FRAMEWND                    291
+#define IDD_CONFIG_LEVELS               292
+#define IDD_CONFIG_MIXER                292
+#define IDD_INSTRUMENT_N163_WAVE1       293
+#define ID_TRACKER_PLAY_CURSOR          300
+#define IDD_IMPORT                      301
+#define IDS_DPCM_IMPORT_INVALID_RIFF    306
+#define IDS_WAVE_PROGRESS_FILE_FORMAT   308
+#define IDD_EXPORT_TEST                 308
+#define IDS_WAVE_PROGRESS_FRAME_FORMAT  309
+#define IDS_WAVE_PROGRESS_TIME_FORMAT   310
+#define IDS_WAVE_PROGRESS_ELAPSED_FORMAT 311
+#define IDR_EXPORT_TEST_REPORT          311
+#define IDS_DSOUND_ERROR                312
+#define IDS_DSOUND_BUFFER_ERROR         313
+#define IDB_ABOUT                       313
+#define IDS_EDIT_MODE                   314
+#define IDI_LEFT                        314
+#define IDS_NORMAL_MODE                 315
+#define IDS_MIDI_MESSAGE_ON_FORMAT      316
+#define IDS_MIDI_MESSAGE_OFF            317
+#define IDI_RIGHT                       317
+#define IDR_SEQUENCE_POPUP              319
+#define IDS_PERFORMANCE_QUEUED_FORMAT   322
+#define IDC_INSTRUMENTS                 1001
+#define IDC_INSTSETTINGS                1002
+#define IDC_INSTNAME                    1005
+#define IDC_SEQ_INDEX                   1007
+#define IDC_ROWS                        1019
+#define IDC_ROWS_SPIN                   1020
+#define IDC_SPEED_SPIN                  1022
+#define IDC_TEMPO_SPIN                  1023
+#define IDC_FRAMES                      1026
+#define IDC_FRAME_SPIN                  1027
+#define IDC_KEYSTEP                     1028
+#define IDC_KEYSTEP_SPIN                1029
+#define IDC_TEMPO                       1030
+#define IDC_FRAME_DEC                   1035
+#define IDC_FRAME_INC                   1036
+#define IDC_KEYREPEAT                   1038
+#define IDC_SAMPLE_RATE                 1039
+#define IDC_SAMPLE_SIZE                 1040
+#define IDC_BUF_LENGTH                  1041
+#define IDC_BASS_FREQ                   1042
+#define IDC_CHANGE_ALL                  1043
+#define IDC_TREBLE_DAMP                 1043
+#define IDC_BUF_LEN                     1044
+#define IDC_BASS_FREQ_T                 1045
+#define IDC_NAME                        1046
+#define IDC_TREBLE_DAMP_T               1046
+#define IDC_ARTIST                      1047
+#define IDC_TREBLE_FREQ                 1047
+#define IDC_COPYRIGHT                   1048
+#define IDC_TREBLE_FREQ_T               1048
+#define IDC_VOLUME_T                    1050
+#define IDC_SPEED_SLD                   1051
+#define IDC_SPEED                       1052
+#define IDC_VOLUME                      1054
+#define IDC_CPU                         1058
+#define IDC_CPU_BAR                     1059
+#define IDC_FRAMERATE                   1060
+#define IDC_UNDERRUN                    1061
+#define IDC_OPT_WRAPCURSOR              1062
+#define IDC_OPT_FREECURSOR              1063
+#define IDC_DEVICES                     1063
+#define IDC_OPT_WAVEPREVIEW             1064
+#define IDC_MASTER_SYNC                 1065
+#define IDC_OPT_KEYREPEAT               1065
+#define IDC_KEY_RELEASE                 1066
+#define IDC_OPT_HEXROW                  1066
+#define IDC_CHANMAP                     1067
+#define IDC_SONG_NAME                   1067
+#define IDC_OPT_WRAPFRAMES              1067
+#define IDC_SONG_ARTIST                 1068
+#define IDC_VELOCITY                    1068
+#define IDC_OPT_FRAMEPREVIEW            1068
+#define IDC_SONG_COPYRIGHT              1069
+#define IDC_OPT_NODPCMRESET             1069
+#define IDC_ARPEGGIATE                  1069
+#define IDC_OPT_NOSTEPMOVE              1070
+#define IDC_FONT                        1071
+#define IDC_ABOUT                       1072
+#define IDC_OPT_PULLUPDELETE            1072
+#define IDC_PATTERNCOLORS               1072
+#define IDC_ABOUT1                      1072
+#define IDC_OPT_BACKUPS                 1073
+#define IDC_ABOUT2                      1073
+#define IDC_DISPLAYFLATS                1073
+#define IDC_SHORTCUTS                   1074
+#define IDC_OPT_SINGLEINSTANCE          1074
+#define IDC_OCTAVE                      1075
+#define IDC_OPT_PREVIEWFULLROW          1075
+#define IDC_OPT_DISPLAYFLATS            1076
+#define IDC_INST_TAB                    1077
+#define IDC_KEYBOARD                    1084
+#define IDC_FREE_SEQ                    1086
+#define IDC_STYLE1                      1094
+#define IDC_STYLE2                      1098
+#define IDC_STYLE3                      1099
+#define IDC_COL_ITEM                    1100
+#define IDC_PICK_COL                    1101
+#define IDC_COL_PREVIEW                 1102
+#define IDC_SCHEME                      1104
+#define IDC_PREVIEW                     1105
+#define IDC_PAL                         1112
+#define IDC_DELTA_ENABLE                1119
+#define IDC_OUTDEVICES                  1124
+#define IDC_INDEVICES                   1126
+#define IDC_SUBTUNE                     1127
+#define IDC_PAGELENGTH                  1129
+#define IDC_DEFAULT                     1132
+#define IDC_EXPANSION                   1135
+#define IDC_VIBRATO                     1136
+#define IDC_CLOSE                       1137
+#define IDC_EXPORT                      1142
+#define IDC_OUTPUT                      1143
+#define IDC_SONG_ADD                    1146
+#define IDC_SONG_REMOVE                 1147
+#define IDC_FOLLOW                      1147
+#define IDC_SONG_DOWN                   1148
+#define IDC_TYPE                        1149
+#define IDC_SONG_UP                     1149
+#define IDC_SONGLIST                    1150
+#define IDC_SONGNAME                    1151
+#define IDC_SONG_IMPORT                 1152
+#define IDC_HIGHLIGHT1                  1153
+#define IDC_PROGRESS_BAR                1154
+#define IDC_HIGHLIGHT2                  1154
+#define IDC_TIMES                       1155
+#define IDC_KEY_NOTE_RELEASE            1155
+#define IDC_SECONDS                     1156
+#define IDC_KEY_CLEAR                   1156
+#define IDC_KEY_REPEAT                  1157
+#define IDC_BEGIN                       1159
+#define IDC_CANCEL                      1160
+#define IDC_RADIO_LOOP                  1162
+#define IDC_RADIO_TIME                  1163
+#define IDC_SPIN_LOOP                   1165
+#define IDC_PROGRESS_LBL                1166
+#define IDC_SPIN_TIME                   1166
+#define IDC_PROGRESS_FILE               1167
+#define IDC_HIGHLIGHTSPIN1              1167
+#define IDC_TIME                        1168
+#define IDC_KEY_NOTE_CUT                1168
+#define IDC_HIGHLIGHTSPIN2              1168
+#define IDC_SEQUENCE_SPIN               1171
+#define IDC_SEQUENCE_STRING             1172
+#define IDC_LOOP_POINT                  1193
+#define IDC_OK                          1194
+#define IDC_PLAY                        1195
+#define IDC_MAIL                        1208
+#define IDC_WEBPAGE                     1209
+#define IDC_ADDED_LIST                  1217
+#define IDC_FONT_SIZE                   1219
+#define IDC_AVAILABLE_TREE              1222
+#define IDC_KEY                         1230
+#define IDC_CLEAR                       1231
+#define IDC_COMMENTS                    1232
+#define IDC_CHECK1                      1233
+#define IDC_NTSC                        1234
+#define IDC_DUAL                        1236
+#define IDC_VOL_2A03                    1236
+#define IDC_LEVEL_2A03                  1238
+#define IDC_LEVEL_VRC6                  1239
+#define IDC_LEVEL_VRC7                  1240
+#define IDC_LEVEL_MMC5                  1241
+#define IDC_LEVEL_FDS                   1242
+#define IDC_VOL_VRC6                    1244
+#define IDC_VOL_VRC7                    1245
+#define IDC_VOL_MMC5                    1246
+#define IDC_VOL_FDS                     1247
+#define IDC_SHOWONOPEN                  1247
+#define IDC_CHANNELS                    1250
+#define IDC_CHANNELS_NR                 1251
+#define IDC_COMBO1                      1255
+#define IDC_TRACKS                      1257
+#define IDC_ABOUT3                      1258
+#define IDC_SPIN1                       1263
+#define IDC_SPIN3                       1264
+#define IDC_OPT_DOUBLECLICK             1265
+#define IDC_BUTTON1                     1266
+#define IDC_ABORT                       1266
+#define IDC_CONTINUE                    1267
+#define IDC_SLIDER1                     1268
+#define IDC_SLIDER_APU1                 1268
+#define IDC_EDIT1                       1270
+#define IDC_HEAD                        1271
+#define IDC_COMBOBOXEX1                 1272
+#define IDC_LEVEL_APU1                  1273
+#define IDC_LEVEL_APU2                  1274
+#define IDC_LEVEL_N163                  1275
+#define IDC_LEVEL_APU3                  1275
+#define IDC_LEVEL_S5B                   1276
+#define IDC_SLIDER2                     1279
+#define IDC_SLIDER_APU2                 1279
+#define IDC_SLIDER3                     1280
+#define IDC_SLIDER_VRC6                 1280
+#define IDC_SLIDER_STEREO               1280
+#define IDC_SLIDER4                     1281
+#define IDC_SLIDER_VRC7                 1281
+#define IDC_SLIDER5                     1282
+#define IDC_SLIDER_MMC5                 1282
+#define IDC_SLIDER6                     1283
+#define IDC_SLIDER_FDS                  1283
+#define IDC_SLIDER7                     1284
+#define IDC_SLIDER_N163                 1284
+#define IDC_SLIDER8                     1285
+#define IDC_SLIDER_S5B                  1285
+#define IDC_TARGET_LATENCY              1286
+#define IDC_TARGET_LATENCY_T            1287
+#define IDC_QUEUED                      1288
+#define IDC_FLOAT_RENDER                1289
+#define ID_TRACKER_PLAY                 32771
+#define ID_TRACKER_PLAYPATTERN          32775
+#define ID_TRACKER_STOP                 32776
+#define ID_TRACKER_EDIT                 32777
+#define ID_TRACKER_KILLSOUND            32778
+#define ID_FILE_CREATE_NSF              32807
+#define ID_FILE_SOUNDSETTINGS           32809
+#define ID_EDIT_DELETE                  32820
+#define ID_EDIT_UNLOCKCURSOR            32823
+#define ID_TRACKER_NTSC                 32824
+#define ID_TRACKER_PAL                  32825
+#define ID_SPEED_DEFALUT                32827
+#define ID_SPEED_CUSTOM                 32828
+#define ID_HELP_PERFORMANCE             32829
+#define ID_EDIT_PASTEOVERWRITE          32831
+#define ID_TRANSPOSE_INCREASENOTE       32833
+#define ID_TRANSPOSE_DECREASENOTE       32834
+#define ID_TRANSPOSE_INCREASEOCTAVE     32835
+#define ID_TRANSPOSE_DECREASEOCTAVE     32836
+#define ID_EDIT_SELECTALL               32847
+#define ID_FILE_GENERALSETTINGS         32851
+#define ID_EDIT_ENABLEMIDI              32853
+#define ID_FRAME_INSERT                 32854
+#define ID_FRAME_REMOVE                 32855
+#define ID_TRACKER_PLAYROW              32858
+#define ID_FILE_IMPORTMIDI              32863
+#define ID_CREATE_NSF                   32867
+#define ID_BUTTON32892                  32892
+#define ID_SPEED_DEFAULT                32893
+#define ID_MODULE_MODULEPROPERTIES      32895
+#define ID_EDIT_PASTEMIX                32899
+#define ID_MODULE_MOVEFRAMEDOWN         32902
+#define ID_MODULE_MOVEFRAMEUP           32903
+#define ID_MODULE_SAVEINSTRUMENT        32909
+#define ID_MODULE_LOADINSTRUMENT        32911
+#define ID_MODULE_ADDINSTRUMENT         32915
+#define ID_MODULE_REMOVEINSTRUMENT      32916
+#define ID_TRACKER_SOLOCHANNEL          32940
+#define ID_TRACKER_TOGGLECHANNEL        32941
+#define ID_EDIT_GRADIENT                32942
+#define ID_MODULE_EDITINSTRUMENT        32943
+#define ID_NEXT_SONG                    32944
+#define ID_PREV_SONG                    32945
+#define ID_EDIT_INSTRUMENTMASK          32948
+#define ID_TRACKER_SWITCHTOTRACKINSTRUMENT 32949
+#define ID_FRAME_INSERT_UNIQUE          32952
+#define ID_FILE_CREATEWAV               32954
+#define ID_VIEW_CONTROLPANEL            32956
+#define ID_EDIT_CLEARPATTERNS           32958
+#define ID_EDIT_INTERPOLATE             32959
+#define ID_POPUP_SOLOCHANNEL            32962
+#define ID_POPUP_TOGGLECHANNEL          32963
+#define ID_MODULE_DUPLICATEFRAME        32964
+#define ID_POPUP_DELETE                 32982
+#define ID_EDIT_REVERSE                 32984
+#define ID_TRACKER_DPCM                 32987
+#define ID_INSTRUMENT_ADD               32995
+#define ID_INSTRUMENT_REMOVE            32996
+#define ID_INSTRUMENT_EDIT              32997
+#define ID_INSTRUMENT_CLONE             32998
+#define ID_FRAME_COPY                   33000
+#define ID_FRAME_PASTE                  33001
+#define ID_EDIT_REPLACEINSTRUMENT       33002
+#define ID_CLEANUP_REMOVEUNUSEDPATTERNS 33016
+#define ID_HELP_EFFECTTABLE             33017
+#define ID_CLEANUP_REMOVEUNUSEDINSTRUMENTS 33022
+#define ID_POPUP_SAMPLEGRAPH2           33026
+#define ID_POPUP_SPECTRUMANALYZER       33027
+#define ID_POPUP_NOTHING                33028
+#define ID_POPUP_SAMPLEGRAPH1           33029
+#define ID_POPUP_PICKUPROW              33032
+#define ID_POPUP_UNMUTEALLCHANNELS      33037
+#define ID_MODULE_CHANNELS              33038
+#define ID_INSTRUMENT_                  33039
+#define ID_HELP_CHECKFORNEWVERSIONS     33040
+#define ID_EDIT_EXPANDPATTERN           33041
+#define ID_EDIT_SHRINKPATTERN           33042
+#define ID_EDIT_EXPANDPATTERN33043      33043
+#define ID_EDIT_SHRINKPATTERN33044      33044
+#define ID_Menu33045                    33045
+#define ID_FILE_IMPORT                  33046
+#define ID_MODULE_FRAME_INSERT          33047
+#define ID_MODULE_FRAME_REMOVE          33048
+#define ID_MODULE_HEJ                   33049
+#define ID_MODULE_REMOVEFRAME           33050
+#define ID_MODULE_COMMENTS              33051
+#define ID_MODULE_INSERTFRAME           33052
+#define ID_INSTRUMENT_NEW               33053
+#define ID_INSTRUMENT_LOAD              33054
+#define ID_INSTRUMENT_SAVE              33055
+#define ID_POPUP_DECAY                  33065
+#define ID_DECAY_SLOW                   33066
+#define ID_DECAY_FAST                   33067
+#define ID_INSTRUMENT_CLONEINSTRUMENTSEQUENCES 33068
+#define ID_Menu                         33069
+#define ID_INSTRUMENT_DEEPCLONE         33070
+#define ID_INSTRUMENT_CLONEINSTRUMENTSEQUENCES33071 33071
+#define ID_MODULE_DUPLICATEPATTERNS     33072
+#define ID_FRAME_DUPLICATEPATTERNS      33073
+#define ID_MODULE_DUPLICATEFRAMEPATTERNS 33074
+#define ID_EDIT_EXPANDPATTERNS          33075
+#define ID_EDIT_SHRINKPATTERNS          33076
+#define ID_POPUP_EXPANDPATTERN          33077
+#define ID_POPUP_SHRINKPATTERNS         33078
+#define ID_TRACKER_PLAYFROMSTART        33079
+#define ID_VIEW_FRAMEEDITOR             33080
+#define ID_FRAMEEDITOR_TOP              33081
+#define ID_FRAMEEDITOR_LEFT             33082
+#define ID_POPUP_TRANSPOSE              33083
+#define ID_TRANSPOSE_INCREASENOTE33084  33084
+#define ID_TRANSPOSE_DECREASENOTE33085  33085
+#define ID_TRANSPOSE_INCRESAEOCTAVE     33086
+#define ID_TRANSPOSE_DECREASEOCTAVE33087 33087
+#define ID_TRANSOSE_INCREASEOCTAVE      33088
+#define ID_TRACKER_PLAYFROMCURSOR       33089
+#define ID_TOGGLE_SPEED                 33092
+#define ID_POPUP_COPYVOLUMEVALUES       33097
+#define ID_Menu33098                    33098
+#define ID_FRAME_CUT                    33099
+#define ID_FILE_TESTTEST                33100
+#define ID_FRAME_DELETE                 33101
+#define ID_FILE_IMPORTTEXT              33104
+#define ID_FILE_EXPORTTEXT              33105
+#define ID_CLEANUP_MERGEDUPLICATEDPATTERNS 33106
+#define ID_POPUP_SAMPLESCOPE2           33107
+#define ID_POPUP_SAMPLESCOPE1           33108
+#define ID_EDIT_VOLUMEMASK              33111
+#define ID_POPUP_HIDECHANNEL            33112
+#define ID_EDIT_PASTE33113              33113
+#define ID_EDIT_PASTEMIXED              33114
+#define ID_FRAME_PASTEASNEWPA           33115
+#define ID_FRAME_PASTENEWPATTERNS       33116
+#define ID_POPUP_DELETE33117            33117
+#define ID_POPUP_TRIM                   33118
+#define ID_POPUP_PLAY                   33119
+#define ID_INSTRUMENT_SAVETOFILE        33120
+#define ID_INSTRUMENT_LOADFROMFILE      33121
+#define ID_HELP_FAQ                     33122
+#define ID_POPUP_CLONESEQUENCE          33125
+#define ID_TRACKER_DISPLAYREGISTERSTATE 33126
+#define ID_TRACKER_LOGVGMFILE           33127
+#define ID_INSTRUMENT_ADD_2A03          36864
+#define ID_INSTRUMENT_ADD_FDS           36865
+#define ID_INSTRUMENT_ADD_MMC5          36866
+#define ID_INSTRUMENT_ADD_N163          36867
+#define ID_INSTRUMENT_ADD_S5B           36868
+#define ID_INSTRUMENT_ADD_VRC6          36869
+#define ID_INSTRUMENT_ADD_VRC7          36870
+#define ID_INDICATOR_CHIP               53248
+#define ID_INDICATOR_INSTRUMENT         53249
+#define ID_INDICATOR_OCTAVE             53250
+#define ID_INDICATOR_RATE               53251
+#define ID_INDICATOR_TEMPO              53252
+#define ID_INDICATOR_TIME               53253
+#define ID_INDICATOR_POS                53254
+
+// Next default values for new objects
+// 
+#ifdef APSTUDIO_INVOKED
+#ifndef APSTUDIO_READONLY_SYMBOLS
+#define _APS_NEXT_RESOURCE_VALUE        323
+#define _APS_NEXT_COMMAND_VALUE         33128
+#define _APS_NEXT_CONTROL_VALUE         1290
+#define _APS_NEXT_SYMED_VALUE           179
+#endif
+#endif